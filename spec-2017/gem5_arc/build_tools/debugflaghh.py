@@ -51,6 +51,10 @@ parser.add_argument(
     "components",
     help="components of a compound flag, if applicable, joined with :",
 )
+parser.add_argument(
+    "compiled_out",
+    help="whether the flag's tracing is compiled out (True or False)",
+)
 
 args = parser.parse_args()
 
@@ -63,6 +67,8 @@ else:
     print(f'Unrecognized "FMT" value {fmt}', file=sys.stderr)
     sys.exit(1)
 components = args.components.split(":") if args.components else []
+compiled_out = args.compiled_out.lower() == "true"
+flag_class = "CompiledOutFlag" if compiled_out else "SimpleFlag"
 
 code = code_formatter()
 
@@ -118,7 +124,7 @@ else:
 inline union ${{args.name}}
 {
     ~${{args.name}}() {}
-    SimpleFlag flag${{args.name}};
+    ${flag_class} flag${{args.name}};
 
     ${{args.name}}() : flag${{args.name}}("${{args.name}}", "${{args.desc}}", ${{"true" if fmt else "false"}}) {}
 
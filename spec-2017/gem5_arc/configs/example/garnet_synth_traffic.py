@@ -34,6 +34,7 @@ import m5
 from m5.defines import buildEnv
 from m5.objects import *
 from m5.util import addToPath
+from m5.util.convert import toFrequency
 
 addToPath("../")
 
@@ -175,6 +176,13 @@ for ruby_port in system.ruby._cpu_ports:
 root = Root(full_system=False, system=system)
 root.system.mem_mode = "timing"
 
+# Garnet syncs its router partitions itself; gem5 only needs some
+# quantum once there is more than one event queue
+if args.garnet_partitions > 1:
+    root.sim_quantum = args.link_latency * int(
+        1e12 / toFrequency(args.ruby_clock)
+    )
+
 # Not much point in this being higher than the L1 latency
 m5.ticks.setGlobalFrequency("1ps")
 
@@ -42,8 +42,12 @@ scons build/X86/gem5.opt
     --image <full_path_to_the_spec-2017_disk_image> \
     --partition <root_partition_to_mount> \
     --benchmark <benchmark_name> \
-    --size <simulation_size>
+    --size <simulation_size> \
+    [--l2-size 2MB --l2-replacement-policy LRURP ...]
 ```
+
+The cache sizes, associativities and replacement policies can be set per
+level from the command line, so a policy sweep needs no rebuild.
 """
 
 import argparse
@@ -52,7 +56,10 @@ import os
 import time
 
 import m5
-from m5.objects import Root
+from m5.objects import (
+    BaseReplacementPolicy,
+    Root,
+)
 from m5.stats.gem5stats import get_simstat
 from m5.util import (
     fatal,
@@ -184,6 +191,44 @@ parser.add_argument(
     choices=size_choices,
 )
 
+
+def replacement_policy(name):
+    policy = getattr(m5.objects, name, None)
+    if not (
+        isinstance(policy, type) and issubclass(policy, BaseReplacementPolicy)
+    ):
+        raise argparse.ArgumentTypeError(
+            f"{name} is not a replacement policy (e.g., LRURP, ARCRP)"
+        )
+    return policy
+
+
+for level, size, assoc in (
+    ("l1i", "16kB", 8),
+    ("l1d", "16kB", 8),
+    ("l2", "4MB", 16),
+):
+    parser.add_argument(
+        f"--{level}-size",
+        type=str,
+        default=size,
+        help=f"Size of each {level.upper()} cache (default: {size}).",
+    )
+    parser.add_argument(
+        f"--{level}-assoc",
+        type=int,
+        default=assoc,
+        help=f"Associativity of the {level.upper()} caches (default: "
+        f"{assoc}).",
+    )
+    parser.add_argument(
+        f"--{level}-replacement-policy",
+        type=replacement_policy,
+        default=None,
+        help=f"Replacement policy SimObject of the {level.upper()} caches, "
+        "e.g., LRURP (default: the RubyCache default).",
+    )
+
 args = parser.parse_args()
 
 # We expect the user to input the full path of the disk-image.
@@ -208,13 +253,16 @@ from gem5.components.cachehierarchies.ruby.mesi_two_level_cache_hierarchy import
 )
 
 cache_hierarchy = MESITwoLevelCacheHierarchy(
-    l1d_size="16kB",
-    l1d_assoc=8,
-    l1i_size="16kB",
-    l1i_assoc=8,
-    l2_size="4MB",
-    l2_assoc=16,
+    l1d_size=args.l1d_size,
+    l1d_assoc=args.l1d_assoc,
+    l1i_size=args.l1i_size,
+    l1i_assoc=args.l1i_assoc,
+    l2_size=args.l2_size,
+    l2_assoc=args.l2_assoc,
     num_l2_banks=2,
+    l1i_replacement_policy=args.l1i_replacement_policy,
+    l1d_replacement_policy=args.l1d_replacement_policy,
+    l2_replacement_policy=args.l2_replacement_policy,
 )
 # Memory: Dual Channel DDR4 2400 DRAM device.
 # The X86 board only supports 3 GiB of main memory.
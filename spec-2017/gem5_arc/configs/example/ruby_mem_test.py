@@ -58,6 +58,12 @@ parser.add_argument(
     metavar="NLOADS",
     help="Progress message interval ",
 )
+parser.add_argument(
+    "--percent-reads",
+    type=int,
+    default=65,
+    help="percentage of accesses that should be reads",
+)
 parser.add_argument("--num-dmas", type=int, default=0, help="# of dma testers")
 parser.add_argument(
     "--functional",
@@ -112,6 +118,7 @@ if args.num_cpus > block_size:
 cpus = [
     MemTest(
         max_loads=args.maxloads,
+        percent_reads=args.percent_reads,
         percent_functional=args.functional,
         percent_uncacheable=0,
         percent_atomic=args.atomic,
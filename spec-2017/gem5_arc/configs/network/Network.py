@@ -100,7 +100,34 @@ def define_options(parser):
         help="""routing algorithm in network.
             0: weight-based table
             1: XY (for Mesh. see garnet/RoutingUnit.cc)
-            2: Custom (see garnet/RoutingUnit.cc""",
+            2: Custom (see garnet/RoutingUnit.cc)
+            3: West-first adaptive (for Mesh)
+            4: Odd-even adaptive (for Mesh)
+            5: DyXY adaptive (for Mesh, needs 2+ VCs per vnet)""",
+    )
+    parser.add_argument(
+        "--garnet-scan-routing-table",
+        action="store_true",
+        default=False,
+        help="""look routes up by scanning every link of the routing
+            table instead of compiling it into per-destination
+            arrays at init (garnet only).""",
+    )
+    parser.add_argument(
+        "--garnet-elide-idle-cycles",
+        action="store_true",
+        default=False,
+        help="""only wake garnet routers, links and network interfaces
+            in cycles in which they can make progress.""",
+    )
+    parser.add_argument(
+        "--garnet-partitions",
+        action="store",
+        type=int,
+        default=1,
+        help="""spread garnet routers over this many event queues, each
+            simulated by its own host thread. Results match a serial
+            run; links between partitions set the sync interval.""",
     )
     parser.add_argument(
         "--network-fault-model",
@@ -165,12 +192,41 @@ def create_network(options, ruby):
     return (network, IntLinkClass, ExtLinkClass, RouterClass, InterfaceClass)
 
 
+def partition_garnet(network, num_partitions):
+    """Place garnet routers on num_partitions event queues in contiguous
+    blocks of router ids (row bands on a mesh). Every link runs on the
+    queue of the object that feeds it. Network interfaces stay on queue 0
+    with the controllers whose message buffers they share."""
+    routers = network.routers
+    partition = {}
+    for router in routers:
+        partition[router.router_id] = (
+            router.router_id * num_partitions // len(routers)
+        )
+        router.eventq_index = partition[router.router_id]
+
+    for link in network.int_links:
+        link.network_link.eventq_index = partition[link.src_node.router_id]
+        link.credit_link.eventq_index = partition[link.dst_node.router_id]
+
+    for link in network.ext_links:
+        router_eq = partition[link.int_node.router_id]
+        # [0] carries NI -> router flits, [1] router -> NI flits; the
+        # credit links flow the other way
+        link.network_links[0].eventq_index = 0
+        link.network_links[1].eventq_index = router_eq
+        link.credit_links[0].eventq_index = router_eq
+        link.credit_links[1].eventq_index = 0
+
+
 def init_network(options, network, InterfaceClass):
     if options.network == "garnet":
         network.num_rows = options.mesh_rows
         network.vcs_per_vnet = options.vcs_per_vnet
         network.ni_flit_size = options.link_width_bits / 8
         network.routing_algorithm = options.routing_algorithm
+        network.compile_routing_tables = not options.garnet_scan_routing_table
+        network.elide_idle_cycles = options.garnet_elide_idle_cycles
         network.garnet_deadlock_threshold = options.garnet_deadlock_threshold
 
         # Create Bridges and connect them to the corresponding links
@@ -265,6 +321,9 @@ def init_network(options, network, InterfaceClass):
             )
             extLink.int_cred_bridge = int_cred_bridges
 
+        if options.garnet_partitions > 1:
+            partition_garnet(network, options.garnet_partitions)
+
     if options.network == "simple":
         if options.simple_physical_channels:
             network.physical_vnets_channels = [1] * int(
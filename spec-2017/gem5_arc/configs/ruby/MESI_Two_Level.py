@@ -105,6 +105,7 @@ def create_system(
             l2_select_num_bits=l2_bits,
             send_evictions=send_evicts(options),
             prefetcher=prefetcher,
+            classic_prefetcher=NULL,
             ruby_system=ruby_system,
             clk_domain=clk_domain,
             transitions_per_cycle=options.ports,
@@ -156,6 +157,7 @@ def create_system(
         l2_cntrl = L2Cache_Controller(
             version=i,
             L2cache=l2_cache,
+            prefetcher=NULL,
             transitions_per_cycle=options.ports,
             ruby_system=ruby_system,
         )
@@ -178,6 +180,8 @@ def create_system(
         l2_cntrl.responseToL2Cache = MessageBuffer()
         l2_cntrl.responseToL2Cache.in_port = ruby_system.network.out_port
 
+        l2_cntrl.prefetchQueue = MessageBuffer()
+
     # Run each of the ruby memory controllers at a ratio of the frequency of
     # the ruby system
     # clk_divider value is a fix to pass regression.
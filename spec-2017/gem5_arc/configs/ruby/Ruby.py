@@ -125,6 +125,23 @@ def define_options(parser):
         help="Recycle latency for ruby controller input buffers",
     )
 
+    parser.add_argument(
+        "--ruby-tick-buckets",
+        action="store_true",
+        default=False,
+        help="Keep the messages of ruby message buffers in sorted ring "
+        "buffers of per-tick FIFO buckets instead of binary heaps",
+    )
+
+    parser.add_argument(
+        "--ruby-parallel-wakeup",
+        type=int,
+        default=0,
+        metavar="THREADS",
+        help="Run the same-tick wakeups of the controllers attached to "
+        "CPU sequencers on THREADS host threads (0 = serial)",
+    )
+
     protocol = buildEnv["PROTOCOL"]
     exec(f"from . import {protocol}")
     eval(f"{protocol}.define_options(parser)")
@@ -230,6 +247,9 @@ def create_system(
     system.ruby = RubySystem()
     ruby = system.ruby
 
+    if options.ruby_tick_buckets:
+        MessageBuffer.tick_buckets = True
+
     # Generate pseudo filesystem
     FileSystemConfig.config_filesystem(system, options)
 
@@ -291,6 +311,24 @@ def create_system(
         for cpu_seq in cpu_sequencers:
             cpu_seq.connectIOPorts(piobus)
 
+    if options.ruby_parallel_wakeup:
+        ruby.parallel_wakeup_threads = options.ruby_parallel_wakeup
+        for cntrl in topology.nodes:
+            seq = getattr(cntrl, "sequencer", None)
+            if not any(seq is cpu_seq for cpu_seq in cpu_sequencers):
+                continue
+            cntrl.parallel_wakeup = True
+            # Random delays come from a generator shared by all threads
+            for obj in cntrl.descendants():
+                if (
+                    isinstance(obj, MessageBuffer)
+                    and str(obj.randomization) == "enabled"
+                ):
+                    fatal(
+                        f"{obj.path()} has randomized delays, which "
+                        "--ruby-parallel-wakeup does not support"
+                    )
+
     ruby.number_of_virtual_networks = ruby.network.number_of_virtual_networks
     ruby._cpu_ports = cpu_sequencers
     ruby.num_of_sequencers = len(cpu_sequencers)
@@ -2300,7 +2300,7 @@ TableWalker::insertPartialTableEntry(LongDescriptor &descriptor)
     memAttrsWalkAArch64(te);
 
     // Debug output
-    DPRINTF(TLB, descriptor.dbgHeader().c_str());
+    DPRINTF(TLB, "%s", descriptor.dbgHeader());
     DPRINTF(TLB, " - N:%d pfn:%#x size:%#x global:%d valid:%d\n",
             te.N, te.pfn, te.size, te.global, te.valid);
     DPRINTF(TLB, " - vpn:%#x xn:%d pxn:%d ap:%d domain:%d asid:%d "
@@ -2374,7 +2374,7 @@ TableWalker::insertTableEntry(DescriptorBase &descriptor, bool long_descriptor)
     }
 
     // Debug output
-    DPRINTF(TLB, descriptor.dbgHeader().c_str());
+    DPRINTF(TLB, "%s", descriptor.dbgHeader());
     DPRINTF(TLB, " - N:%d pfn:%#x size:%#x global:%d valid:%d\n",
             te.N, te.pfn, te.size, te.global, te.valid);
     DPRINTF(TLB, " - vpn:%#x xn:%d pxn:%d ap:%d domain:%d asid:%d "
@@ -53,3 +53,9 @@ class X86MMU(BaseMMU):
     def connectWalkerPorts(self, iport, dport):
         self.itb.walker.port = iport
         self.dtb.walker.port = dport
+
+    def addSharedTLB(self, tlb):
+        """Back both TLBs with a unified one, probed on their misses"""
+        self.l2_tlb = tlb
+        self.itb.next_level = tlb
+        self.dtb.next_level = tlb
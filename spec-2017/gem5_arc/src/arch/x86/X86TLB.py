@@ -35,6 +35,8 @@
 
 from m5.objects.BaseTLB import BaseTLB
 from m5.objects.ClockedObject import ClockedObject
+from m5.objects.IndexingPolicies import *
+from m5.objects.ReplacementPolicies import *
 from m5.params import *
 from m5.proxy import *
 
@@ -50,6 +52,57 @@ class X86PagetableWalker(ClockedObject):
         4, "Number of outstanding walks that can be squashed per cycle"
     )
 
+    walk_caches = Param.Bool(
+        False,
+        "Cache the tables of long mode walks in paging-structure caches, "
+        "so that walks can skip the levels they already translated",
+    )
+    pml4_cache_entries = Param.MemorySize(
+        "2", "Number of entries of the PML4 cache"
+    )
+    pml4_cache_assoc = Param.Unsigned(2, "Associativity of the PML4 cache")
+    pml4_cache_replacement_policy = Param.BaseReplacementPolicy(
+        LRURP(), "Replacement policy of the PML4 cache"
+    )
+    pml4_cache_indexing_policy = Param.BaseIndexingPolicy(
+        SetAssociative(
+            entry_size=1,
+            assoc=Parent.pml4_cache_assoc,
+            size=Parent.pml4_cache_entries,
+        ),
+        "Indexing policy of the PML4 cache",
+    )
+    pdp_cache_entries = Param.MemorySize(
+        "4", "Number of entries of the PDPT cache"
+    )
+    pdp_cache_assoc = Param.Unsigned(4, "Associativity of the PDPT cache")
+    pdp_cache_replacement_policy = Param.BaseReplacementPolicy(
+        LRURP(), "Replacement policy of the PDPT cache"
+    )
+    pdp_cache_indexing_policy = Param.BaseIndexingPolicy(
+        SetAssociative(
+            entry_size=1,
+            assoc=Parent.pdp_cache_assoc,
+            size=Parent.pdp_cache_entries,
+        ),
+        "Indexing policy of the PDPT cache",
+    )
+    pd_cache_entries = Param.MemorySize(
+        "32", "Number of entries of the PD cache"
+    )
+    pd_cache_assoc = Param.Unsigned(4, "Associativity of the PD cache")
+    pd_cache_replacement_policy = Param.BaseReplacementPolicy(
+        LRURP(), "Replacement policy of the PD cache"
+    )
+    pd_cache_indexing_policy = Param.BaseIndexingPolicy(
+        SetAssociative(
+            entry_size=1,
+            assoc=Parent.pd_cache_assoc,
+            size=Parent.pd_cache_entries,
+        ),
+        "Indexing policy of the PD cache",
+    )
+
 
 class X86TLB(BaseTLB):
     type = "X86TLB"
@@ -57,7 +110,28 @@ class X86TLB(BaseTLB):
     cxx_header = "arch/x86/tlb.hh"
 
     size = Param.Unsigned(64, "TLB size")
+    assoc = Param.Unsigned(
+        0,
+        "Associativity of the entries for base pages, or 0 for a fully "
+        "associative TLB searched with a trie",
+    )
+    large_page_entries = Param.Unsigned(
+        32,
+        "Entries for large pages, on top of size, when assoc is not 0",
+    )
+    replacement_policy = Param.BaseReplacementPolicy(
+        NULL,
+        "Replacement policy used when assoc is not 0, tree pseudo-LRU if "
+        "NULL",
+    )
+    hit_latency = Param.Latency(
+        "0ns",
+        "Latency of a hit in this TLB when it is the next level of another "
+        "one",
+    )
     system = Param.System(Parent.any, "system object")
     walker = Param.X86PagetableWalker(
-        X86PagetableWalker(), "page table walker"
+        X86PagetableWalker(),
+        "page table walker, NULL for a shared level filled by the levels "
+        "above it",
     )
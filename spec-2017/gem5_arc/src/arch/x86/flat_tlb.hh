@@ -0,0 +1,373 @@
+/*
+ * Copyright (c) 2025 Boston University
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef __ARCH_X86_FLAT_TLB_HH__
+#define __ARCH_X86_FLAT_TLB_HH__
+
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+#include "arch/x86/page_size.hh"
+#include "base/bitfield.hh"
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "base/types.hh"
+#include "mem/cache/replacement_policies/base.hh"
+#include "mem/cache/replacement_policies/replaceable_entry.hh"
+
+namespace gem5
+{
+
+namespace X86ISA
+{
+    /**
+     * Set-associative storage for TLB entries, used instead of a trie when
+     * the TLB is given an associativity.
+     *
+     * Entries for base pages live in a set-associative array indexed with
+     * the virtual page number, and entries for large pages in a small fully
+     * associative array. The tags, which pack the page number and the PCID
+     * as TLB::concAddrPcid() does, are kept apart from the entries in a
+     * dense array, and a set is searched with a single branch-free pass over
+     * it that the compiler can vectorize. Invalid ways are filled first,
+     * then ways are replaced with tree pseudo-LRU, or with a replacement
+     * policy if one is given.
+     *
+     * Matching follows the trie it replaces: an entry of 2^n bytes matches
+     * a key that only differs from its tag in the n low order bits, so the
+     * PCID bits are ignored, unless matches are exact, as in syscall
+     * emulation mode. The trie returns the shortest matching prefix, so
+     * inserting a large page drops the base pages it covers, and base pages
+     * can be looked up first.
+     *
+     * @tparam Entry TLB entry, with vaddr, logBytes and global members.
+     */
+    template <typename Entry>
+    class FlatTlb
+    {
+      protected:
+        struct Array
+        {
+            Array(unsigned _sets, unsigned _assoc,
+                  replacement_policy::Base *_policy)
+                : sets(_sets), assoc(_assoc), fullMask(mask(_assoc)),
+                  policy(_policy), tags(_sets * _assoc),
+                  masks(_sets * _assoc), valid(_sets, 0), plru(_sets, 0),
+                  entries(_sets * _assoc)
+            {
+                fatal_if(assoc == 0 || assoc > 64,
+                         "TLB associativity must be between 1 and 64.");
+                fatal_if(!policy && !isPowerOf2(assoc),
+                         "Pseudo-LRU TLB associativity must be a power "
+                         "of 2.");
+                fatal_if(!isPowerOf2(sets),
+                         "TLB set count must be a power of 2.");
+                if (policy) {
+                    replEntries.resize(sets * assoc);
+                    for (unsigned i = 0; i < sets * assoc; i++) {
+                        replEntries[i].replacementData =
+                            policy->instantiateEntry();
+                        replEntries[i].setPosition(i / assoc, i % assoc);
+                    }
+                }
+            }
+
+            Array(const Array &) = delete;
+            Array &operator=(const Array &) = delete;
+
+            const unsigned sets;
+            const unsigned assoc;
+            const uint64_t fullMask;
+
+            /** Replacement policy, or nullptr to use the pseudo-LRU bits */
+            replacement_policy::Base *const policy;
+            std::vector<ReplaceableEntry> replEntries;
+
+            /** Page number and PCID bits that must match, for each way */
+            std::vector<Addr> tags;
+            std::vector<Addr> masks;
+            /** Valid ways and pseudo-LRU tree bits of each set */
+            std::vector<uint64_t> valid;
+            std::vector<uint64_t> plru;
+            std::vector<Entry> entries;
+
+            /** @return The matching way of a set, or -1 */
+            int
+            find(unsigned set, Addr key) const
+            {
+                const Addr *set_tags = &tags[set * assoc];
+                const Addr *set_masks = &masks[set * assoc];
+                uint64_t hits = 0;
+                for (unsigned way = 0; way < assoc; way++) {
+                    hits |= uint64_t((key & set_masks[way]) ==
+                                     set_tags[way]) << way;
+                }
+                hits &= valid[set];
+                return hits ? ctz64(hits) : -1;
+            }
+
+            /** Point the tree of a set away from a way */
+            void
+            touch(unsigned set, unsigned way)
+            {
+                if (policy) {
+                    policy->touch(
+                        replEntries[set * assoc + way].replacementData);
+                    return;
+                }
+                uint64_t &tree = plru[set];
+                unsigned node = 1;
+                for (int level = floorLog2(assoc) - 1; level >= 0; level--) {
+                    const unsigned dir = (way >> level) & 1;
+                    tree = insertBits(tree, node, !dir);
+                    node = 2 * node + dir;
+                }
+            }
+
+            unsigned
+            victim(unsigned set)
+            {
+                const uint64_t invalid = ~valid[set] & fullMask;
+                if (invalid) {
+                    return ctz64(invalid);
+                }
+                if (policy) {
+                    ReplacementCandidates candidates(assoc);
+                    for (unsigned way = 0; way < assoc; way++)
+                        candidates[way] = &replEntries[set * assoc + way];
+                    return policy->getVictim(candidates)->getWay();
+                }
+                unsigned node = 1;
+                unsigned way = 0;
+                for (int level = floorLog2(assoc) - 1; level >= 0; level--) {
+                    const unsigned dir = bits(plru[set], node);
+                    way = 2 * way + dir;
+                    node = 2 * node + dir;
+                }
+                return way;
+            }
+
+            /** Mark a way as just filled */
+            void
+            fill(unsigned set, unsigned way)
+            {
+                valid[set] |= 1ULL << way;
+                if (policy) {
+                    policy->reset(
+                        replEntries[set * assoc + way].replacementData);
+                } else {
+                    touch(set, way);
+                }
+            }
+
+            void
+            invalidate(unsigned set, unsigned way)
+            {
+                valid[set] &= ~(1ULL << way);
+                if (policy) {
+                    policy->invalidate(
+                        replEntries[set * assoc + way].replacementData);
+                }
+            }
+
+            void
+            invalidateAll()
+            {
+                for (unsigned set = 0; set < sets; set++) {
+                    for (uint64_t v = valid[set]; v; v &= v - 1)
+                        invalidate(set, ctz64(v));
+                }
+            }
+        };
+
+        /** Whether matches use every bit of the key */
+        const bool exact;
+
+        Array small;
+        Array large;
+
+        unsigned
+        setOf(Addr key) const
+        {
+            return (key >> PageShift) & (small.sets - 1);
+        }
+
+      public:
+        /**
+         * @param entries Number of entries for base pages.
+         * @param assoc Associativity of the base page entries.
+         * @param large_entries Number of entries for large pages, a power
+         *        of 2 up to 64.
+         * @param _exact Whether keys must match in full, PCID included.
+         * @param policy Replacement policy, or nullptr for tree pseudo-LRU.
+         */
+        FlatTlb(unsigned entries, unsigned assoc, unsigned large_entries,
+                bool _exact, replacement_policy::Base *policy = nullptr)
+            : exact(_exact),
+              small(assoc ? entries / assoc : 0, assoc, policy),
+              large(1, large_entries, policy)
+        {
+            fatal_if(entries % assoc,
+                     "TLB size must be a multiple of its associativity.");
+        }
+
+        /** Total number of entries */
+        unsigned
+        capacity() const
+        {
+            return small.sets * small.assoc + large.assoc;
+        }
+
+        /**
+         * Find the entry translating a key.
+         * @param key Page aligned address with the PCID in its low bits.
+         * @param update_lru Whether to update the replacement state.
+         * @return The entry, or nullptr if none matches.
+         */
+        Entry *
+        lookup(Addr key, bool update_lru = true)
+        {
+            const unsigned set = setOf(key);
+            int way = small.find(set, key);
+            if (way >= 0) {
+                if (update_lru)
+                    small.touch(set, way);
+                return &small.entries[set * small.assoc + way];
+            }
+            if (large.valid[0]) {
+                way = large.find(0, key);
+                if (way >= 0) {
+                    if (update_lru)
+                        large.touch(0, way);
+                    return &large.entries[way];
+                }
+            }
+            return nullptr;
+        }
+
+        /**
+         * Place an entry, replacing another one if needed. The caller must
+         * have checked that no entry matches the key.
+         * @param key Page aligned address with the PCID in its low bits.
+         * @param entry Entry to copy.
+         * @return The stored entry.
+         */
+        Entry *
+        insert(Addr key, const Entry &entry)
+        {
+            const Addr match = exact ? ~Addr(0) : ~mask(entry.logBytes);
+            const bool is_large = !exact && entry.logBytes > PageShift;
+            Array &array = is_large ? large : small;
+            const unsigned set = is_large ? 0 : setOf(key);
+            const unsigned way = array.victim(set);
+            const unsigned idx = set * array.assoc + way;
+
+            if (is_large) {
+                // Base pages the new entry covers would be found first
+                for (unsigned i = 0; i < small.sets * small.assoc; i++) {
+                    if ((small.tags[i] & match) == (key & match))
+                        small.invalidate(i / small.assoc, i % small.assoc);
+                }
+            }
+
+            array.tags[idx] = key & match;
+            array.masks[idx] = match;
+            array.fill(set, way);
+            array.entries[idx] = entry;
+            return &array.entries[idx];
+        }
+
+        /** Invalidate the entry matching a key, if any */
+        void
+        demap(Addr key)
+        {
+            const unsigned set = setOf(key);
+            int way = small.find(set, key);
+            if (way >= 0) {
+                small.invalidate(set, way);
+                return;
+            }
+            way = large.find(0, key);
+            if (way >= 0)
+                large.invalidate(0, way);
+        }
+
+        void
+        flushAll()
+        {
+            small.invalidateAll();
+            large.invalidateAll();
+        }
+
+        /** Invalidate all entries but the ones for global pages */
+        void
+        flushNonGlobal()
+        {
+            for (Array *array : {&small, &large}) {
+                for (unsigned set = 0; set < array->sets; set++) {
+                    for (uint64_t v = array->valid[set]; v; v &= v - 1) {
+                        const unsigned way = ctz64(v);
+                        if (!array->entries[set * array->assoc + way].global)
+                            array->invalidate(set, way);
+                    }
+                }
+            }
+        }
+
+        /** Call a function on every valid entry */
+        template <typename F>
+        void
+        forEach(F &&f) const
+        {
+            for (const Array *array : {&small, &large}) {
+                for (unsigned set = 0; set < array->sets; set++) {
+                    for (uint64_t v = array->valid[set]; v; v &= v - 1)
+                        f(array->entries[set * array->assoc + ctz64(v)]);
+                }
+            }
+        }
+
+        /** Number of valid entries */
+        unsigned
+        occupancy() const
+        {
+            unsigned count = 0;
+            for (const Array *array : {&small, &large}) {
+                for (uint64_t v : array->valid)
+                    count += popCount(v);
+            }
+            return count;
+        }
+    };
+
+} // namespace X86ISA
+} // namespace gem5
+
+#endif // __ARCH_X86_FLAT_TLB_HH__
@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2025 Boston University
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "arch/x86/flat_tlb.hh"
+#include "base/trie.hh"
+
+using namespace gem5;
+using namespace gem5::X86ISA;
+
+namespace
+{
+
+struct Entry
+{
+    Addr vaddr = 0;
+    unsigned logBytes = PageShift;
+    bool global = false;
+    int id = 0;
+};
+
+using EntryTrie = Trie<Addr, Entry>;
+
+Entry
+makeEntry(Addr vaddr, unsigned log_bytes, int id, bool global = false)
+{
+    Entry entry;
+    entry.vaddr = vaddr;
+    entry.logBytes = log_bytes;
+    entry.global = global;
+    entry.id = id;
+    return entry;
+}
+
+/** Key with a PCID, as formed by TLB::concAddrPcid() */
+Addr
+key(Addr vaddr, Addr pcid)
+{
+    return (vaddr & ~mask(PageShift)) | pcid;
+}
+
+} // anonymous namespace
+
+/** Base and large pages match like in the trie, PCIDs are ignored */
+TEST(FlatTlbTest, Match)
+{
+    FlatTlb<Entry> tlb(64, 4, 8, false);
+    EntryTrie trie;
+    std::vector<Entry> entries = {
+        makeEntry(key(0x7000, 3), 12, 1),
+        makeEntry(key(0x40000000, 0), 21, 2),
+        makeEntry(key(0x80000000, 5), 30, 3),
+    };
+    for (auto &entry : entries) {
+        tlb.insert(entry.vaddr, entry);
+        trie.insert(entry.vaddr, EntryTrie::MaxBits - entry.logBytes,
+                    &entry);
+    }
+    EXPECT_EQ(tlb.occupancy(), 3);
+
+    for (Addr probe : {key(0x7000, 3), key(0x7000, 0), key(0x8000, 3),
+                       key(0x40000000, 7), key(0x401ff000, 0),
+                       key(0x40200000, 0), key(0xbffff000, 1),
+                       key(0xc0000000, 5)}) {
+        const Entry *expected = trie.lookup(probe);
+        const Entry *found = tlb.lookup(probe);
+        ASSERT_EQ(found == nullptr, expected == nullptr) << probe;
+        if (expected) {
+            EXPECT_EQ(found->id, expected->id) << probe;
+        }
+    }
+}
+
+/** Exact matches keep apart the same page of different PCIDs */
+TEST(FlatTlbTest, ExactMatch)
+{
+    FlatTlb<Entry> tlb(64, 4, 8, true);
+    tlb.insert(key(0x7000, 1), makeEntry(key(0x7000, 1), 12, 1));
+    tlb.insert(key(0x7000, 2), makeEntry(key(0x7000, 2), 12, 2));
+
+    ASSERT_NE(tlb.lookup(key(0x7000, 1)), nullptr);
+    EXPECT_EQ(tlb.lookup(key(0x7000, 1))->id, 1);
+    EXPECT_EQ(tlb.lookup(key(0x7000, 2))->id, 2);
+    EXPECT_EQ(tlb.lookup(key(0x7000, 3)), nullptr);
+
+    tlb.demap(key(0x7000, 1));
+    EXPECT_EQ(tlb.lookup(key(0x7000, 1)), nullptr);
+    EXPECT_EQ(tlb.lookup(key(0x7000, 2))->id, 2);
+}
+
+/** Flushes keep global pages unless everything is flushed */
+TEST(FlatTlbTest, Flush)
+{
+    FlatTlb<Entry> tlb(64, 4, 8, false);
+    tlb.insert(0x1000, makeEntry(0x1000, 12, 1, true));
+    tlb.insert(0x2000, makeEntry(0x2000, 12, 2));
+    tlb.insert(0x200000, makeEntry(0x200000, 21, 3, true));
+    tlb.insert(0x400000, makeEntry(0x400000, 21, 4));
+
+    tlb.flushNonGlobal();
+    EXPECT_EQ(tlb.occupancy(), 2);
+    EXPECT_NE(tlb.lookup(0x1000), nullptr);
+    EXPECT_EQ(tlb.lookup(0x2000), nullptr);
+    EXPECT_NE(tlb.lookup(0x200000), nullptr);
+    EXPECT_EQ(tlb.lookup(0x400000), nullptr);
+
+    std::vector<int> ids;
+    tlb.forEach([&ids](const Entry &entry) { ids.push_back(entry.id); });
+    EXPECT_EQ(ids, std::vector<int>({1, 3}));
+
+    tlb.flushAll();
+    EXPECT_EQ(tlb.occupancy(), 0);
+    EXPECT_EQ(tlb.lookup(0x1000), nullptr);
+}
+
+/** A full set never replaces its most recently used entry */
+TEST(FlatTlbTest, Replacement)
+{
+    const unsigned sets = 16;
+    const unsigned assoc = 4;
+    FlatTlb<Entry> tlb(sets * assoc, assoc, 8, false);
+    EXPECT_EQ(tlb.capacity(), sets * assoc + 8);
+
+    // Pages of the same set
+    auto page = [](int i) { return Addr(i) * sets << PageShift; };
+    for (int i = 0; i < 64; i++) {
+        tlb.insert(page(i), makeEntry(page(i), 12, i));
+        ASSERT_LE(tlb.occupancy(), assoc);
+        if (i > 0) {
+            ASSERT_NE(tlb.lookup(page(i - 1)), nullptr);
+        }
+        ASSERT_NE(tlb.lookup(page(i)), nullptr);
+    }
+    EXPECT_EQ(tlb.occupancy(), assoc);
+}
@@ -68,6 +68,39 @@ namespace gem5
 
 namespace X86ISA {
 
+Walker::Walker(const Params &params) :
+    ClockedObject(params), port(name() + ".port", this),
+    funcState(this, NULL, NULL, true), tlb(NULL), sys(params.system),
+    requestorId(sys->getRequestorId(this)),
+    numSquashable(params.num_squash_per_cycle),
+    startWalkWrapperEvent([this]{ startWalkWrapper(); }, name()),
+    stats(this)
+{
+    if (params.walk_caches) {
+        walkCaches[PML4Cache] = std::make_unique<WalkCache>(
+            name() + ".pml4Cache", 39, params.pml4_cache_entries,
+            params.pml4_cache_assoc, params.pml4_cache_replacement_policy,
+            params.pml4_cache_indexing_policy);
+        walkCaches[PDPCache] = std::make_unique<WalkCache>(
+            name() + ".pdpCache", 30, params.pdp_cache_entries,
+            params.pdp_cache_assoc, params.pdp_cache_replacement_policy,
+            params.pdp_cache_indexing_policy);
+        walkCaches[PDCache] = std::make_unique<WalkCache>(
+            name() + ".pdCache", 21, params.pd_cache_entries,
+            params.pd_cache_assoc, params.pd_cache_replacement_policy,
+            params.pd_cache_indexing_policy);
+    }
+}
+
+void
+Walker::flushWalkCaches()
+{
+    for (auto &cache : walkCaches) {
+        if (cache)
+            cache->clear();
+    }
+}
+
 Fault
 Walker::start(ThreadContext * _tc, BaseMMU::Translation *_translation,
               const RequestPtr &_req, BaseMMU::Mode _mode)
@@ -158,6 +191,10 @@ bool Walker::sendTiming(WalkerState* sendingState, PacketPtr pkt)
     WalkerSenderState* walker_state = new WalkerSenderState(sendingState);
     pkt->pushSenderState(walker_state);
     if (port.sendTimingReq(pkt)) {
+        if (pkt->isRead())
+            stats.walkReads++;
+        else
+            stats.walkWrites++;
         return true;
     } else {
         // undo the adding of the sender state and delete it, as we
@@ -232,6 +269,7 @@ Walker::WalkerState::startWalk()
     Fault fault = NoFault;
     assert(!started);
     started = true;
+    walker->stats.walks++;
     setupWalk(req->getVaddr());
     if (timing) {
         nextState = state;
@@ -241,13 +279,16 @@ Walker::WalkerState::startWalk()
     } else {
         do {
             walker->port.sendAtomic(read);
+            walker->stats.walkReads++;
             PacketPtr write = NULL;
             fault = stepWalk(write);
             assert(fault == NoFault || read == NULL);
             state = nextState;
             nextState = Ready;
-            if (write)
+            if (write) {
                 walker->port.sendAtomic(write);
+                walker->stats.walkWrites++;
+            }
         } while (read);
         state = Ready;
         nextState = Waiting;
@@ -312,6 +353,7 @@ Walker::WalkerState::stepWalk(PacketPtr &write)
         }
         entry.noExec = pte.nx;
         nextState = LongPDP;
+        fillWalkCache(PML4Cache, mbits(pte, 51, 12), uncacheable);
         break;
       case LongPDP:
         DPRINTF(PageTableWalker, "Got long mode PDP entry %#016x.\n", pte);
@@ -326,6 +368,7 @@ Walker::WalkerState::stepWalk(PacketPtr &write)
             break;
         }
         nextState = LongPD;
+        fillWalkCache(PDPCache, mbits(pte, 51, 12), uncacheable);
         break;
       case LongPD:
         DPRINTF(PageTableWalker, "Got long mode PD entry %#016x.\n", pte);
@@ -343,6 +386,7 @@ Walker::WalkerState::stepWalk(PacketPtr &write)
             entry.logBytes = 12;
             nextRead = mbits(pte, 51, 12) + vaddr.longl1 * dataSize;
             nextState = LongPTE;
+            fillWalkCache(PDCache, mbits(pte, 51, 12), uncacheable);
             break;
         } else {
             // 2 MB page
@@ -601,6 +645,9 @@ Walker::WalkerState::setupWalk(Addr vaddr)
     if (!cr4.pcide && cr3.pcd)
         flags.set(Request::UNCACHEABLE);
 
+    if (state == LongPML4 && !functional && walker->walkCaches[PML4Cache])
+        skipCachedLevels(addr, topAddr, flags);
+
     RequestPtr request = std::make_shared<Request>(
         topAddr, dataSize, flags, walker->requestorId);
 
@@ -608,6 +655,56 @@ Walker::WalkerState::setupWalk(Addr vaddr)
     read->allocate();
 }
 
+void
+Walker::WalkerState::skipCachedLevels(VAddr addr, Addr &topAddr,
+                                      Request::Flags &flags)
+{
+    // Look for the deepest level first, it saves the most reads.
+    for (int level = PDCache; level >= PML4Cache; level--) {
+        const WalkCacheEntry *cached = walker->walkCaches[level]->lookup(addr);
+        if (!cached) {
+            walker->stats.walkCacheMisses[level]++;
+            continue;
+        }
+        walker->stats.walkCacheHits[level]++;
+
+        entry.writable = cached->writable;
+        entry.user = cached->user;
+        entry.noExec = cached->noExec;
+        flags.set(Request::UNCACHEABLE, cached->uncacheable);
+        switch (level) {
+          case PDCache:
+            state = LongPTE;
+            topAddr = cached->table + addr.longl1 * dataSize;
+            break;
+          case PDPCache:
+            state = LongPD;
+            topAddr = cached->table + addr.longl2 * dataSize;
+            break;
+          case PML4Cache:
+            state = LongPDP;
+            topAddr = cached->table + addr.longl3 * dataSize;
+            break;
+        }
+        DPRINTF(PageTableWalker, "Paging-structure cache hit for %#x, "
+                "reading %#x.\n", addr, topAddr);
+        return;
+    }
+}
+
+void
+Walker::WalkerState::fillWalkCache(int level, Addr table, bool uncacheable)
+{
+    if (functional || !walker->walkCaches[level])
+        return;
+    WalkCacheEntry *cached = walker->walkCaches[level]->allocate(entry.vaddr);
+    cached->table = table;
+    cached->writable = entry.writable;
+    cached->user = entry.user;
+    cached->noExec = entry.noExec;
+    cached->uncacheable = uncacheable;
+}
+
 bool
 Walker::WalkerState::recvPacket(PacketPtr pkt)
 {
@@ -644,6 +741,7 @@ Walker::WalkerState::recvPacket(PacketPtr pkt)
     if (inflight == 0 && read == NULL && writes.size() == 0) {
         state = Ready;
         nextState = Waiting;
+        walker->stats.walkLatency.sample(curTick() - startTick);
         if (timingFault == NoFault) {
             /*
              * Finish the translation. Now that we know the right entry is
@@ -738,6 +836,30 @@ Walker::WalkerState::retry()
     sendPackets();
 }
 
+Walker::WalkerStats::WalkerStats(statistics::Group *parent)
+  : statistics::Group(parent),
+    ADD_STAT(walks, statistics::units::Count::get(),
+             "Number of page table walks, excluding functional ones"),
+    ADD_STAT(walkLatency, statistics::units::Tick::get(),
+             "Time from the request of a timing walk to its completion"),
+    ADD_STAT(walkReads, statistics::units::Count::get(),
+             "Page table entries read by walks"),
+    ADD_STAT(walkWrites, statistics::units::Count::get(),
+             "Page table entries written back by walks"),
+    ADD_STAT(walkCacheHits, statistics::units::Count::get(),
+             "Hits in the paging-structure caches"),
+    ADD_STAT(walkCacheMisses, statistics::units::Count::get(),
+             "Misses in the paging-structure caches")
+{
+    walkLatency.init(16);
+    for (auto *vec : {&walkCacheHits, &walkCacheMisses}) {
+        vec->init(NumWalkCaches);
+        vec->subname(PML4Cache, "pml4");
+        vec->subname(PDPCache, "pdp");
+        vec->subname(PDCache, "pd");
+    }
+}
+
 Fault
 Walker::WalkerState::pageFault(bool present)
 {
@@ -38,11 +38,15 @@
 #ifndef __ARCH_X86_PAGE_TABLE_WALKER_HH__
 #define __ARCH_X86_PAGE_TABLE_WALKER_HH__
 
+#include <array>
+#include <memory>
 #include <vector>
 
 #include "arch/generic/mmu.hh"
 #include "arch/x86/pagetable.hh"
 #include "arch/x86/tlb.hh"
+#include "arch/x86/walk_cache.hh"
+#include "base/statistics.hh"
 #include "base/types.hh"
 #include "mem/packet.hh"
 #include "params/X86PagetableWalker.hh"
@@ -115,6 +119,8 @@ namespace X86ISA
             bool retrying;
             bool started;
             bool squashed;
+            // When the walk was requested
+            Tick startTick;
           public:
             WalkerState(Walker * _walker, BaseMMU::Translation *_translation,
                         const RequestPtr &_req, bool _isFunctional = false) :
@@ -122,7 +128,8 @@ namespace X86ISA
                 nextState(Ready), inflight(0),
                 translation(_translation),
                 functional(_isFunctional), timing(false),
-                retrying(false), started(false), squashed(false)
+                retrying(false), started(false), squashed(false),
+                startTick(curTick())
             {
             }
             void initState(ThreadContext * _tc, BaseMMU::Mode _mode,
@@ -140,6 +147,9 @@ namespace X86ISA
 
           private:
             void setupWalk(Addr vaddr);
+            void skipCachedLevels(VAddr addr, Addr &topAddr,
+                                  Request::Flags &flags);
+            void fillWalkCache(int level, Addr table, bool uncacheable);
             Fault stepWalk(PacketPtr &write);
             void sendPackets();
             void endWalk();
@@ -178,6 +188,15 @@ namespace X86ISA
         // The number of outstanding walks that can be squashed per cycle.
         unsigned numSquashable;
 
+        // Paging-structure caches of long mode walks, from the top level.
+        enum WalkCacheLevel
+        {
+            PML4Cache, PDPCache, PDCache,
+            NumWalkCaches
+        };
+        // Empty if the walker does not use them.
+        std::array<std::unique_ptr<WalkCache>, NumWalkCaches> walkCaches;
+
         // Wrapper for checking for squashes before starting a translation.
         void startWalkWrapper();
 
@@ -198,16 +217,25 @@ namespace X86ISA
             tlb = _tlb;
         }
 
+        // Invalidate the paging-structure caches, along with the TLB.
+        void flushWalkCaches();
+
         using Params = X86PagetableWalkerParams;
 
-        Walker(const Params &params) :
-            ClockedObject(params), port(name() + ".port", this),
-            funcState(this, NULL, NULL, true), tlb(NULL), sys(params.system),
-            requestorId(sys->getRequestorId(this)),
-            numSquashable(params.num_squash_per_cycle),
-            startWalkWrapperEvent([this]{ startWalkWrapper(); }, name())
+        Walker(const Params &params);
+
+      protected:
+        struct WalkerStats : public statistics::Group
         {
-        }
+            WalkerStats(statistics::Group *parent);
+
+            statistics::Scalar walks;
+            statistics::Histogram walkLatency;
+            statistics::Scalar walkReads;
+            statistics::Scalar walkWrites;
+            statistics::Vector walkCacheHits;
+            statistics::Vector walkCacheMisses;
+        } stats;
     };
 
 } // namespace X86ISA
@@ -64,18 +64,30 @@ namespace X86ISA {
 
 TLB::TLB(const Params &p)
     : BaseTLB(p), configAddress(0), size(p.size),
-      tlb(size), lruSeq(0), m5opRange(p.system->m5opRange()), stats(this)
+      tlb(size), lruSeq(0), hitLatency(p.hit_latency), lookupDelay(0),
+      m5opRange(p.system->m5opRange()), stats(this)
 {
     if (!size)
         fatal("TLBs must have a non-zero size.\n");
 
-    for (int x = 0; x < size; x++) {
+    if (p.assoc) {
+        // Syscall emulation keeps the PCID in every match, as the trie
+        // does when it ignores the page size.
+        flatTlb = std::make_unique<FlatTlb<TlbEntry>>(
+            size, p.assoc, p.large_page_entries, !FullSystem,
+            p.replacement_policy);
+        tlb.clear();
+    }
+
+    for (unsigned x = 0; x < tlb.size(); x++) {
         tlb[x].trieHandle = NULL;
         freeList.push_back(&tlb[x]);
     }
 
+    // Shared levels are only filled by the levels above them
     walker = p.walker;
-    walker->setTLB(this);
+    if (walker)
+        walker->setTLB(this);
 }
 
 void
@@ -83,6 +95,7 @@ TLB::evictLRU()
 {
     // Find the entry with the lowest (and hence least recently updated)
     // sequence number.
+    assert(!flatTlb);
 
     unsigned lru = 0;
     for (unsigned i = 1; i < size; i++) {
@@ -99,12 +112,28 @@ TLB::evictLRU()
 TlbEntry *
 TLB::insert(Addr vpn, const TlbEntry &entry, uint64_t pcid)
 {
+    // Keep the shared level inclusive of this one
+    if (auto next_level = static_cast<TLB *>(nextLevel()))
+        next_level->insert(vpn, entry, pcid);
+
     //Adding pcid to the page address so
     //that multiple processes using the same
     //tlb do not conflict when using the same
     //virtual addresses
     vpn = concAddrPcid(vpn, pcid);
 
+    if (flatTlb) {
+        // If somebody beat us to it, just use that existing entry.
+        TlbEntry *newEntry = flatTlb->lookup(vpn, false);
+        if (!newEntry) {
+            newEntry = flatTlb->insert(vpn, entry);
+            newEntry->vaddr = vpn;
+            newEntry->trieHandle = NULL;
+        }
+        newEntry->lruSeq = nextSeq();
+        return newEntry;
+    }
+
     // If somebody beat us to it, just use that existing entry.
     TlbEntry *newEntry = trie.lookup(vpn);
     if (newEntry) {
@@ -132,10 +161,27 @@ TLB::insert(Addr vpn, const TlbEntry &entry, uint64_t pcid)
     return newEntry;
 }
 
+TlbEntry *
+TLB::lookupShared(Addr va, BaseMMU::Mode mode)
+{
+    TlbEntry *entry = lookup(va);
+    if (mode == BaseMMU::Read) {
+        stats.rdAccesses++;
+        if (!entry)
+            stats.rdMisses++;
+    } else {
+        stats.wrAccesses++;
+        if (!entry)
+            stats.wrMisses++;
+    }
+    return entry;
+}
+
 TlbEntry *
 TLB::lookup(Addr va, bool update_lru)
 {
-    TlbEntry *entry = trie.lookup(va);
+    TlbEntry *entry = flatTlb ? flatTlb->lookup(va, update_lru) :
+        trie.lookup(va);
     if (entry && update_lru)
         entry->lruSeq = nextSeq();
     return entry;
@@ -145,6 +191,12 @@ void
 TLB::flushAll()
 {
     DPRINTF(TLB, "Invalidating all entries.\n");
+    if (walker)
+        walker->flushWalkCaches();
+    if (flatTlb) {
+        flatTlb->flushAll();
+        return;
+    }
     for (unsigned i = 0; i < size; i++) {
         if (tlb[i].trieHandle) {
             trie.remove(tlb[i].trieHandle);
@@ -164,6 +216,14 @@ void
 TLB::flushNonGlobal()
 {
     DPRINTF(TLB, "Invalidating all non global entries.\n");
+    if (walker)
+        walker->flushWalkCaches();
+    if (auto next_level = static_cast<TLB *>(nextLevel()))
+        next_level->flushNonGlobal();
+    if (flatTlb) {
+        flatTlb->flushNonGlobal();
+        return;
+    }
     for (unsigned i = 0; i < size; i++) {
         if (tlb[i].trieHandle && !tlb[i].global) {
             trie.remove(tlb[i].trieHandle);
@@ -176,6 +236,14 @@ TLB::flushNonGlobal()
 void
 TLB::demapPage(Addr va, uint64_t asn)
 {
+    if (walker)
+        walker->flushWalkCaches();
+    if (auto next_level = static_cast<TLB *>(nextLevel()))
+        next_level->demapPage(va, asn);
+    if (flatTlb) {
+        flatTlb->demap(va);
+        return;
+    }
     TlbEntry *entry = trie.lookup(va);
     if (entry) {
         trie.remove(entry->trieHandle);
@@ -328,6 +396,7 @@ TLB::translate(const RequestPtr &req,
     bool storeCheck = flags & Request::READ_MODIFY_WRITE;
 
     delayedResponse = false;
+    lookupDelay = 0;
 
     // If this is true, we're dealing with a request to a non-memory address
     // space.
@@ -432,7 +501,19 @@ TLB::translate(const RequestPtr &req,
                 } else {
                     stats.wrMisses++;
                 }
-                if (FullSystem) {
+                // Try the shared level before walking the page table
+                if (auto next_level = static_cast<TLB *>(nextLevel())) {
+                    if (TlbEntry *shared =
+                            next_level->lookupShared(pageAlignedVaddr, mode)) {
+                        entry = insert(shared->vaddr, *shared, 0);
+                        lookupDelay = next_level->hitLatency;
+                    }
+                }
+                if (entry) {
+                    DPRINTF(TLB, "Miss was serviced by %s.\n",
+                            nextLevel()->name());
+                } else if (FullSystem) {
+                    panic_if(!walker, "%s has no page table walker.", name());
                     Fault fault = walker->start(tc, translation, req, mode);
                     if (timing || fault != NoFault) {
                         // This gets ignored in atomic mode.
@@ -564,10 +645,20 @@ TLB::translateTiming(const RequestPtr &req, ThreadContext *tc,
         mode = BaseMMU::Read;
     Fault fault =
         TLB::translate(req, tc, translation, mode, delayedResponse, true);
-    if (!delayedResponse)
+    if (!delayedResponse && lookupDelay) {
+        // Served by a slower shared level
+        translation->markDelayed();
+        schedule(new EventFunctionWrapper(
+                     [translation, fault, req, tc, mode]() {
+                         translation->finish(fault, req, tc, mode);
+                     },
+                     name() + ".sharedHit", true),
+                 curTick() + lookupDelay);
+    } else if (!delayedResponse) {
         translation->finish(fault, req, tc, mode);
-    else
+    } else {
         translation->markDelayed();
+    }
 }
 
 Walker *
@@ -593,11 +684,17 @@ void
 TLB::serialize(CheckpointOut &cp) const
 {
     // Only store the entries in use.
-    uint32_t _size = size - freeList.size();
+    uint32_t _size = flatTlb ? flatTlb->occupancy() : size - freeList.size();
     SERIALIZE_SCALAR(_size);
     SERIALIZE_SCALAR(lruSeq);
 
     uint32_t _count = 0;
+    if (flatTlb) {
+        flatTlb->forEach([&](const TlbEntry &entry) {
+            entry.serializeSection(cp, csprintf("Entry%d", _count++));
+        });
+        return;
+    }
     for (uint32_t x = 0; x < size; x++) {
         if (tlb[x].trieHandle != NULL)
             tlb[x].serializeSection(cp, csprintf("Entry%d", _count++));
@@ -610,12 +707,23 @@ TLB::unserialize(CheckpointIn &cp)
     // Do not allow to restore with a smaller tlb.
     uint32_t _size;
     UNSERIALIZE_SCALAR(_size);
-    if (_size > size) {
+    if (_size > (flatTlb ? flatTlb->capacity() : size)) {
         fatal("TLB size less than the one in checkpoint!");
     }
 
     UNSERIALIZE_SCALAR(lruSeq);
 
+    if (flatTlb) {
+        // Entries that no longer fit in their set replace older ones.
+        for (uint32_t x = 0; x < _size; x++) {
+            TlbEntry entry;
+            entry.unserializeSection(cp, csprintf("Entry%d", x));
+            if (!flatTlb->lookup(entry.vaddr, false))
+                flatTlb->insert(entry.vaddr, entry)->trieHandle = NULL;
+        }
+        return;
+    }
+
     for (uint32_t x = 0; x < _size; x++) {
         TlbEntry *newEntry = freeList.front();
         freeList.pop_front();
@@ -629,7 +737,7 @@ TLB::unserialize(CheckpointIn &cp)
 Port *
 TLB::getTableWalkerPort()
 {
-    return &walker->getPort("port");
+    return walker ? &walker->getPort("port") : nullptr;
 }
 
 } // namespace X86ISA
@@ -39,9 +39,11 @@
 #define __ARCH_X86_TLB_HH__
 
 #include <list>
+#include <memory>
 #include <vector>
 
 #include "arch/generic/tlb.hh"
+#include "arch/x86/flat_tlb.hh"
 #include "arch/x86/pagetable.hh"
 #include "base/trie.hh"
 #include "mem/request.hh"
@@ -75,6 +77,14 @@ namespace X86ISA
 
         TlbEntry *lookup(Addr va, bool update_lru = true);
 
+        /**
+         * Look up an entry on behalf of a previous level that missed,
+         * counting the access in the stats of this level.
+         * @param va Page aligned address with the PCID in its low bits.
+         * @param mode Access mode of the request.
+         */
+        TlbEntry *lookupShared(Addr va, BaseMMU::Mode mode);
+
         void setConfigAddress(uint32_t addr);
         //concatenate Page Addr and pcid
         inline Addr concAddrPcid(Addr vpn, uint64_t pcid)
@@ -107,6 +117,21 @@ namespace X86ISA
         TlbEntryTrie trie;
         uint64_t lruSeq;
 
+        /**
+         * Set-associative entries, used instead of the trie and the free
+         * list when the TLB is given an associativity.
+         */
+        std::unique_ptr<FlatTlb<TlbEntry>> flatTlb;
+
+        /** Latency of a hit when this TLB is a shared level */
+        const Tick hitLatency;
+
+        /**
+         * Latency of the shared level hit of the last translation, paid
+         * before a timing translation completes.
+         */
+        Tick lookupDelay;
+
         AddrRange m5opRange;
 
         struct TlbStats : public statistics::Group
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2025 Boston University
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef __ARCH_X86_WALK_CACHE_HH__
+#define __ARCH_X86_WALK_CACHE_HH__
+
+#include <string>
+
+#include "base/bitfield.hh"
+#include "base/cache/associative_cache.hh"
+#include "base/cache/cache_entry.hh"
+#include "base/types.hh"
+#include "mem/cache/replacement_policies/base.hh"
+#include "mem/cache/tags/indexing_policies/base.hh"
+
+namespace gem5
+{
+
+namespace X86ISA
+{
+    /**
+     * Entry of a paging-structure cache: the table a walk reads next, and
+     * what the levels above it already determined.
+     */
+    class WalkCacheEntry : public CacheEntry
+    {
+      public:
+        WalkCacheEntry(TagExtractor ext)
+            : CacheEntry(ext), table(0), writable(false), user(false),
+              noExec(false), uncacheable(false)
+        {}
+
+        /** Physical address of the next level table */
+        Addr table;
+        /** Permissions granted by the levels above the table */
+        bool writable;
+        bool user;
+        bool noExec;
+        /** Whether the table is read uncached */
+        bool uncacheable;
+    };
+
+    /**
+     * Paging-structure cache for one level of long mode walks, like the
+     * PML4, PDPT and PD caches of x86 processors. It is looked up with the
+     * virtual address bits translated down to its level, so that a hit lets
+     * the walk skip the memory accesses of that level and the ones above.
+     */
+    class WalkCache : public AssociativeCache<WalkCacheEntry>
+    {
+      public:
+        /**
+         * @param name Name of the cache.
+         * @param _shift Lowest virtual address bit translated down to the
+         *        level of the cache.
+         */
+        WalkCache(const std::string &name, unsigned _shift,
+                  size_t num_entries, size_t assoc,
+                  replacement_policy::Base *repl_policy,
+                  BaseIndexingPolicy *indexing_policy)
+            : AssociativeCache<WalkCacheEntry>(name.c_str(), num_entries,
+                  assoc, repl_policy, indexing_policy,
+                  WalkCacheEntry(genTagExtractor(indexing_policy))),
+              shift(_shift)
+        {}
+
+        const unsigned shift;
+
+        WalkCacheEntry *
+        lookup(Addr vaddr)
+        {
+            return accessEntry(key(vaddr));
+        }
+
+        /** Find or allocate the entry for an address */
+        WalkCacheEntry *
+        allocate(Addr vaddr)
+        {
+            const Addr k = key(vaddr);
+            WalkCacheEntry *entry = findEntry(k);
+            if (entry) {
+                accessEntry(entry);
+            } else {
+                entry = findVictim(k);
+                insertEntry(k, entry);
+            }
+            return entry;
+        }
+
+      private:
+        /** Canonical addresses have 48 significant bits */
+        Addr key(Addr vaddr) const { return bits(vaddr, 47, shift); }
+    };
+
+} // namespace X86ISA
+} // namespace gem5
+
+#endif // __ARCH_X86_WALK_CACHE_HH__
@@ -86,6 +86,7 @@ allFlags()
 }
 
 bool Flag::_globalEnable = false;
+int SimpleFlag::_numTracing = 0;
 
 Flag *
 findFlag(const std::string &name)
@@ -137,6 +138,14 @@ SimpleFlag::SimpleFlag(const char *name, const char *desc, bool is_format)
         AllFlagsFlag::instance().add(this);
 }
 
+void
+CompiledOutFlag::enable()
+{
+    warn("Debug flag %s was compiled out of this binary and will not "
+         "print anything.", _name);
+    SimpleFlag::enable();
+}
+
 void
 CompoundFlag::enable()
 {
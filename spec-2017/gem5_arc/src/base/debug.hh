@@ -96,10 +96,20 @@ class SimpleFlag : public Flag
 
     bool _enabled = false; // flag enablement status
 
-    void sync() override { _tracing = _globalEnable && _enabled; }
+    static int _numTracing; // number of simple flags that are tracing
+
+    void
+    sync() override
+    {
+        const bool tracing = _globalEnable && _enabled;
+        if (tracing != _tracing)
+            _numTracing += tracing ? 1 : -1;
+        _tracing = tracing;
+    }
 
   public:
     SimpleFlag(const char *name, const char *desc, bool is_format=false);
+    ~SimpleFlag() { if (_tracing) --_numTracing; }
 
     void enable() override  { _enabled = true;  sync(); }
     void disable() override { _enabled = false; sync(); }
@@ -111,6 +121,29 @@ class SimpleFlag : public Flag
      * @return True if this flag is a debug-formatting flag.
      */
     bool isFormat() const { return _isFormat; }
+
+    /** Whether any simple flag is tracing, i.e., DPRINTFs may print. */
+    static bool anyTracing() { return TRACING_ON && _numTracing > 0; }
+};
+
+/**
+ * A simple flag whose DPRINTFs were removed at build time (see the
+ * DEBUG_FLAGS_COMPILED_OUT build option). The flag is still registered so
+ * that scripts naming it keep working, but it can never trace, and since
+ * its conversion to bool is a constant the tracing macros fold away.
+ */
+class CompiledOutFlag : public SimpleFlag
+{
+  protected:
+    void sync() override { _tracing = false; }
+
+  public:
+    using SimpleFlag::SimpleFlag;
+
+    void enable() override;
+
+    constexpr bool tracing() const { return false; }
+    constexpr operator bool() const { return false; }
 };
 
 class CompoundFlag : public Flag
@@ -99,6 +99,49 @@ TEST(DebugSimpleFlagTest, Enabled)
     ASSERT_FALSE(flag.tracing());
 }
 
+/** Test that anyTracing() follows the flags that are tracing. */
+TEST(DebugSimpleFlagTest, AnyTracing)
+{
+    debug::Flag::globalDisable();
+    ASSERT_FALSE(debug::SimpleFlag::anyTracing());
+
+    {
+        debug::SimpleFlag flag_a("AnyTracingTestA", "");
+        debug::SimpleFlag flag_b("AnyTracingTestB", "");
+        flag_a.enable();
+        flag_b.enable();
+        ASSERT_FALSE(debug::SimpleFlag::anyTracing());
+
+        debug::Flag::globalEnable();
+        ASSERT_EQ(debug::SimpleFlag::anyTracing(), TRACING_ON);
+        flag_a.disable();
+        ASSERT_EQ(debug::SimpleFlag::anyTracing(), TRACING_ON);
+        flag_b.disable();
+        ASSERT_FALSE(debug::SimpleFlag::anyTracing());
+
+        // Destroying a flag that is tracing must not leave it counted
+        flag_b.enable();
+    }
+    ASSERT_FALSE(debug::SimpleFlag::anyTracing());
+    debug::Flag::globalDisable();
+}
+
+/** Test that a compiled-out flag never traces, even when enabled. */
+TEST(DebugCompiledOutFlagTest, NeverTraces)
+{
+    debug::Flag::globalEnable();
+    debug::CompiledOutFlag flag("CompiledOutFlagTest", "");
+
+    gtestLogOutput.str("");
+    flag.enable();
+    ASSERT_NE(gtestLogOutput.str().find("compiled out"), std::string::npos);
+    ASSERT_FALSE(flag);
+    ASSERT_FALSE(flag.tracing());
+    ASSERT_FALSE(((const debug::Flag &)flag).tracing());
+    ASSERT_FALSE(debug::SimpleFlag::anyTracing());
+    debug::Flag::globalDisable();
+}
+
 /**
  * Tests that manipulate the enablement status of the compound flag to change
  * the corresponding status of the kids.
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2025 Boston University
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** @file
+ * Run-time selection of the host instruction set used by vectorized
+ * kernels. A kernel is built for every instruction set in
+ * GEM5_SIMD_HAVE_* and picks one with bestIsa(), or the one it is told
+ * to, so tests can compare the implementations against each other.
+ */
+
+#ifndef __BASE_SIMD_HH__
+#define __BASE_SIMD_HH__
+
+// Kernels for an instruction set the compiler doesn't enable by default
+// are marked with GEM5_SIMD_<ISA> and only run if isSupported() says so.
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define GEM5_SIMD_HAVE_AVX2 1
+#define GEM5_SIMD_AVX2 __attribute__((target("avx2")))
+#else
+#define GEM5_SIMD_HAVE_AVX2 0
+#endif
+
+namespace gem5
+{
+
+namespace simd
+{
+
+/** Instruction sets the kernels can be run with. */
+enum class Isa
+{
+    Scalar,
+    AVX2
+};
+
+/**
+ * Check whether the host can run the kernels with a given instruction set.
+ *
+ * @param isa The instruction set.
+ * @return Whether the kernels were built for, and the CPU supports, it.
+ */
+bool isSupported(Isa isa);
+
+/**
+ * Get the best instruction set supported by the host. This is evaluated
+ * only once.
+ *
+ * @return The instruction set used by default.
+ */
+Isa bestIsa();
+
+} // namespace simd
+} // namespace gem5
+
+#endif // __BASE_SIMD_HH__
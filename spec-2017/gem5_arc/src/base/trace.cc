@@ -31,10 +31,15 @@
 
 #include "base/trace.hh"
 
+#include <algorithm>
+#include <atomic>
 #include <cctype>
+#include <chrono>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <sstream>
+#include <thread>
 
 #include "base/atomicio.hh"
 #include "base/logging.hh"
@@ -103,6 +108,50 @@ disable()
 
 ObjectMatch ignore;
 
+void
+Record::print(std::ostream &os) const
+{
+    cp::Print print(os, fmt);
+    for (int i = 0; i < numArgs; i++) {
+        switch (kinds[i]) {
+          case Kind::Int:
+            print.addArg((int)args[i].s);
+            break;
+          case Kind::Long:
+            print.addArg(args[i].s);
+            break;
+          case Kind::UInt:
+            print.addArg((unsigned)args[i].u);
+            break;
+          case Kind::ULong:
+            print.addArg(args[i].u);
+            break;
+          case Kind::Float:
+            print.addArg(args[i].f);
+            break;
+          case Kind::Char:
+            print.addArg((char)args[i].s);
+            break;
+          case Kind::Pointer:
+            print.addArg(args[i].p);
+            break;
+          case Kind::String:
+            print.addArg(static_cast<const char *>(args[i].p));
+            break;
+          case Kind::Object:
+            {
+                std::ostringstream obj;
+                args[i].obj.print(obj, args[i].obj.ptr);
+                print.addArg(obj.str());
+            }
+            break;
+          case Kind::Elided:
+            print.addArg("<?>");
+            break;
+        }
+    }
+    print.endArgs();
+}
 
 void
 Logger::dump(Tick when, const std::string &name,
@@ -144,6 +193,15 @@ Logger::dump(Tick when, const std::string &name,
     }
 }
 
+void
+Logger::logRecord(const std::string &name, const std::string &flag,
+        Record &record)
+{
+    std::ostringstream line;
+    record.print(line);
+    logMessage(record.when, name, flag, line.str());
+}
+
 void
 OstreamLogger::logMessage(Tick when, const std::string &name,
         const std::string &flag, const std::string &message)
@@ -169,5 +227,344 @@ OstreamLogger::logMessage(Tick when, const std::string &name,
     }
 }
 
+RingLogger::RingLogger(std::ostream &stream_, size_t capacity)
+    : OstreamLogger(stream_), ring(capacity)
+{
+    fatal_if(capacity == 0, "The debug record ring needs at least one slot.");
+    recordArgs = true;
+}
+
+uint32_t
+RingLogger::intern(const std::string &str)
+{
+    auto [it, inserted] = stringIds.try_emplace(str, strings.size());
+    if (inserted)
+        strings.push_back(str);
+    return it->second;
+}
+
+const char *
+RingLogger::internFormat(const char *fmt)
+{
+    // Formats are nearly always literals, so they are looked up by address,
+    // but one built at run time can reuse the address of an older one.
+    auto it = formatCopies.find(fmt);
+    if (it != formatCopies.end() && *it->second == fmt)
+        return it->second->c_str();
+    const std::string &copy = *formats.emplace(fmt).first;
+    formatCopies[fmt] = &copy;
+    return copy.c_str();
+}
+
+void
+RingLogger::logRecord(const std::string &name, const std::string &flag,
+        Record &record)
+{
+    record.fmt = internFormat(record.fmt);
+    record.name = intern(name);
+    record.flag = intern(flag);
+    record.elide();
+    ring[logged++ % ring.size()] = record;
+}
+
+void
+RingLogger::flush()
+{
+    const size_t size = ring.size();
+    const uint64_t first = logged > size ? logged - size : 0;
+    if (first)
+        ccprintf(stream, "%d older debug records were dropped\n", first);
+
+    for (uint64_t i = first; i < logged; i++) {
+        const Record &record = ring[i % size];
+        std::ostringstream line;
+        record.print(line);
+        OstreamLogger::logMessage(record.when, strings[record.name],
+                strings[record.flag], line.str());
+    }
+    logged = 0;
+}
+
+/**
+ * Single producer, single consumer byte queue which its own thread drains
+ * to a stream, so the producer only waits when the queue is full.
+ */
+class BufferedWriter
+{
+  private:
+    std::ostream &stream;
+    std::vector<char> buffer;
+    /** Bytes ever put into and taken out of the buffer */
+    std::atomic<uint64_t> head = 0;
+    std::atomic<uint64_t> tail = 0;
+    std::atomic<bool> stopping = false;
+    std::thread thread;
+
+    void
+    drain()
+    {
+        const size_t size = buffer.size();
+        while (true) {
+            // Check for stopping first, the head read after it is final.
+            const bool stop = stopping.load(std::memory_order_acquire);
+            const uint64_t end = head.load(std::memory_order_acquire);
+            uint64_t pos = tail.load(std::memory_order_relaxed);
+            if (pos == end) {
+                if (stop)
+                    break;
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+                continue;
+            }
+            while (pos != end) {
+                const size_t offset = pos % size;
+                const size_t len = std::min<uint64_t>(end - pos,
+                                                      size - offset);
+                stream.write(&buffer[offset], len);
+                pos += len;
+            }
+            tail.store(pos, std::memory_order_release);
+        }
+        stream.flush();
+    }
+
+  public:
+    BufferedWriter(std::ostream &stream_, size_t size)
+        : stream(stream_), buffer(size), thread([this]() { drain(); })
+    {}
+
+    ~BufferedWriter() { close(); }
+
+    void
+    write(const char *data, size_t len)
+    {
+        if (!thread.joinable()) {
+            stream.write(data, len);
+            return;
+        }
+
+        const size_t size = buffer.size();
+        uint64_t pos = head.load(std::memory_order_relaxed);
+        while (len) {
+            const uint64_t space =
+                size - (pos - tail.load(std::memory_order_acquire));
+            if (!space) {
+                std::this_thread::yield();
+                continue;
+            }
+            const size_t offset = pos % size;
+            const size_t chunk = std::min<uint64_t>(
+                    std::min<uint64_t>(len, space), size - offset);
+            std::memcpy(&buffer[offset], data, chunk);
+            data += chunk;
+            len -= chunk;
+            pos += chunk;
+            head.store(pos, std::memory_order_release);
+        }
+    }
+
+    void
+    close()
+    {
+        if (!thread.joinable())
+            return;
+        stopping.store(true, std::memory_order_release);
+        thread.join();
+    }
+};
+
+namespace
+{
+
+/** Turns text written to a BinaryLogger's ostream into messages. */
+class LineBuf : public std::streambuf
+{
+  private:
+    Logger &logger;
+    std::string line;
+
+  protected:
+    int_type
+    overflow(int_type c) override
+    {
+        if (traits_type::eq_int_type(c, traits_type::eof()))
+            return traits_type::not_eof(c);
+        line.push_back(traits_type::to_char_type(c));
+        if (c == '\n')
+            sync();
+        return c;
+    }
+
+    int
+    sync() override
+    {
+        if (!line.empty())
+            logger.logMessage(MaxTick, "", "", line);
+        line.clear();
+        return 0;
+    }
+
+  public:
+    LineBuf(Logger &logger_) : logger(logger_) {}
+};
+
+class LineStream : public std::ostream
+{
+  private:
+    LineBuf buf;
+
+  public:
+    LineStream(Logger &logger) : std::ostream(nullptr), buf(logger)
+    {
+        rdbuf(&buf);
+    }
+};
+
+} // anonymous namespace
+
+BinaryLogger::BinaryLogger(std::ostream &stream, size_t buffer_size)
+    : writer(new BufferedWriter(stream, buffer_size)),
+      textStream(new LineStream(*this))
+{
+    recordArgs = true;
+    put(Magic);
+    put(Version);
+    writer->write(entry.data(), entry.size());
+    entry.clear();
+}
+
+BinaryLogger::~BinaryLogger()
+{
+    close();
+}
+
+void
+BinaryLogger::close()
+{
+    textStream->flush();
+    writer->close();
+}
+
+void
+BinaryLogger::putString(const char *str, size_t len)
+{
+    put((uint32_t)len);
+    entry.insert(entry.end(), str, str + len);
+}
+
+uint32_t
+BinaryLogger::define(const char *str, size_t len)
+{
+    // Callers look up all their ids before putting their own entry together.
+    const uint32_t id = numStrings++;
+    entry.clear();
+    put(StringTag);
+    put(id);
+    putString(str, len);
+    writer->write(entry.data(), entry.size());
+    return id;
+}
+
+uint32_t
+BinaryLogger::formatId(const char *fmt)
+{
+    // Formats are nearly always literals, so they are looked up by address,
+    // but one built at run time can reuse the address of an older one.
+    auto it = formatIds.find(fmt);
+    if (it != formatIds.end() && it->second->first == fmt)
+        return it->second->second;
+    stringId(fmt);
+    const auto &str = *stringIds.find(fmt);
+    formatIds[fmt] = &str;
+    return str.second;
+}
+
+uint32_t
+BinaryLogger::stringId(const std::string &str)
+{
+    auto it = stringIds.find(str);
+    if (it != stringIds.end())
+        return it->second;
+    const uint32_t id = define(str.data(), str.size());
+    stringIds.emplace(str, id);
+    return id;
+}
+
+uint8_t
+BinaryLogger::formatFlags() const
+{
+    return (debug::FmtTicksOff ? TicksOff : 0) |
+           (debug::FmtFlag ? ShowFlag : 0);
+}
+
+void
+BinaryLogger::logRecord(const std::string &name, const std::string &flag,
+        Record &record)
+{
+    const uint32_t fmt_id = formatId(record.fmt);
+    const uint32_t name_id = stringId(name);
+    const uint32_t flag_id = stringId(flag);
+
+    entry.clear();
+    put(RecordTag);
+    put(formatFlags());
+    put((uint64_t)record.when);
+    put(fmt_id);
+    put(name_id);
+    put(flag_id);
+    put(record.numArgs);
+    for (int i = 0; i < record.numArgs; i++) {
+        const Record::Arg &arg = record.args[i];
+        put(record.kinds[i]);
+        switch (record.kinds[i]) {
+          case Record::Kind::Float:
+            put(arg.f);
+            break;
+          case Record::Kind::Pointer:
+            put((uint64_t)(uintptr_t)arg.p);
+            break;
+          case Record::Kind::String:
+            {
+                const char *str = static_cast<const char *>(arg.p);
+                putString(str, std::strlen(str));
+            }
+            break;
+          case Record::Kind::Object:
+            {
+                std::ostringstream obj;
+                arg.obj.print(obj, arg.obj.ptr);
+                const std::string str = obj.str();
+                putString(str.data(), str.size());
+            }
+            break;
+          case Record::Kind::Elided:
+            break;
+          default:
+            put(arg.u);
+            break;
+        }
+    }
+    writer->write(entry.data(), entry.size());
+}
+
+void
+BinaryLogger::logMessage(Tick when, const std::string &name,
+        const std::string &flag, const std::string &message)
+{
+    if (!isEnabled(name))
+        return;
+
+    const uint32_t name_id = stringId(name);
+    const uint32_t flag_id = stringId(flag);
+
+    entry.clear();
+    put(MessageTag);
+    put(formatFlags());
+    put((uint64_t)when);
+    put(name_id);
+    put(flag_id);
+    putString(message.data(), message.size());
+    writer->write(entry.data(), entry.size());
+}
+
 } // namespace trace
 } // namespace gem5
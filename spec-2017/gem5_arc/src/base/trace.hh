@@ -32,9 +32,15 @@
 #ifndef __BASE_TRACE_HH__
 #define __BASE_TRACE_HH__
 
+#include <cstdint>
+#include <memory>
 #include <ostream>
 #include <string>
 #include <sstream>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "base/compiler.hh"
 #include "base/cprintf.hh"
@@ -54,6 +60,127 @@ namespace gem5
 
 namespace trace {
 
+/**
+ * A debug message captured without formatting it: the format string and up
+ * to MaxArgs arguments. Numbers, and classes like BitUnions and Cycles which
+ * convert to them, are kept by value. The format, strings, enums and other
+ * objects are only referred to, so they are valid until Logger::logRecord
+ * returns. A logger keeping the record must copy the format, which is
+ * usually but not always a literal, and elide the other references, after
+ * which they print as "<?>". The name and flag are ids handed out by the
+ * logger.
+ */
+struct Record
+{
+    static constexpr int MaxArgs = 8;
+
+    /** These values are part of the binary trace format. */
+    enum class Kind : uint8_t
+    {
+        Int, Long, UInt, ULong, Float, Char, Pointer, String, Object, Elided
+    };
+
+    union Arg
+    {
+        int64_t s;
+        uint64_t u;
+        double f;
+        const void *p;
+        struct
+        {
+            const void *ptr;
+            void (*print)(std::ostream &os, const void *ptr);
+        } obj;
+    };
+
+    Tick when = 0;
+    const char *fmt = nullptr;
+    uint32_t name = 0;
+    uint32_t flag = 0;
+    uint8_t numArgs = 0;
+    Kind kinds[MaxArgs];
+    Arg args[MaxArgs];
+
+    template <typename T>
+    static void
+    printObject(std::ostream &os, const void *ptr)
+    {
+        cp::Format fmt;
+        cp::formatString(os, *static_cast<const T *>(ptr), fmt);
+    }
+
+    template <typename T>
+    void
+    add(const T &arg)
+    {
+        using Char = std::remove_cv_t<
+            std::remove_pointer_t<std::remove_extent_t<T>>>;
+        constexpr bool is_chars = std::is_same_v<Char, char>;
+
+        Kind &kind = kinds[numArgs];
+        Arg &val = args[numArgs++];
+
+        if constexpr (std::is_same_v<T, char>) {
+            kind = Kind::Char;
+            val.s = arg;
+        } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+            kind = sizeof(T) > sizeof(int) ? Kind::Long : Kind::Int;
+            val.s = arg;
+        } else if constexpr (std::is_integral_v<T>) {
+            kind = sizeof(T) > sizeof(unsigned) ? Kind::ULong : Kind::UInt;
+            val.u = arg;
+        } else if constexpr (std::is_floating_point_v<T>) {
+            kind = Kind::Float;
+            val.f = arg;
+        } else if constexpr (std::is_array_v<T> && is_chars) {
+            kind = Kind::String;
+            val.p = arg;
+        } else if constexpr (std::is_pointer_v<T> && is_chars) {
+            kind = Kind::String;
+            val.p = arg ? arg : "";
+        } else if constexpr (std::is_same_v<T, std::string>) {
+            kind = Kind::String;
+            val.p = arg.c_str();
+        } else if constexpr (std::is_pointer_v<T>) {
+            kind = Kind::Pointer;
+            val.p = arg;
+        } else if constexpr (std::is_class_v<T> &&
+                std::is_convertible_v<const T &, uint64_t>) {
+            kind = Kind::ULong;
+            val.u = static_cast<uint64_t>(arg);
+        } else {
+            kind = Kind::Object;
+            val.obj.ptr = &arg;
+            val.obj.print = &printObject<T>;
+        }
+    }
+
+    /** Drop the arguments which are only referred to. */
+    void
+    elide()
+    {
+        for (int i = 0; i < numArgs; i++) {
+            if (kinds[i] == Kind::String || kinds[i] == Kind::Object)
+                kinds[i] = Kind::Elided;
+        }
+    }
+
+    /**
+     * Keep the arguments of a message. Strings and objects are kept by
+     * reference and have to outlive the record, or at least its last use.
+     */
+    template <typename ...Args>
+    void
+    capture(const Args &...args)
+    {
+        static_assert(sizeof...(Args) <= MaxArgs);
+        (add(args), ...);
+    }
+
+    /** Format the message as ccprintf would have with the kept arguments. */
+    void print(std::ostream &os) const;
+};
+
 /** Debug logging base class.  Handles formatting and outputting
  *  time/name/message messages */
 class Logger
@@ -63,6 +190,8 @@ class Logger
     ObjectMatch ignore;
     /** Name match for objects to activate log */
     ObjectMatch activate;
+    /** Hand messages to logRecord unformatted instead of to logMessage */
+    bool recordArgs = false;
 
     bool isEnabled(const std::string &name) const
     {
@@ -96,6 +225,16 @@ class Logger
     {
         if (!isEnabled(name))
             return;
+        if constexpr (sizeof...(Args) <= Record::MaxArgs) {
+            if (recordArgs) {
+                Record record;
+                record.when = when;
+                record.fmt = fmt;
+                record.capture(args...);
+                logRecord(name, flag, record);
+                return;
+            }
+        }
         std::ostringstream line;
         ccprintf(line, fmt, args...);
         logMessage(when, name, flag, line.str());
@@ -109,6 +248,10 @@ class Logger
     virtual void logMessage(Tick when, const std::string &name,
             const std::string &flag, const std::string &message) = 0;
 
+    /** Log an unformatted message, only used if recordArgs is set */
+    virtual void logRecord(const std::string &name, const std::string &flag,
+            Record &record);
+
     /** Return an ostream that can be used to send messages to
      *  the 'same place' as formatted logMessage messages.  This
      *  can be implemented to use a logger's underlying ostream,
@@ -148,6 +291,113 @@ class OstreamLogger : public Logger
     std::ostream &getOstream() override { return stream; }
 };
 
+/**
+ * Logger which only keeps the last messages, unformatted, in a ring of
+ * fixed-size records and formats them when flushed, usually at exit. This
+ * makes tracing a long run cheap enough to leave on when only the events
+ * leading up to the end (or a failure) are of interest. Hex dumps, messages
+ * logged directly and messages with more than Record::MaxArgs arguments are
+ * written through immediately.
+ */
+class RingLogger : public OstreamLogger
+{
+  protected:
+    std::vector<Record> ring;
+    /** Number of records logged since the last flush */
+    uint64_t logged = 0;
+
+    /** Names and flags, records refer to them by index */
+    std::vector<std::string> strings;
+    std::unordered_map<std::string, uint32_t> stringIds;
+
+    /**
+     * Copies of the formats of the records, which may not be literals and
+     * so may be gone by the time the ring is flushed
+     */
+    std::unordered_set<std::string> formats;
+    std::unordered_map<const char *, const std::string *> formatCopies;
+
+    uint32_t intern(const std::string &str);
+    const char *internFormat(const char *fmt);
+
+  public:
+    RingLogger(std::ostream &stream_, size_t capacity);
+
+    void logRecord(const std::string &name, const std::string &flag,
+            Record &record) override;
+
+    /** Write out the records in the ring, oldest first, and empty it. */
+    void flush();
+};
+
+class BufferedWriter;
+
+/**
+ * Logger which writes messages unformatted to a binary stream. Each format
+ * string, object name and flag is written once and then referred to by an
+ * id, so a message only costs its tick, ids and raw arguments. The stream
+ * is written by a separate thread, and util/decode_debug_trace.py turns it
+ * back into the text OstreamLogger would have printed. Like the other
+ * loggers this should only be used from one thread at a time.
+ */
+class BinaryLogger : public Logger
+{
+  protected:
+    std::unique_ptr<BufferedWriter> writer;
+    /** Text written to getOstream(), logged one line at a time */
+    std::unique_ptr<std::ostream> textStream;
+
+    /** Strings by content, and formats by address into those */
+    std::unordered_map<std::string, uint32_t> stringIds;
+    std::unordered_map<const char *,
+        const std::pair<const std::string, uint32_t> *> formatIds;
+    uint32_t numStrings = 0;
+
+    /** Scratch space to put an entry together before writing it */
+    std::vector<char> entry;
+
+    template <typename T>
+    void
+    put(const T &val)
+    {
+        const char *bytes = reinterpret_cast<const char *>(&val);
+        entry.insert(entry.end(), bytes, bytes + sizeof(val));
+    }
+    void putString(const char *str, size_t len);
+
+    uint32_t define(const char *str, size_t len);
+    uint32_t formatId(const char *fmt);
+    uint32_t stringId(const std::string &str);
+    uint8_t formatFlags() const;
+
+  public:
+    static constexpr char Magic[8] = "gem5dbg";
+    static constexpr uint32_t Version = 1;
+
+    /** Entry tags */
+    static constexpr char StringTag = 'S';
+    static constexpr char RecordTag = 'R';
+    static constexpr char MessageTag = 'M';
+
+    /** Bits of an entry's format flags */
+    static constexpr uint8_t TicksOff = 0x1;
+    static constexpr uint8_t ShowFlag = 0x2;
+
+    BinaryLogger(std::ostream &stream, size_t buffer_size=16 << 20);
+    ~BinaryLogger();
+
+    void logRecord(const std::string &name, const std::string &flag,
+            Record &record) override;
+
+    void logMessage(Tick when, const std::string &name,
+            const std::string &flag, const std::string &message) override;
+
+    std::ostream &getOstream() override { return *textStream; }
+
+    /** Write out everything logged so far and stop the writer thread. */
+    void close();
+};
+
 /** Get the current global debug logger.  This takes ownership of the given
  *  logger which should be allocated using 'new' */
 Logger *getDebugLogger();
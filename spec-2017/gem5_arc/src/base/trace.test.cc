@@ -657,3 +657,113 @@ TEST(TraceTest, GlobalName)
     DPRINTF(TraceTestDebugFlag, "Test message");
     ASSERT_EQ(getString(trace::output()), "");
 }
+
+/** A debug message argument which is neither a number nor a string. */
+struct TracePoint
+{
+    int x, y;
+};
+
+std::ostream &
+operator<<(std::ostream &os, const TracePoint &point)
+{
+    return os << "(" << point.x << ", " << point.y << ")";
+}
+
+/** Test that a record prints its arguments as ccprintf would. */
+TEST(TraceTest, RecordPrint)
+{
+    // Strings and objects are kept by reference.
+    const std::string str = "str";
+    const TracePoint point{3, 4};
+
+    trace::Record record;
+    record.fmt = "%d %#x %c %s %.1f %s %p";
+    record.capture(-1, 0x1234567890ULL, 'a', str, 1.5, point, (void *)0x10);
+    ASSERT_EQ(record.numArgs, 7);
+
+    std::stringstream ss;
+    record.print(ss);
+    ASSERT_EQ(ss.str(), "-1 0x1234567890 a str 1.5 (3, 4) 0x10");
+}
+
+/** Test that the ring logger only keeps and prints the last records. */
+TEST(TraceTest, RingLogger)
+{
+    std::stringstream ss;
+    trace::RingLogger logger(ss, 2);
+
+    logger.dprintf_flag(Tick(100), "Foo", "Bar", "Test %d\n", 1);
+    logger.dprintf_flag(Tick(200), "Foo", "Bar", "Test %d\n", 2);
+    logger.dprintf(Tick(300), "Baz", "Test %s %d\n", "elided", 3);
+    ASSERT_EQ(getString(&logger), "");
+
+    logger.flush();
+    ASSERT_EQ(getString(&logger),
+        "1 older debug records were dropped\n"
+        "    200: Foo: Test 2\n"
+        "    300: Baz: Test <?> 3\n");
+
+    logger.flush();
+    ASSERT_EQ(getString(&logger), "");
+}
+
+/** Test that the ring logger keeps formats which are not literals. */
+TEST(TraceTest, RingLoggerFormatCopy)
+{
+    std::stringstream ss;
+    trace::RingLogger logger(ss, 2);
+
+    std::string fmt = "First %d\n";
+    logger.dprintf(Tick(100), "Foo", fmt.c_str(), 1);
+    // Reuse the buffer for another format.
+    fmt[1] = 'o';
+    logger.dprintf(Tick(200), "Foo", fmt.c_str(), 2);
+    fmt = "Gone\n";
+
+    logger.flush();
+    ASSERT_EQ(getString(&logger),
+        "    100: Foo: First 1\n"
+        "    200: Foo: Forst 2\n");
+}
+
+/**
+ * Test that the binary logger writes each format string once, and the
+ * arguments of every message.
+ */
+TEST(TraceTest, BinaryLogger)
+{
+    std::stringstream ss;
+    trace::BinaryLogger logger(ss);
+
+    const char *fmt = "Test format %d %s\n";
+    logger.dprintf_flag(Tick(100), "Foo", "Bar", fmt, 1, "first");
+    logger.dprintf_flag(Tick(200), "Foo", "Bar", fmt, 2, "second");
+    logger.close();
+
+    const std::string trace = ss.str();
+    ASSERT_EQ(trace.compare(0, sizeof(trace::BinaryLogger::Magic),
+        trace::BinaryLogger::Magic, sizeof(trace::BinaryLogger::Magic)), 0);
+    const size_t first = trace.find(fmt);
+    ASSERT_NE(first, std::string::npos);
+    ASSERT_EQ(trace.find(fmt, first + 1), std::string::npos);
+    ASSERT_NE(trace.find("first"), std::string::npos);
+    ASSERT_NE(trace.find("second"), std::string::npos);
+}
+
+/** Test that the binary logger tells apart formats at the same address. */
+TEST(TraceTest, BinaryLoggerFormatReuse)
+{
+    std::stringstream ss;
+    trace::BinaryLogger logger(ss);
+
+    std::string fmt = "First %d\n";
+    logger.dprintf(Tick(100), "Foo", fmt.c_str(), 1);
+    fmt[1] = 'o';
+    logger.dprintf(Tick(200), "Foo", fmt.c_str(), 2);
+    logger.close();
+
+    const std::string trace = ss.str();
+    ASSERT_NE(trace.find("First %d\n"), std::string::npos);
+    ASSERT_NE(trace.find("Forst %d\n"), std::string::npos);
+}
@@ -37,6 +37,7 @@
 # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 from m5.objects.ClockedObject import ClockedObject
+from m5.objects.ReplacementPolicies import LRURP
 from m5.objects.System import System
 from m5.params import *
 from m5.proxy import *
@@ -154,6 +155,17 @@ class SnoopFilter(SimObject):
     # Sanity check on max capacity to track, adjust if needed.
     max_capacity = Param.MemorySize("8MiB", "Maximum capacity of snoop filter")
 
+    # Bound the tracking to a set-associative array of sets * assoc
+    # lines, back-invalidating the lines it evicts. max_capacity is then
+    # not checked.
+    assoc = Param.Unsigned(
+        0, "Associativity of the snoop filter, 0 for unbounded tracking"
+    )
+    sets = Param.Unsigned(1024, "Number of sets of the snoop filter")
+    replacement_policy = Param.BaseReplacementPolicy(
+        LRURP(), "Replacement policy of the snoop filter"
+    )
+
 
 # We use a coherent crossbar to connect multiple requestors to the L2
 # caches. Normally this crossbar would be part of the cache itself.
@@ -1332,8 +1332,13 @@ Cache::recvTimingSnoopReq(PacketPtr pkt)
         // the difference being that instead of querying the block
         // state to determine if it is dirty and writable, we use the
         // command and fields of the writeback packet
+        // a back-invalidation from a snoop filter leaves the dirty data
+        // in the writeback, which takes it below the filter, as nobody
+        // takes a response to it
+        const bool keep_wb = pkt->isBackInvalidation() &&
+            wb_pkt->cmd == MemCmd::WritebackDirty;
         bool respond = wb_pkt->cmd == MemCmd::WritebackDirty &&
-            pkt->needsResponse();
+            pkt->needsResponse() && !keep_wb;
         bool have_writable = !wb_pkt->hasSharers();
         bool invalidate = pkt->isInvalidate();
 
@@ -1354,7 +1359,7 @@ Cache::recvTimingSnoopReq(PacketPtr pkt)
                                    false, false);
         }
 
-        if (invalidate && wb_pkt->cmd != MemCmd::WriteClean) {
+        if (invalidate && wb_pkt->cmd != MemCmd::WriteClean && !keep_wb) {
             // Invalidation trumps our writeback... discard here
             // Note: markInService will remove entry from writeback buffer.
             markInService(wb_entry);
@@ -197,6 +197,30 @@ class Base : public SimObject
     virtual void decompress(const CompressionData* comp_data,
                               uint64_t* cache_line) = 0;
 
+    /**
+     * Calculate the size of the cache line after compression, without
+     * generating the compression data needed to decompress it. The default
+     * implementation applies the complete compression process; compressors
+     * can override it with a faster implementation, as long as it provides
+     * the same sizes, latencies and statistics as compress().
+     *
+     * @param data The cache line to be compressed.
+     * @param comp_lat Compression latency in number of cycles.
+     * @param decomp_lat Decompression latency in number of cycles.
+     * @return The compressed size, in bits, before thresholding.
+     */
+    virtual std::size_t computeSizeBits(const uint64_t* data,
+        Cycles& comp_lat, Cycles& decomp_lat);
+
+    /**
+     * Apply the size threshold to the compressed size of a cache line, and
+     * update the compression stats.
+     *
+     * @param comp_size_bits The compressed size, in bits.
+     * @return The final compressed size, in bits.
+     */
+    std::size_t recordCompression(std::size_t comp_size_bits);
+
   public:
     typedef BaseCacheCompressorParams Params;
     Base(const Params &p);
@@ -217,6 +241,20 @@ class Base : public SimObject
     std::unique_ptr<CompressionData>
     compress(const uint64_t* data, Cycles& comp_lat, Cycles& decomp_lat);
 
+    /**
+     * Apply the compression process to the cache line, but only calculate
+     * its compressed size. This must be preferred over compress() when the
+     * data will not be decompressed, as it may avoid generating the
+     * compressed data.
+     *
+     * @param data The cache line to be compressed.
+     * @param comp_lat Compression latency in number of cycles.
+     * @param decomp_lat Decompression latency in number of cycles.
+     * @return The compressed size, in bits.
+     */
+    std::size_t compressSize(const uint64_t* data, Cycles& comp_lat,
+        Cycles& decomp_lat);
+
     /**
      * Get the decompression latency if the block is compressed. Latency is 0
      * otherwise.
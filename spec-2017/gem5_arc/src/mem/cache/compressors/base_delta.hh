@@ -124,6 +124,18 @@ class BaseDelta : public DictionaryCompressor<BaseType>
         const std::vector<Base::Chunk>& chunks,
         Cycles& comp_lat, Cycles& decomp_lat) override;
 
+    /**
+     * Account for the bases in the compressed size. If there are more bases
+     * than the maximum, the compressor failed.
+     *
+     * @param size_bits Size of the compressed entries, in bits.
+     * @return The compressed size, in bits.
+     */
+    std::size_t addBasesSizeBits(std::size_t size_bits) const;
+
+    std::size_t computeSizeBits(const uint64_t* data, Cycles& comp_lat,
+        Cycles& decomp_lat) override;
+
   public:
     typedef BaseDictionaryCompressorParams Params;
     BaseDelta(const Params &p);
@@ -36,6 +36,7 @@
 #include "debug/CacheComp.hh"
 #include "mem/cache/compressors/base_delta.hh"
 #include "mem/cache/compressors/dictionary_compressor_impl.hh"
+#include "mem/cache/compressors/kernels.hh"
 
 namespace gem5
 {
@@ -77,7 +78,17 @@ BaseDelta<BaseType, DeltaSizeBits>::compress(
 {
     std::unique_ptr<Base::CompressionData> comp_data =
         DictionaryCompressor<BaseType>::compress(chunks, comp_lat, decomp_lat);
+    comp_data->setSizeBits(addBasesSizeBits(comp_data->getSizeBits()));
 
+    // Return compressed line
+    return comp_data;
+}
+
+template <class BaseType, std::size_t DeltaSizeBits>
+std::size_t
+BaseDelta<BaseType, DeltaSizeBits>::addBasesSizeBits(
+    std::size_t size_bits) const
+{
     // If there are more bases than the maximum, the compressor failed.
     // Otherwise, we have to take into account all bases that have not
     // been used, considering that there is an implicit zero base that
@@ -85,16 +96,55 @@ BaseDelta<BaseType, DeltaSizeBits>::compress(
     const int diff = DEFAULT_MAX_NUM_BASES -
         DictionaryCompressor<BaseType>::numEntries;
     if (diff < 0) {
-        comp_data->setSizeBits(DictionaryCompressor<BaseType>::blkSize * 8);
         DPRINTF(CacheComp, "Base%dDelta%d compression failed\n",
             8 * sizeof(BaseType), DeltaSizeBits);
+        return DictionaryCompressor<BaseType>::blkSize * 8;
     } else if (diff > 0) {
-        comp_data->setSizeBits(comp_data->getSizeBits() +
-            8 * sizeof(BaseType) * diff);
+        return size_bits + 8 * sizeof(BaseType) * diff;
     }
+    return size_bits;
+}
 
-    // Return compressed line
-    return comp_data;
+template <class BaseType, std::size_t DeltaSizeBits>
+std::size_t
+BaseDelta<BaseType, DeltaSizeBits>::computeSizeBits(const uint64_t* data,
+    Cycles& comp_lat, Cycles& decomp_lat)
+{
+    BaseType words[kernels::MaxWords];
+    const std::size_t num_words =
+        DictionaryCompressor<BaseType>::toWords(data, words);
+    if (num_words == 0) {
+        return Base::computeSizeBits(data, comp_lat, decomp_lat);
+    }
+
+    resetDictionary();
+
+    // Every word is either a delta of a base, or becomes a new base. The
+    // bases are added in the same order as in the sequential compression
+    const BaseType limit = DeltaSizeBits ? mask(DeltaSizeBits - 1) : 0;
+    const uint64_t bases =
+        kernels::selectBases<BaseType>(words, num_words, limit);
+    for (uint64_t remaining = bases; remaining;
+            remaining &= remaining - 1) {
+        addToDictionary(DictionaryCompressor<BaseType>::toDictionaryEntry(
+            words[findLsbSet(remaining)]));
+    }
+
+    const std::size_t num_bases = popCount(bases);
+    const std::size_t num_deltas = num_words - num_bases;
+    DictionaryCompressor<BaseType>::dictionaryStats.patterns[X] += num_bases;
+    DictionaryCompressor<BaseType>::dictionaryStats.patterns[M] += num_deltas;
+
+    const DictionaryEntry bytes =
+        DictionaryCompressor<BaseType>::toDictionaryEntry(0);
+    const std::size_t size_bits =
+        num_bases * PatternX(bytes, 0).getSizeBits() +
+        num_deltas * PatternM(bytes, 0).getSizeBits();
+
+    DictionaryCompressor<BaseType>::setLatencies(num_words, comp_lat,
+        decomp_lat);
+
+    return addBasesSizeBits(size_bits);
 }
 
 } // namespace compression
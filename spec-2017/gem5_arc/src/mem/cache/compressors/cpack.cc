@@ -33,6 +33,7 @@
 #include "mem/cache/compressors/cpack.hh"
 
 #include "mem/cache/compressors/dictionary_compressor_impl.hh"
+#include "mem/cache/compressors/kernels.hh"
 #include "params/CPack.hh"
 
 namespace gem5
@@ -44,6 +45,13 @@ namespace compression
 CPack::CPack(const Params &p)
     : DictionaryCompressor<uint32_t>(p)
 {
+    const DictionaryEntry bytes = toDictionaryEntry(0);
+    patternSizes[ZZZZ] = PatternZZZZ(bytes, 0).getSizeBits();
+    patternSizes[XXXX] = PatternXXXX(bytes, 0).getSizeBits();
+    patternSizes[MMMM] = PatternMMMM(bytes, 0).getSizeBits();
+    patternSizes[MMXX] = PatternMMXX(bytes, 0).getSizeBits();
+    patternSizes[ZZZX] = PatternZZZX(bytes, 0).getSizeBits();
+    patternSizes[MMMX] = PatternMMMX(bytes, 0).getSizeBits();
 }
 
 void
@@ -53,5 +61,59 @@ CPack::addToDictionary(DictionaryEntry data)
     dictionary[numEntries++] = data;
 }
 
+std::size_t
+CPack::computeSizeBits(const uint64_t* data, Cycles& comp_lat,
+    Cycles& decomp_lat)
+{
+    uint32_t words[kernels::MaxWords];
+    const std::size_t num_words = toWords(data, words);
+    if (num_words == 0) {
+        return Base::computeSizeBits(data, comp_lat, decomp_lat);
+    }
+
+    resetDictionary();
+
+    // Copy of the dictionary in the format used by the kernels
+    uint32_t entries[kernels::MaxWords];
+
+    std::size_t size_bits = 0;
+    for (std::size_t i = 0; i < num_words; i++) {
+        // Same selection as the pattern factory: the patterns are tested in
+        // increasing order of size, so a dictionary match is only used if it
+        // is smaller than the patterns that do not use the dictionary
+        const uint32_t word = words[i];
+        PatternNumber pattern = XXXX;
+        if (word == 0) {
+            pattern = ZZZZ;
+        } else {
+            const unsigned matching_bytes =
+                kernels::matchingBytes(word, entries, numEntries);
+            if (matching_bytes == 4) {
+                pattern = MMMM;
+            } else if ((word & 0xFFFFFF00) == 0) {
+                pattern = ZZZX;
+            } else if (matching_bytes == 3) {
+                pattern = MMMX;
+            } else if (matching_bytes == 2) {
+                pattern = MMXX;
+            }
+        }
+
+        dictionaryStats.patterns[pattern]++;
+        size_bits += patternSizes[pattern];
+
+        // Only the patterns that do not use the dictionary bytes are not
+        // allocated
+        if ((pattern != ZZZZ) && (pattern != ZZZX)) {
+            entries[numEntries] = word;
+            addToDictionary(toDictionaryEntry(word));
+        }
+    }
+
+    setLatencies(num_words, comp_lat, decomp_lat);
+
+    return size_bits;
+}
+
 } // namespace compression
 } // namespace gem5
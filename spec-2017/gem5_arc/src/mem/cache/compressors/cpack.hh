@@ -34,6 +34,7 @@
 #ifndef __MEM_CACHE_COMPRESSORS_CPACK_HH__
 #define __MEM_CACHE_COMPRESSORS_CPACK_HH__
 
+#include <array>
 #include <cstdint>
 #include <map>
 #include <memory>
@@ -103,6 +104,12 @@ class CPack : public DictionaryCompressor<uint32_t>
 
     void addToDictionary(DictionaryEntry data) override;
 
+    /** Size, in bits, of each pattern. */
+    std::array<std::size_t, NUM_PATTERNS> patternSizes;
+
+    std::size_t computeSizeBits(const uint64_t* data, Cycles& comp_lat,
+        Cycles& decomp_lat) override;
+
   public:
     /** Convenience typedef. */
      typedef CPackParams Params;
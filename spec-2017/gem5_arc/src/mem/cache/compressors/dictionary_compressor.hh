@@ -251,6 +251,31 @@ class DictionaryCompressor : public BaseDictionaryCompressor
 
     using BaseDictionaryCompressor::compress;
 
+    /**
+     * Set the latencies based on the degree of parallelization, and any
+     * extra latencies due to shifting or packaging.
+     *
+     * @param num_chunks Number of chunks of the cache line.
+     * @param comp_lat Compression latency in number of cycles.
+     * @param decomp_lat Decompression latency in number of cycles.
+     */
+    void setLatencies(std::size_t num_chunks, Cycles& comp_lat,
+        Cycles& decomp_lat) const;
+
+    /**
+     * Split a cache line into words of a dictionary entry's size, so that
+     * the word-parallel kernels can be used to calculate its compressed
+     * size. This is not possible if the chunks do not match the dictionary
+     * entries, if the line has too many words, or if the compression of
+     * every word must be traced.
+     *
+     * @param data The cache line.
+     * @param words The words of the cache line. It must have room for
+     *        kernels::MaxWords words.
+     * @return The number of words, or 0 if the kernels cannot be used.
+     */
+    std::size_t toWords(const uint64_t* data, T* words) const;
+
     void decompress(const CompressionData* comp_data, uint64_t* data) override;
 
     /**
@@ -34,10 +34,12 @@
 #define __MEM_CACHE_COMPRESSORS_DICTIONARY_COMPRESSOR_IMPL_HH__
 
 #include <algorithm>
+#include <climits>
 
 #include "base/trace.hh"
 #include "debug/CacheComp.hh"
 #include "mem/cache/compressors/dictionary_compressor.hh"
+#include "mem/cache/compressors/kernels.hh"
 #include "params/BaseDictionaryCompressor.hh"
 
 namespace gem5
@@ -153,16 +155,40 @@ std::unique_ptr<Base::CompressionData>
 DictionaryCompressor<T>::compress(const std::vector<Chunk>& chunks,
     Cycles& comp_lat, Cycles& decomp_lat)
 {
-    // Set latencies based on the degree of parallelization, and any extra
-    // latencies due to shifting or packaging
-    comp_lat = Cycles(compExtraLatency +
-        (chunks.size() / compChunksPerCycle));
-    decomp_lat = Cycles(decompExtraLatency +
-        (chunks.size() / decompChunksPerCycle));
+    setLatencies(chunks.size(), comp_lat, decomp_lat);
 
     return compress(chunks);
 }
 
+template <class T>
+void
+DictionaryCompressor<T>::setLatencies(std::size_t num_chunks,
+    Cycles& comp_lat, Cycles& decomp_lat) const
+{
+    comp_lat = Cycles(compExtraLatency + (num_chunks / compChunksPerCycle));
+    decomp_lat =
+        Cycles(decompExtraLatency + (num_chunks / decompChunksPerCycle));
+}
+
+template <class T>
+std::size_t
+DictionaryCompressor<T>::toWords(const uint64_t* data, T* words) const
+{
+    const std::size_t num_words = (blkSize * CHAR_BIT) / chunkSizeBits;
+    if ((chunkSizeBits != (sizeof(T) * CHAR_BIT)) ||
+        (num_words > kernels::MaxWords) || debug::CacheComp) {
+        return 0;
+    }
+
+    // Same layout as toChunks()
+    const std::size_t words_per_64 = sizeof(uint64_t) / sizeof(T);
+    for (std::size_t i = 0; i < num_words; i++) {
+        words[i] = data[i / words_per_64] >>
+            ((i % words_per_64) * chunkSizeBits);
+    }
+    return num_words;
+}
+
 template <class T>
 T
 DictionaryCompressor<T>::decompressValue(const Pattern* pattern)
@@ -29,6 +29,7 @@
 #include "mem/cache/compressors/fpc.hh"
 
 #include "mem/cache/compressors/dictionary_compressor_impl.hh"
+#include "mem/cache/compressors/kernels.hh"
 #include "params/FPC.hh"
 
 namespace gem5
@@ -80,6 +81,33 @@ FPC::FPCCompData::addEntry(std::unique_ptr<Pattern> pattern)
 FPC::FPC(const Params &p)
   : DictionaryCompressor<uint32_t>(p), zeroRunSizeBits(p.zero_run_bits)
 {
+    static_assert((int)kernels::FPC_ZERO == ZERO_RUN &&
+        (int)kernels::FPC_SIGN_EXTENDED_4_BITS == SIGN_EXTENDED_4_BITS &&
+        (int)kernels::FPC_SIGN_EXTENDED_1_BYTE == SIGN_EXTENDED_1_BYTE &&
+        (int)kernels::FPC_SIGN_EXTENDED_HALFWORD == SIGN_EXTENDED_HALFWORD &&
+        (int)kernels::FPC_ZERO_PADDED_HALFWORD == ZERO_PADDED_HALFWORD &&
+        (int)kernels::FPC_SIGN_EXTENDED_TWO_HALFWORDS ==
+            SIGN_EXTENDED_TWO_HALFWORDS &&
+        (int)kernels::FPC_REP_BYTES == REP_BYTES &&
+        (int)kernels::FPC_UNCOMPRESSED == UNCOMPRESSED,
+        "The kernel's classes must match the pattern numbers");
+
+    const DictionaryEntry bytes = toDictionaryEntry(0);
+    ZeroRun zero_run(bytes, -1);
+    zero_run.setRealSize(zeroRunSizeBits);
+    patternSizes[ZERO_RUN] = zero_run.getSizeBits();
+    patternSizes[SIGN_EXTENDED_4_BITS] =
+        SignExtended4Bits(bytes, -1).getSizeBits();
+    patternSizes[SIGN_EXTENDED_1_BYTE] =
+        SignExtended1Byte(bytes, -1).getSizeBits();
+    patternSizes[SIGN_EXTENDED_HALFWORD] =
+        SignExtendedHalfword(bytes, -1).getSizeBits();
+    patternSizes[ZERO_PADDED_HALFWORD] =
+        ZeroPaddedHalfword(bytes, -1).getSizeBits();
+    patternSizes[SIGN_EXTENDED_TWO_HALFWORDS] =
+        SignExtendedTwoHalfwords(bytes, -1).getSizeBits();
+    patternSizes[REP_BYTES] = RepBytes(bytes, -1).getSizeBits();
+    patternSizes[UNCOMPRESSED] = Uncompressed(bytes, -1).getSizeBits();
 }
 
 void
@@ -98,5 +126,47 @@ FPC::instantiateDictionaryCompData() const
         new FPCCompData(zeroRunSizeBits));
 }
 
+std::size_t
+FPC::computeSizeBits(const uint64_t* data, Cycles& comp_lat,
+    Cycles& decomp_lat)
+{
+    uint32_t words[kernels::MaxWords];
+    const std::size_t num_words = toWords(data, words);
+    if (num_words == 0) {
+        return Base::computeSizeBits(data, comp_lat, decomp_lat);
+    }
+
+    // FPC has no dictionary, so all words can be classified at once
+    uint8_t classes[kernels::MaxWords];
+    kernels::classifyFPC(words, num_words, classes);
+
+    std::size_t size_bits = 0;
+    int run_length = -1;
+    for (std::size_t i = 0; i < num_words; i++) {
+        const int pattern = classes[i];
+        dictionaryStats.patterns[pattern]++;
+
+        // Only the first entry of a zero run has a size. A new run is
+        // started when the current one reaches its maximum length, as in
+        // FPCCompData::addEntry()
+        if (pattern == ZERO_RUN) {
+            if ((run_length < 0) ||
+                (run_length == (int)mask(zeroRunSizeBits))) {
+                size_bits += patternSizes[ZERO_RUN];
+                run_length = 0;
+            } else {
+                run_length++;
+            }
+        } else {
+            size_bits += patternSizes[pattern];
+            run_length = -1;
+        }
+    }
+
+    setLatencies(num_words, comp_lat, decomp_lat);
+
+    return size_bits;
+}
+
 } // namespace compression
 } // namespace gem5
@@ -35,6 +35,7 @@
 #ifndef __MEM_CACHE_COMPRESSORS_FPC_HH__
 #define __MEM_CACHE_COMPRESSORS_FPC_HH__
 
+#include <array>
 #include <cstdint>
 #include <map>
 #include <memory>
@@ -128,6 +129,15 @@ class FPC : public DictionaryCompressor<uint32_t>
     std::unique_ptr<DictionaryCompressor::CompData>
     instantiateDictionaryCompData() const override;
 
+    /**
+     * Size, in bits, of each pattern. The size of a zero run is the size
+     * of the entry that starts it.
+     */
+    std::array<std::size_t, NUM_PATTERNS> patternSizes;
+
+    std::size_t computeSizeBits(const uint64_t* data, Cycles& comp_lat,
+        Cycles& decomp_lat) override;
+
   public:
     typedef FPCParams Params;
     FPC(const Params &p);
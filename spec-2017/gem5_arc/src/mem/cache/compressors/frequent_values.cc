@@ -29,6 +29,7 @@
 #include "mem/cache/compressors/frequent_values.hh"
 
 #include <algorithm>
+#include <climits>
 #include <limits>
 
 #include "base/bitfield.hh"
@@ -36,6 +37,7 @@
 #include "base/intmath.hh"
 #include "base/logging.hh"
 #include "debug/CacheComp.hh"
+#include "mem/cache/compressors/kernels.hh"
 #include "params/FrequentValuesCompressor.hh"
 
 namespace gem5
@@ -60,6 +62,47 @@ FrequentValues::FrequentValues(const Params &p)
         "There are more VFT entries than possible values.");
 }
 
+encoder::Code
+FrequentValues::encodeChunk(const Chunk chunk) const
+{
+    encoder::Code code;
+    if (phase == COMPRESSING) {
+        VFTEntry* entry = VFT.findEntry(chunk);
+
+        // Theoretically, the code would be the index of the entry;
+        // however, there is no practical need to do so, and we simply
+        // use the value instead
+        const unsigned uncompressed_index = uncompressedValue;
+        const unsigned index = entry ? chunk : uncompressed_index;
+
+        // If using an index encoder, apply it
+        if (useHuffmanEncoding) {
+            code = indexEncoder.encode(index);
+
+            if (index == uncompressed_index) {
+                code.length += chunkSizeBits;
+            } else if (code.length > 64) {
+                // If, for some reason, we could not generate an encoding
+                // for the value, generate the uncompressed encoding
+                code = indexEncoder.encode(uncompressed_index);
+                assert(code.length <= 64);
+                code.length += chunkSizeBits;
+            }
+        } else {
+            const unsigned code_size = std::log2(numVFTEntries);
+            if (entry) {
+                code = {index, code_size};
+            } else {
+                code = {uncompressed_index, code_size + chunkSizeBits};
+            }
+        }
+    } else {
+        // Not compressing yet; simply copy the value over
+        code = {chunk, chunkSizeBits};
+    }
+    return code;
+}
+
 std::unique_ptr<Base::CompressionData>
 FrequentValues::compress(const std::vector<Chunk>& chunks, Cycles& comp_lat,
     Cycles& decomp_lat)
@@ -73,43 +116,8 @@ FrequentValues::compress(const std::vector<Chunk>& chunks, Cycles& comp_lat,
     // Compress every value sequentially. The compressed values are then
     // added to the final compressed data.
     for (const auto& chunk : chunks) {
-        encoder::Code code;
-        int length = 0;
-        if (phase == COMPRESSING) {
-            VFTEntry* entry = VFT.findEntry(chunk);
-
-            // Theoretically, the code would be the index of the entry;
-            // however, there is no practical need to do so, and we simply
-            // use the value instead
-            const unsigned uncompressed_index = uncompressedValue;
-            const unsigned index = entry ? chunk : uncompressed_index;
-
-            // If using an index encoder, apply it
-            if (useHuffmanEncoding) {
-                code = indexEncoder.encode(index);
-
-                if (index == uncompressed_index) {
-                    code.length += chunkSizeBits;
-                } else if (code.length > 64) {
-                    // If, for some reason, we could not generate an encoding
-                    // for the value, generate the uncompressed encoding
-                    code = indexEncoder.encode(uncompressed_index);
-                    assert(code.length <= 64);
-                    code.length += chunkSizeBits;
-                }
-            } else {
-                const unsigned code_size = std::log2(numVFTEntries);
-                if (entry) {
-                    code = {index, code_size};
-                } else {
-                    code = {uncompressed_index, code_size + chunkSizeBits};
-                }
-            }
-        } else {
-            // Not compressing yet; simply copy the value over
-            code = {chunk, chunkSizeBits};
-        }
-        length += code.length;
+        const encoder::Code code = encodeChunk(chunk);
+        const int length = code.length;
 
         DPRINTF(CacheComp, "Compressed %016x to %016x (Size = %d) "
             "(Phase: %d)\n", chunk, code.code, length, phase);
@@ -133,6 +141,49 @@ FrequentValues::compress(const std::vector<Chunk>& chunks, Cycles& comp_lat,
     return comp_data;
 }
 
+std::size_t
+FrequentValues::computeSizeBits(const uint64_t* data, Cycles& comp_lat,
+    Cycles& decomp_lat)
+{
+    const std::size_t num_chunks = (blkSize * CHAR_BIT) / chunkSizeBits;
+    if ((num_chunks > kernels::MaxWords) || debug::CacheComp) {
+        return Base::computeSizeBits(data, comp_lat, decomp_lat);
+    }
+
+    comp_lat = Cycles(compExtraLatency + (num_chunks / compChunksPerCycle));
+    decomp_lat =
+        Cycles(decompExtraLatency + (num_chunks / decompChunksPerCycle));
+
+    // Not compressing yet; every value is copied over
+    if (phase != COMPRESSING) {
+        return num_chunks * chunkSizeBits;
+    }
+
+    // Same layout as toChunks()
+    Chunk chunks[kernels::MaxWords];
+    const unsigned num_chunks_per_64 =
+        (sizeof(uint64_t) * CHAR_BIT) / chunkSizeBits;
+    for (std::size_t i = 0; i < num_chunks; i++) {
+        const unsigned start = i % num_chunks_per_64;
+        chunks[i] = bits(data[i / num_chunks_per_64],
+            (start + 1) * chunkSizeBits - 1, start * chunkSizeBits);
+    }
+
+    // The encoding of a value only depends on the VFT, so repeated values
+    // of the line, which are common, are only looked up and encoded once
+    std::size_t size = 0;
+    uint64_t pending = mask(num_chunks);
+    while (pending) {
+        const Chunk chunk = chunks[findLsbSet(pending)];
+        const uint64_t same =
+            kernels::equalMask(chunks, num_chunks, chunk) & pending;
+        pending &= ~same;
+        size += popCount(same) * encodeChunk(chunk).length;
+    }
+
+    return size;
+}
+
 void
 FrequentValues::decompress(const CompressionData* comp_data, uint64_t* data)
 {
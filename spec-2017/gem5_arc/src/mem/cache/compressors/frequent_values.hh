@@ -177,6 +177,18 @@ class FrequentValues : public Base
 
     void decompress(const CompressionData* comp_data, uint64_t* data) override;
 
+    /**
+     * Generate the code of a chunk with the current VFT contents.
+     *
+     * @param chunk The chunk to be encoded.
+     * @return The chunk's code, whose length accounts for any uncompressed
+     *         value that has to be appended to it.
+     */
+    encoder::Code encodeChunk(const Chunk chunk) const;
+
+    std::size_t computeSizeBits(const uint64_t* data, Cycles& comp_lat,
+        Cycles& decomp_lat) override;
+
   public:
     typedef FrequentValuesCompressorParams Params;
     FrequentValues(const Params &p);
@@ -0,0 +1,475 @@
+/*
+ * Copyright (c) 2025 Boston University
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "mem/cache/compressors/kernels.hh"
+
+#include <algorithm>
+#include <cassert>
+#include <type_traits>
+
+#include "base/bitfield.hh"
+
+#if GEM5_SIMD_HAVE_AVX2
+#include <immintrin.h>
+#endif
+
+namespace gem5
+{
+
+namespace compression
+{
+
+namespace kernels
+{
+
+namespace
+{
+
+/**
+ * Scalar implementations. These are direct transcriptions of the
+ * isPattern() checks of the pattern classes, and act as the reference
+ * for the vectorized implementations.
+ */
+namespace scalar
+{
+
+uint8_t
+classifyFPC(const uint32_t word)
+{
+    if (word == 0) {
+        return FPC_ZERO;
+    } else if (word == (uint32_t)szext<4>(word)) {
+        return FPC_SIGN_EXTENDED_4_BITS;
+    } else if (word == (uint32_t)szext<8>(word)) {
+        return FPC_SIGN_EXTENDED_1_BYTE;
+    } else if (word == (uint32_t)szext<16>(word)) {
+        return FPC_SIGN_EXTENDED_HALFWORD;
+    } else if ((word & 0x0000FFFF) == 0) {
+        return FPC_ZERO_PADDED_HALFWORD;
+    }
+
+    const int16_t halfwords[2] = {
+        int16_t(word & mask(16)),
+        int16_t((word >> 16) & mask(16))
+    };
+    if ((halfwords[0] == (uint16_t)szext<8>(halfwords[0])) &&
+        (halfwords[1] == (uint16_t)szext<8>(halfwords[1]))) {
+        return FPC_SIGN_EXTENDED_TWO_HALFWORDS;
+    }
+
+    const uint8_t byte = word;
+    if ((uint8_t)(word >> 8) == byte && (uint8_t)(word >> 16) == byte &&
+        (uint8_t)(word >> 24) == byte) {
+        return FPC_REP_BYTES;
+    }
+
+    return FPC_UNCOMPRESSED;
+}
+
+void
+classifyFPC(const uint32_t* words, std::size_t n, uint8_t* classes)
+{
+    for (std::size_t i = 0; i < n; i++) {
+        classes[i] = classifyFPC(words[i]);
+    }
+}
+
+unsigned
+matchingBytes(uint32_t value, const uint32_t* entries, std::size_t n)
+{
+    unsigned best = 0;
+    for (std::size_t i = 0; i < n; i++) {
+        const uint32_t diff = value ^ entries[i];
+        if (diff == 0) {
+            return 4;
+        } else if ((diff & 0xFFFFFF00) == 0) {
+            best = 3;
+        } else if ((diff & 0xFFFF0000) == 0) {
+            best = std::max(best, 2u);
+        }
+    }
+    return best;
+}
+
+template <class T>
+uint64_t
+deltaMask(const T* words, std::size_t n, T base, T limit)
+{
+    using SignedT = std::make_signed_t<T>;
+    const SignedT signed_limit = limit;
+    uint64_t matches = 0;
+    for (std::size_t i = 0; i < n; i++) {
+        const SignedT delta = words[i] - base;
+        if ((delta >= -signed_limit) && (delta <= signed_limit)) {
+            matches |= 1ULL << i;
+        }
+    }
+    return matches;
+}
+
+uint64_t
+equalMask(const uint64_t* words, std::size_t n, uint64_t value)
+{
+    uint64_t matches = 0;
+    for (std::size_t i = 0; i < n; i++) {
+        if (words[i] == value) {
+            matches |= 1ULL << i;
+        }
+    }
+    return matches;
+}
+
+} // namespace scalar
+
+#if GEM5_SIMD_HAVE_AVX2
+namespace avx2
+{
+
+GEM5_SIMD_AVX2 void
+classifyFPC(const uint32_t* words, std::size_t n, uint8_t* classes)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ones = _mm256_set1_epi32(-1);
+    const __m256i low_halfword = _mm256_set1_epi32(0x0000FFFF);
+    // Only halfwords in [0, 127] match the two halfwords pattern, since
+    // its check compares a signed halfword to an unsigned one
+    const __m256i halfword_bytes = _mm256_set1_epi32(0xFF80FF80);
+
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256i w = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(words + i));
+
+        // A word is a sign-extended N-bit value if its bits from N-1
+        // onwards are either all zeros or all ones
+        const __m256i se4 = _mm256_srai_epi32(w, 3);
+        const __m256i se8 = _mm256_srai_epi32(w, 7);
+        const __m256i se16 = _mm256_srai_epi32(w, 15);
+        const __m256i is_zero = _mm256_cmpeq_epi32(w, zero);
+        const __m256i is_se4 = _mm256_or_si256(
+            _mm256_cmpeq_epi32(se4, zero), _mm256_cmpeq_epi32(se4, ones));
+        const __m256i is_se8 = _mm256_or_si256(
+            _mm256_cmpeq_epi32(se8, zero), _mm256_cmpeq_epi32(se8, ones));
+        const __m256i is_se16 = _mm256_or_si256(
+            _mm256_cmpeq_epi32(se16, zero), _mm256_cmpeq_epi32(se16, ones));
+        const __m256i is_zph = _mm256_cmpeq_epi32(
+            _mm256_and_si256(w, low_halfword), zero);
+        const __m256i is_seth = _mm256_cmpeq_epi32(
+            _mm256_and_si256(w, halfword_bytes), zero);
+        const __m256i is_rep = _mm256_cmpeq_epi32(w, _mm256_or_si256(
+            _mm256_srli_epi32(w, 8), _mm256_slli_epi32(w, 24)));
+
+        // Apply the checks from the last to the first pattern, so that
+        // the first matching pattern prevails
+        __m256i cls = _mm256_set1_epi32(FPC_UNCOMPRESSED);
+        cls = _mm256_blendv_epi8(cls, _mm256_set1_epi32(FPC_REP_BYTES),
+            is_rep);
+        cls = _mm256_blendv_epi8(cls,
+            _mm256_set1_epi32(FPC_SIGN_EXTENDED_TWO_HALFWORDS), is_seth);
+        cls = _mm256_blendv_epi8(cls,
+            _mm256_set1_epi32(FPC_ZERO_PADDED_HALFWORD), is_zph);
+        cls = _mm256_blendv_epi8(cls,
+            _mm256_set1_epi32(FPC_SIGN_EXTENDED_HALFWORD), is_se16);
+        cls = _mm256_blendv_epi8(cls,
+            _mm256_set1_epi32(FPC_SIGN_EXTENDED_1_BYTE), is_se8);
+        cls = _mm256_blendv_epi8(cls,
+            _mm256_set1_epi32(FPC_SIGN_EXTENDED_4_BITS), is_se4);
+        cls = _mm256_blendv_epi8(cls, _mm256_set1_epi32(FPC_ZERO), is_zero);
+
+        alignas(32) int32_t results[8];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(results), cls);
+        for (int j = 0; j < 8; j++) {
+            classes[i + j] = results[j];
+        }
+    }
+
+    scalar::classifyFPC(words + i, n - i, classes + i);
+}
+
+GEM5_SIMD_AVX2 unsigned
+matchingBytes(uint32_t value, const uint32_t* entries, std::size_t n)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i v = _mm256_set1_epi32(value);
+    const __m256i three_bytes = _mm256_set1_epi32(0xFFFFFF00);
+    const __m256i two_bytes = _mm256_set1_epi32(0xFFFF0000);
+
+    unsigned best = 0;
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256i diff = _mm256_xor_si256(v, _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(entries + i)));
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(diff, zero))) {
+            return 4;
+        } else if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(
+                _mm256_and_si256(diff, three_bytes), zero))) {
+            best = 3;
+        } else if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(
+                _mm256_and_si256(diff, two_bytes), zero))) {
+            best = std::max(best, 2u);
+        }
+    }
+
+    return std::max(best, scalar::matchingBytes(value, entries + i, n - i));
+}
+
+/*
+ * A signed delta d is within [-limit, limit] iff (d + limit) is not greater
+ * than (2 * limit) when compared as unsigned values. AVX2 only has signed
+ * comparisons, so the unsigned comparison is done by flipping sign bits.
+ */
+
+GEM5_SIMD_AVX2 uint64_t
+deltaMask(const uint64_t* words, std::size_t n, uint64_t base,
+    uint64_t limit)
+{
+    const __m256i sign = _mm256_set1_epi64x(1ULL << 63);
+    const __m256i b = _mm256_set1_epi64x(base);
+    const __m256i l = _mm256_set1_epi64x(limit);
+    const __m256i range = _mm256_xor_si256(
+        _mm256_set1_epi64x(2 * limit), sign);
+
+    uint64_t matches = 0;
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m256i w = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(words + i));
+        const __m256i offset = _mm256_add_epi64(_mm256_sub_epi64(w, b), l);
+        const __m256i out = _mm256_cmpgt_epi64(
+            _mm256_xor_si256(offset, sign), range);
+        const uint64_t out_mask =
+            _mm256_movemask_pd(_mm256_castsi256_pd(out));
+        matches |= (~out_mask & 0xF) << i;
+    }
+
+    if (i < n) {
+        matches |=
+            scalar::deltaMask<uint64_t>(words + i, n - i, base, limit) << i;
+    }
+    return matches;
+}
+
+GEM5_SIMD_AVX2 uint64_t
+deltaMask(const uint32_t* words, std::size_t n, uint32_t base,
+    uint32_t limit)
+{
+    const __m256i sign = _mm256_set1_epi32(0x80000000);
+    const __m256i b = _mm256_set1_epi32(base);
+    const __m256i l = _mm256_set1_epi32(limit);
+    const __m256i range = _mm256_xor_si256(
+        _mm256_set1_epi32(2 * limit), sign);
+
+    uint64_t matches = 0;
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256i w = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(words + i));
+        const __m256i offset = _mm256_add_epi32(_mm256_sub_epi32(w, b), l);
+        const __m256i out = _mm256_cmpgt_epi32(
+            _mm256_xor_si256(offset, sign), range);
+        const uint64_t out_mask =
+            _mm256_movemask_ps(_mm256_castsi256_ps(out));
+        matches |= (~out_mask & 0xFF) << i;
+    }
+
+    if (i < n) {
+        matches |=
+            scalar::deltaMask<uint32_t>(words + i, n - i, base, limit) << i;
+    }
+    return matches;
+}
+
+GEM5_SIMD_AVX2 uint64_t
+deltaMask(const uint16_t* words, std::size_t n, uint16_t base,
+    uint16_t limit)
+{
+    const __m256i sign = _mm256_set1_epi16(0x8000);
+    const __m256i b = _mm256_set1_epi16(base);
+    const __m256i l = _mm256_set1_epi16(limit);
+    const __m256i range = _mm256_xor_si256(
+        _mm256_set1_epi16(2 * limit), sign);
+
+    uint64_t matches = 0;
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m256i w = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(words + i));
+        const __m256i offset = _mm256_add_epi16(_mm256_sub_epi16(w, b), l);
+        const __m256i out = _mm256_cmpgt_epi16(
+            _mm256_xor_si256(offset, sign), range);
+
+        // Narrow each 16-bit result to a byte. The pack works within each
+        // 128-bit lane, so the results of the upper lane end up in bits
+        // [23:16] of the byte mask
+        const uint32_t byte_mask = _mm256_movemask_epi8(
+            _mm256_packs_epi16(out, _mm256_setzero_si256()));
+        const uint64_t out_mask =
+            (byte_mask & 0xFF) | ((byte_mask >> 8) & 0xFF00);
+        matches |= (~out_mask & 0xFFFF) << i;
+    }
+
+    if (i < n) {
+        matches |=
+            scalar::deltaMask<uint16_t>(words + i, n - i, base, limit) << i;
+    }
+    return matches;
+}
+
+GEM5_SIMD_AVX2 uint64_t
+equalMask(const uint64_t* words, std::size_t n, uint64_t value)
+{
+    const __m256i v = _mm256_set1_epi64x(value);
+
+    uint64_t matches = 0;
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m256i eq = _mm256_cmpeq_epi64(v, _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(words + i)));
+        const uint64_t eq_mask = _mm256_movemask_pd(_mm256_castsi256_pd(eq));
+        matches |= eq_mask << i;
+    }
+
+    if (i < n) {
+        matches |= scalar::equalMask(words + i, n - i, value) << i;
+    }
+    return matches;
+}
+
+} // namespace avx2
+#endif // GEM5_SIMD_HAVE_AVX2
+
+} // anonymous namespace
+
+void
+classifyFPC(const uint32_t* words, std::size_t n, uint8_t* classes, Isa isa)
+{
+    assert(n <= MaxWords);
+#if GEM5_SIMD_HAVE_AVX2
+    if (isa == Isa::AVX2) {
+        avx2::classifyFPC(words, n, classes);
+        return;
+    }
+#endif
+    scalar::classifyFPC(words, n, classes);
+}
+
+unsigned
+matchingBytes(uint32_t value, const uint32_t* entries, std::size_t n,
+    Isa isa)
+{
+#if GEM5_SIMD_HAVE_AVX2
+    if (isa == Isa::AVX2) {
+        return avx2::matchingBytes(value, entries, n);
+    }
+#endif
+    return scalar::matchingBytes(value, entries, n);
+}
+
+uint64_t
+deltaMask(const uint64_t* words, std::size_t n, uint64_t base,
+    uint64_t limit, Isa isa)
+{
+    assert(n <= MaxWords);
+#if GEM5_SIMD_HAVE_AVX2
+    if (isa == Isa::AVX2) {
+        return avx2::deltaMask(words, n, base, limit);
+    }
+#endif
+    return scalar::deltaMask<uint64_t>(words, n, base, limit);
+}
+
+uint64_t
+deltaMask(const uint32_t* words, std::size_t n, uint32_t base,
+    uint32_t limit, Isa isa)
+{
+    assert(n <= MaxWords);
+#if GEM5_SIMD_HAVE_AVX2
+    if (isa == Isa::AVX2) {
+        return avx2::deltaMask(words, n, base, limit);
+    }
+#endif
+    return scalar::deltaMask<uint32_t>(words, n, base, limit);
+}
+
+uint64_t
+deltaMask(const uint16_t* words, std::size_t n, uint16_t base,
+    uint16_t limit, Isa isa)
+{
+    assert(n <= MaxWords);
+#if GEM5_SIMD_HAVE_AVX2
+    if (isa == Isa::AVX2) {
+        return avx2::deltaMask(words, n, base, limit);
+    }
+#endif
+    return scalar::deltaMask<uint16_t>(words, n, base, limit);
+}
+
+template <class T>
+uint64_t
+selectBases(const T* words, std::size_t n, T limit, Isa isa)
+{
+    assert(n <= MaxWords);
+    const uint64_t all_words = mask(n);
+
+    // Every word chosen as a base is the first word that could not be
+    // represented by any of the previous bases, so the words in-between
+    // have all been checked against the same set of bases as they would
+    // when parsed sequentially
+    uint64_t covered = deltaMask(words, n, T(0), limit, isa);
+    uint64_t bases = 0;
+    while (const uint64_t uncovered = all_words & ~covered) {
+        const int index = findLsbSet(uncovered);
+        bases |= 1ULL << index;
+        covered |= deltaMask(words, n, words[index], limit, isa);
+    }
+    return bases;
+}
+
+template uint64_t selectBases<uint64_t>(const uint64_t*, std::size_t,
+    uint64_t, Isa);
+template uint64_t selectBases<uint32_t>(const uint32_t*, std::size_t,
+    uint32_t, Isa);
+template uint64_t selectBases<uint16_t>(const uint16_t*, std::size_t,
+    uint16_t, Isa);
+
+uint64_t
+equalMask(const uint64_t* words, std::size_t n, uint64_t value, Isa isa)
+{
+    assert(n <= MaxWords);
+#if GEM5_SIMD_HAVE_AVX2
+    if (isa == Isa::AVX2) {
+        return avx2::equalMask(words, n, value);
+    }
+#endif
+    return scalar::equalMask(words, n, value);
+}
+
+} // namespace kernels
+} // namespace compression
+} // namespace gem5
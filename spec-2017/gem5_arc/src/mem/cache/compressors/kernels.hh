@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2025 Boston University
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** @file
+ * Word-parallel kernels used by the compressors to compute the compressed
+ * size of a block without instantiating the pattern objects needed for
+ * decompression. Each kernel has a scalar implementation and, on x86 hosts
+ * whose CPU supports it, an AVX2 implementation selected at run time. Both
+ * implementations produce bit-identical results.
+ */
+
+#ifndef __MEM_CACHE_COMPRESSORS_KERNELS_HH__
+#define __MEM_CACHE_COMPRESSORS_KERNELS_HH__
+
+#include <cstddef>
+#include <cstdint>
+
+#include "base/simd.hh"
+
+namespace gem5
+{
+
+namespace compression
+{
+
+namespace kernels
+{
+
+/**
+ * Maximum number of words of a block processed by the kernels. Masks of
+ * matching words are returned as 64-bit values, so blocks with more words
+ * than this must be handled by the generic compression path.
+ */
+constexpr std::size_t MaxWords = 64;
+
+using simd::Isa;
+using simd::isSupported;
+using simd::bestIsa;
+
+/**
+ * Classes a 32-bit word can be encoded as by FPC. They are sorted in the
+ * order the FPC pattern factory tests them, and each word is assigned the
+ * first class it matches.
+ */
+enum FPCClass : uint8_t
+{
+    FPC_ZERO,
+    FPC_SIGN_EXTENDED_4_BITS,
+    FPC_SIGN_EXTENDED_1_BYTE,
+    FPC_SIGN_EXTENDED_HALFWORD,
+    FPC_ZERO_PADDED_HALFWORD,
+    FPC_SIGN_EXTENDED_TWO_HALFWORDS,
+    FPC_REP_BYTES,
+    FPC_UNCOMPRESSED,
+    NUM_FPC_CLASSES
+};
+
+/**
+ * Classify the words of a block according to the FPC patterns.
+ *
+ * @param words The words of the block.
+ * @param n Number of words; must not be greater than MaxWords.
+ * @param classes Output class of each word.
+ * @param isa Instruction set to use.
+ */
+void classifyFPC(const uint32_t* words, std::size_t n, uint8_t* classes,
+    Isa isa = bestIsa());
+
+/**
+ * Find how many of the most significant bytes of a value match the most
+ * similar dictionary entry. This is the search done by CPack for its
+ * MMMM, MMMX and MMXX patterns.
+ *
+ * @param value The value being searched for.
+ * @param entries The dictionary entries.
+ * @param n Number of valid dictionary entries.
+ * @param isa Instruction set to use.
+ * @return The number of matching bytes (0 to 4) of the best match.
+ */
+unsigned matchingBytes(uint32_t value, const uint32_t* entries,
+    std::size_t n, Isa isa = bestIsa());
+
+/**
+ * Find the words of a block that can be represented as a signed delta of
+ * at most limit from a base, using modular arithmetic of the words' width.
+ *
+ * @param words The words of the block.
+ * @param n Number of words; must not be greater than MaxWords.
+ * @param base The base.
+ * @param limit Largest absolute value of the delta.
+ * @param isa Instruction set to use.
+ * @return A mask where bit i is set if the i-th word is within the range.
+ */
+uint64_t deltaMask(const uint64_t* words, std::size_t n, uint64_t base,
+    uint64_t limit, Isa isa = bestIsa());
+uint64_t deltaMask(const uint32_t* words, std::size_t n, uint32_t base,
+    uint32_t limit, Isa isa = bestIsa());
+uint64_t deltaMask(const uint16_t* words, std::size_t n, uint16_t base,
+    uint16_t limit, Isa isa = bestIsa());
+
+/**
+ * Select the bases of a base-delta encoding of a block. Words are parsed
+ * sequentially, and every word that cannot be represented as a delta of
+ * the implicit zero base nor of any of the previously selected bases
+ * becomes a new base.
+ *
+ * @param words The words of the block.
+ * @param n Number of words; must not be greater than MaxWords.
+ * @param limit Largest absolute value of a delta.
+ * @param isa Instruction set to use.
+ * @return A mask where bit i is set if the i-th word is a new base.
+ */
+template <class T>
+uint64_t selectBases(const T* words, std::size_t n, T limit,
+    Isa isa = bestIsa());
+
+/**
+ * Find the words of a block that are equal to a value.
+ *
+ * @param words The words of the block.
+ * @param n Number of words; must not be greater than MaxWords.
+ * @param value The value being searched for.
+ * @param isa Instruction set to use.
+ * @return A mask where bit i is set if the i-th word is equal to value.
+ */
+uint64_t equalMask(const uint64_t* words, std::size_t n, uint64_t value,
+    Isa isa = bestIsa());
+
+} // namespace kernels
+} // namespace compression
+} // namespace gem5
+
+#endif //__MEM_CACHE_COMPRESSORS_KERNELS_HH__
@@ -0,0 +1,255 @@
+/*
+ * Copyright (c) 2025 Boston University
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include "base/bitfield.hh"
+#include "mem/cache/compressors/kernels.hh"
+
+using namespace gem5;
+using namespace gem5::compression;
+
+namespace
+{
+
+/** Instruction sets to be checked, restricted to the ones the host has. */
+std::vector<kernels::Isa>
+supportedIsas()
+{
+    std::vector<kernels::Isa> isas;
+    for (auto isa : {kernels::Isa::Scalar, kernels::Isa::AVX2}) {
+        if (kernels::isSupported(isa)) {
+            isas.push_back(isa);
+        }
+    }
+    return isas;
+}
+
+/** Values that are at the boundaries of the patterns. */
+const std::vector<uint32_t> edgeValues = {
+    0x00000000, 0x00000001, 0x00000007, 0x00000008, 0xFFFFFFF8, 0xFFFFFFF7,
+    0x0000007F, 0x00000080, 0xFFFFFF80, 0xFFFFFF7F, 0x00007FFF, 0x00008000,
+    0xFFFF8000, 0xFFFF7FFF, 0x00010000, 0xFFFF0000, 0x007F007F, 0x00800080,
+    0x007F0080, 0x0000007F, 0x7F7F7F7F, 0x80808080, 0xFFFFFFFF, 0x12345678,
+    0x00010001, 0xFF7FFF7F, 0x7FFFFFFF, 0x80000000, 0x01010101, 0x00FF00FF,
+};
+
+/**
+ * Generate a block whose words have a mix of the properties the
+ * compressors look for: zeros, small values, repeated values and values
+ * close to each other.
+ */
+template <class T>
+std::vector<T>
+randomBlock(std::mt19937_64 &rng, std::size_t n)
+{
+    std::vector<T> words(n);
+    const T base = rng();
+    for (auto &word : words) {
+        switch (rng() % 6) {
+          case 0: word = 0; break;
+          case 1: word = rng() % 256; break;
+          case 2: word = -T(rng() % 256); break;
+          case 3: word = base + (rng() % 1024) - 512; break;
+          case 4: word = T(0x0101010101010101ULL * (rng() % 256)); break;
+          default: word = rng(); break;
+        }
+    }
+    return words;
+}
+
+/** Transcription of the checks of the FPC patterns, in factory order. */
+uint8_t
+referenceFPC(uint32_t word)
+{
+    const int16_t halfwords[2] = {
+        int16_t(word & mask(16)),
+        int16_t((word >> 16) & mask(16))
+    };
+    const uint8_t bytes[4] = {uint8_t(word), uint8_t(word >> 8),
+        uint8_t(word >> 16), uint8_t(word >> 24)};
+
+    if (word == 0) {
+        return kernels::FPC_ZERO;
+    } else if (word == (uint32_t)szext<4>(word)) {
+        return kernels::FPC_SIGN_EXTENDED_4_BITS;
+    } else if (word == (uint32_t)szext<8>(word)) {
+        return kernels::FPC_SIGN_EXTENDED_1_BYTE;
+    } else if (word == (uint32_t)szext<16>(word)) {
+        return kernels::FPC_SIGN_EXTENDED_HALFWORD;
+    } else if ((word & 0x0000FFFF) == 0) {
+        return kernels::FPC_ZERO_PADDED_HALFWORD;
+    } else if ((halfwords[0] == (uint16_t)szext<8>(halfwords[0])) &&
+               (halfwords[1] == (uint16_t)szext<8>(halfwords[1]))) {
+        return kernels::FPC_SIGN_EXTENDED_TWO_HALFWORDS;
+    } else if ((bytes[0] == bytes[1]) && (bytes[0] == bytes[2]) &&
+               (bytes[0] == bytes[3])) {
+        return kernels::FPC_REP_BYTES;
+    }
+    return kernels::FPC_UNCOMPRESSED;
+}
+
+/** Transcription of the CPack dictionary search with masked patterns. */
+unsigned
+referenceMatchingBytes(uint32_t value, const std::vector<uint32_t> &entries)
+{
+    unsigned best = 0;
+    for (const auto entry : entries) {
+        for (unsigned bytes = 4; bytes > best; bytes--) {
+            const uint32_t mask = ~uint32_t(0) << (8 * (4 - bytes));
+            if ((value & mask) == (entry & mask)) {
+                best = bytes;
+                break;
+            }
+        }
+    }
+    return (best < 2) ? 0 : best;
+}
+
+/** Sequential base selection, as done by the BDI compressors. */
+template <class T>
+uint64_t
+referenceBases(const std::vector<T> &words, T limit)
+{
+    using SignedT = std::make_signed_t<T>;
+    std::vector<T> bases = {0};
+    uint64_t new_bases = 0;
+    for (std::size_t i = 0; i < words.size(); i++) {
+        bool found = false;
+        for (const auto base : bases) {
+            const SignedT delta = words[i] - base;
+            if ((delta >= -SignedT(limit)) && (delta <= SignedT(limit))) {
+                found = true;
+                break;
+            }
+        }
+        if (!found) {
+            bases.push_back(words[i]);
+            new_bases |= 1ULL << i;
+        }
+    }
+    return new_bases;
+}
+
+template <class T>
+void
+checkBases(std::mt19937_64 &rng, unsigned delta_bits)
+{
+    const T limit = mask(delta_bits - 1);
+    for (int iter = 0; iter < 2000; iter++) {
+        const std::size_t n = 1 + rng() % kernels::MaxWords;
+        const auto words = randomBlock<T>(rng, n);
+        const uint64_t expected = referenceBases<T>(words, limit);
+        for (auto isa : supportedIsas()) {
+            ASSERT_EQ(kernels::selectBases<T>(words.data(), n, limit, isa),
+                expected);
+        }
+    }
+}
+
+} // anonymous namespace
+
+/** The FPC classes must match the patterns' checks. */
+TEST(CompressionKernelsTest, ClassifyFPC)
+{
+    std::vector<uint32_t> words = edgeValues;
+    std::mt19937_64 rng(1);
+    for (int i = 0; i < 1 << 16; i++) {
+        // Random values with a random number of significant bits
+        words.push_back(uint32_t(rng()) >> (rng() % 32));
+        words.push_back(-(uint32_t(rng()) >> (rng() % 32)));
+    }
+    for (std::size_t i = 0; i < words.size(); i += 64) {
+        const std::size_t n = std::min<std::size_t>(
+            1 + rng() % kernels::MaxWords, words.size() - i);
+        for (auto isa : supportedIsas()) {
+            uint8_t classes[kernels::MaxWords];
+            kernels::classifyFPC(&words[i], n, classes, isa);
+            for (std::size_t j = 0; j < n; j++) {
+                ASSERT_EQ(classes[j], referenceFPC(words[i + j]))
+                    << std::hex << words[i + j];
+            }
+        }
+    }
+}
+
+/** The best CPack dictionary match must match the masked patterns' one. */
+TEST(CompressionKernelsTest, MatchingBytes)
+{
+    std::mt19937_64 rng(2);
+    for (int iter = 0; iter < 20000; iter++) {
+        std::vector<uint32_t> entries(rng() % (kernels::MaxWords + 1));
+        const uint32_t value = rng();
+        for (auto &entry : entries) {
+            // Entries share a random number of bytes with the value
+            entry = (value & (~uint32_t(0) << (8 * (rng() % 4)))) |
+                (uint32_t(rng()) >> (8 * (rng() % 4 + 1)));
+        }
+        const unsigned expected = referenceMatchingBytes(value, entries);
+        for (auto isa : supportedIsas()) {
+            ASSERT_EQ(kernels::matchingBytes(value, entries.data(),
+                entries.size(), isa), expected);
+        }
+    }
+}
+
+/** The BDI bases must be the same as when parsed sequentially. */
+TEST(CompressionKernelsTest, SelectBases)
+{
+    std::mt19937_64 rng(3);
+    checkBases<uint64_t>(rng, 8);
+    checkBases<uint64_t>(rng, 16);
+    checkBases<uint64_t>(rng, 32);
+    checkBases<uint32_t>(rng, 8);
+    checkBases<uint32_t>(rng, 16);
+    checkBases<uint16_t>(rng, 8);
+}
+
+/** Check the equality mask. */
+TEST(CompressionKernelsTest, EqualMask)
+{
+    std::mt19937_64 rng(4);
+    for (int iter = 0; iter < 2000; iter++) {
+        const std::size_t n = 1 + rng() % kernels::MaxWords;
+        const auto words = randomBlock<uint64_t>(rng, n);
+        const uint64_t value = words[rng() % n];
+        uint64_t expected = 0;
+        for (std::size_t i = 0; i < n; i++) {
+            expected |= uint64_t(words[i] == value) << i;
+        }
+        for (auto isa : supportedIsas()) {
+            ASSERT_EQ(kernels::equalMask(words.data(), n, value, isa),
+                expected);
+        }
+    }
+}
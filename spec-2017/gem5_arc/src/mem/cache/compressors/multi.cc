@@ -33,6 +33,7 @@
 
 #include "mem/cache/compressors/multi.hh"
 
+#include <climits>
 #include <cmath>
 #include <queue>
 
@@ -86,24 +87,26 @@ Multi::setCache(BaseCache *_cache)
     }
 }
 
-std::unique_ptr<Base::CompressionData>
-Multi::compress(const std::vector<Chunk>& chunks, Cycles& comp_lat,
-    Cycles& decomp_lat)
+unsigned
+Multi::selectCompressor(const uint64_t* data, bool size_only,
+    std::unique_ptr<CompressionData>& comp_data, std::size_t& size_bits,
+    Cycles& comp_lat, Cycles& decomp_lat)
 {
     struct Results
     {
         unsigned index;
         std::unique_ptr<Base::CompressionData> compData;
+        std::size_t sizeBits;
         Cycles decompLat;
         uint8_t compressionFactor;
 
         Results(unsigned index,
             std::unique_ptr<Base::CompressionData> comp_data,
-            Cycles decomp_lat, std::size_t blk_size)
+            std::size_t size_bits, Cycles decomp_lat, std::size_t blk_size)
             : index(index), compData(std::move(comp_data)),
-              decompLat(decomp_lat)
+              sizeBits(size_bits), decompLat(decomp_lat)
         {
-            const std::size_t size = compData->getSize();
+            const std::size_t size = std::ceil(sizeBits / (float)CHAR_BIT);
             // If the compressed size is worse than the uncompressed size,
             // we assume the size is the uncompressed size, and thus the
             // compression factor is 1.
@@ -136,32 +139,33 @@ Multi::compress(const std::vector<Chunk>& chunks, Cycles& comp_lat,
         }
     };
 
-    // Each sub-compressor can have its own chunk size; therefore, revert
-    // the chunks to raw data, so that they handle the conversion internally
-    uint64_t data[blkSize / sizeof(uint64_t)];
-    std::memset(data, 0, blkSize);
-    fromChunks(chunks, data);
-
-    // Find the ranking of the compressor outputs
+    // Find the ranking of the compressor outputs. When only the sizes are
+    // needed, the sub-compressors can skip generating their compressed data
     std::priority_queue<std::shared_ptr<Results>,
         std::vector<std::shared_ptr<Results>>, ResultsComparator> results;
     Cycles max_comp_lat;
     for (unsigned i = 0; i < compressors.size(); i++) {
         Cycles temp_decomp_lat;
-        auto temp_comp_data =
-            compressors[i]->compress(data, comp_lat, temp_decomp_lat);
-        temp_comp_data->setSizeBits(temp_comp_data->getSizeBits() +
-            numEncodingBits);
+        std::unique_ptr<CompressionData> temp_comp_data;
+        std::size_t temp_size_bits;
+        if (size_only) {
+            temp_size_bits = compressors[i]->compressSize(data, comp_lat,
+                temp_decomp_lat) + numEncodingBits;
+        } else {
+            temp_comp_data =
+                compressors[i]->compress(data, comp_lat, temp_decomp_lat);
+            temp_size_bits = temp_comp_data->getSizeBits() + numEncodingBits;
+            temp_comp_data->setSizeBits(temp_size_bits);
+        }
         results.push(std::make_shared<Results>(i, std::move(temp_comp_data),
-            temp_decomp_lat, blkSize));
+            temp_size_bits, temp_decomp_lat, blkSize));
         max_comp_lat = std::max(max_comp_lat, comp_lat);
     }
 
     // Assign best compressor to compression data
     const unsigned best_index = results.top()->index;
-    std::unique_ptr<CompressionData> multi_comp_data =
-        std::unique_ptr<MultiCompData>(
-            new MultiCompData(best_index, std::move(results.top()->compData)));
+    comp_data = std::move(results.top()->compData);
+    size_bits = results.top()->sizeBits;
     DPRINTF(CacheComp, "Best compressor: %d\n", best_index);
 
     // Set decompression latency of the best compressor
@@ -177,7 +181,37 @@ Multi::compress(const std::vector<Chunk>& chunks, Cycles& comp_lat,
     // and 1 cycle to pack)
     comp_lat = Cycles(max_comp_lat + compExtraLatency);
 
-    return multi_comp_data;
+    return best_index;
+}
+
+std::unique_ptr<Base::CompressionData>
+Multi::compress(const std::vector<Chunk>& chunks, Cycles& comp_lat,
+    Cycles& decomp_lat)
+{
+    // Each sub-compressor can have its own chunk size; therefore, revert
+    // the chunks to raw data, so that they handle the conversion internally
+    uint64_t data[blkSize / sizeof(uint64_t)];
+    std::memset(data, 0, blkSize);
+    fromChunks(chunks, data);
+
+    std::unique_ptr<CompressionData> best_comp_data;
+    std::size_t size_bits;
+    const unsigned best_index = selectCompressor(data, false, best_comp_data,
+        size_bits, comp_lat, decomp_lat);
+
+    return std::unique_ptr<MultiCompData>(
+        new MultiCompData(best_index, std::move(best_comp_data)));
+}
+
+std::size_t
+Multi::computeSizeBits(const uint64_t* data, Cycles& comp_lat,
+    Cycles& decomp_lat)
+{
+    std::unique_ptr<CompressionData> best_comp_data;
+    std::size_t size_bits;
+    selectCompressor(data, true, best_comp_data, size_bits, comp_lat,
+        decomp_lat);
+    return size_bits;
 }
 
 void
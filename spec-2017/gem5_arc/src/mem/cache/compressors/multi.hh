@@ -100,6 +100,26 @@ class Multi : public Base
         statistics::Vector2d ranks;
     } multiStats;
 
+    /**
+     * Apply every sub-compressor to the data, and select the one that
+     * provides the best compression. The ranking stats are updated.
+     *
+     * @param data The cache line to be compressed.
+     * @param size_only Whether only the compressed sizes are needed, in
+     *        which case the compressed data is not generated.
+     * @param comp_data Compressed data of the best sub-compressor.
+     * @param size_bits Compressed size of the best sub-compressor, in bits.
+     * @param comp_lat Compression latency in number of cycles.
+     * @param decomp_lat Decompression latency in number of cycles.
+     * @return The index of the best sub-compressor.
+     */
+    unsigned selectCompressor(const uint64_t* data, bool size_only,
+        std::unique_ptr<CompressionData>& comp_data, std::size_t& size_bits,
+        Cycles& comp_lat, Cycles& decomp_lat);
+
+    std::size_t computeSizeBits(const uint64_t* data, Cycles& comp_lat,
+        Cycles& decomp_lat) override;
+
   public:
     typedef MultiCompressorParams Params;
     Multi(const Params &p);
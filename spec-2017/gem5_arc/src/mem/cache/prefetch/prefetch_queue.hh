@@ -0,0 +1,457 @@
+/*
+ * Copyright (c) 2025 Boston University
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef __MEM_CACHE_PREFETCH_PREFETCH_QUEUE_HH__
+#define __MEM_CACHE_PREFETCH_PREFETCH_QUEUE_HH__
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "base/logging.hh"
+#include "base/types.hh"
+
+namespace gem5
+{
+
+namespace prefetch
+{
+
+/**
+ * A bounded queue of prefetch requests, ordered by decreasing priority and
+ * by age within a priority.
+ *
+ * Entries are constructed in place in a pool that is allocated once, and
+ * never move while they are queued, so a reference to an entry is valid
+ * until the entry is removed. The entries of each priority are chained
+ * together, and the priorities in use are kept in a sorted vector: with P
+ * distinct priorities queued (a handful in practice), inserting an entry
+ * costs O(log P), and removing any entry is O(1) unless it empties its
+ * priority.
+ *
+ * Each entry is also registered in a hash index under a key, typically its
+ * block address, so the entries that may match an address are found
+ * without walking the queue. Several entries may share a key; lookups take
+ * a predicate to select among them.
+ *
+ * @tparam T Entry type. It must have an int32_t priority member, which is
+ *         read when the entry is inserted and by reprioritize().
+ */
+template <typename T>
+class PrefetchQueue
+{
+  private:
+    using Index = uint32_t;
+    static constexpr Index Invalid = std::numeric_limits<Index>::max();
+
+    struct Node
+    {
+        /** Older and newer entries of the same priority */
+        Index prev = Invalid;
+        Index next = Invalid;
+        /** Other entries with the same key */
+        Index keyPrev = Invalid;
+        Index keyNext = Invalid;
+        /** Priority the entry is currently queued with */
+        int32_t priority = 0;
+        Addr key = 0;
+        bool valid = false;
+    };
+
+    struct Level
+    {
+        int32_t priority;
+        /** Oldest and newest entries with this priority */
+        Index head;
+        Index tail;
+    };
+
+    /** Raw storage for one entry */
+    struct alignas(T) Slot
+    {
+        std::byte data[sizeof(T)];
+    };
+
+    const Index _capacity;
+    Index _size = 0;
+
+    std::unique_ptr<Slot[]> slots;
+    std::vector<Node> nodes;
+    std::vector<Index> freeList;
+
+    /** Priorities in use, sorted by increasing priority */
+    std::vector<Level> levels;
+
+    /** Newest entry registered under each key */
+    std::unordered_map<Addr, Index> keyIndex;
+
+    T &
+    entry(Index i)
+    {
+        return *std::launder(reinterpret_cast<T *>(&slots[i]));
+    }
+
+    const T &
+    entry(Index i) const
+    {
+        return *std::launder(reinterpret_cast<const T *>(&slots[i]));
+    }
+
+    Index
+    indexOf(const T &e) const
+    {
+        const Index i = reinterpret_cast<const Slot *>(&e) - slots.get();
+        assert(i < _capacity && nodes[i].valid);
+        return i;
+    }
+
+    typename std::vector<Level>::iterator
+    findLevel(int32_t priority)
+    {
+        return std::lower_bound(levels.begin(), levels.end(), priority,
+            [](const Level &level, int32_t p) { return level.priority < p; });
+    }
+
+    /** Append an entry to the entries of its priority */
+    void
+    linkLevel(Index i)
+    {
+        Node &node = nodes[i];
+        node.next = Invalid;
+        auto level = findLevel(node.priority);
+        if (level == levels.end() || level->priority != node.priority) {
+            node.prev = Invalid;
+            levels.insert(level, Level{node.priority, i, i});
+        } else {
+            node.prev = level->tail;
+            nodes[level->tail].next = i;
+            level->tail = i;
+        }
+    }
+
+    void
+    unlinkLevel(Index i)
+    {
+        const Node &node = nodes[i];
+        auto level = findLevel(node.priority);
+        assert(level != levels.end() && level->priority == node.priority);
+        if (node.prev != Invalid) {
+            nodes[node.prev].next = node.next;
+        } else {
+            level->head = node.next;
+        }
+        if (node.next != Invalid) {
+            nodes[node.next].prev = node.prev;
+        } else {
+            level->tail = node.prev;
+        }
+        if (level->head == Invalid) {
+            levels.erase(level);
+        }
+    }
+
+    void
+    linkKey(Index i, Addr key)
+    {
+        Node &node = nodes[i];
+        node.key = key;
+        node.keyPrev = Invalid;
+        auto [it, inserted] = keyIndex.try_emplace(key, i);
+        if (inserted) {
+            node.keyNext = Invalid;
+        } else {
+            node.keyNext = it->second;
+            nodes[it->second].keyPrev = i;
+            it->second = i;
+        }
+    }
+
+    void
+    unlinkKey(Index i)
+    {
+        const Node &node = nodes[i];
+        if (node.keyNext != Invalid) {
+            nodes[node.keyNext].keyPrev = node.keyPrev;
+        }
+        if (node.keyPrev != Invalid) {
+            nodes[node.keyPrev].keyNext = node.keyNext;
+        } else if (node.keyNext != Invalid) {
+            keyIndex.find(node.key)->second = node.keyNext;
+        } else {
+            keyIndex.erase(node.key);
+        }
+    }
+
+    template <bool Const>
+    class Iter
+    {
+      private:
+        using Queue =
+            std::conditional_t<Const, const PrefetchQueue, PrefetchQueue>;
+
+        Queue *queue;
+        /**
+         * Position of the current priority in levels. Iteration goes
+         * towards lower priorities, which removing the current entry does
+         * not renumber.
+         */
+        std::size_t level;
+        Index idx;
+
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const T *, T *>;
+        using reference = std::conditional_t<Const, const T &, T &>;
+
+        Iter(Queue *_queue, std::size_t _level, Index _idx)
+            : queue(_queue), level(_level), idx(_idx)
+        {}
+
+        reference operator*() const { return queue->entry(idx); }
+        pointer operator->() const { return &queue->entry(idx); }
+
+        Iter &
+        operator++()
+        {
+            idx = queue->nodes[idx].next;
+            if (idx == Invalid && level > 0) {
+                level--;
+                idx = queue->levels[level].head;
+            }
+            return *this;
+        }
+
+        Iter
+        operator++(int)
+        {
+            Iter it = *this;
+            ++*this;
+            return it;
+        }
+
+        bool operator==(const Iter &other) const { return idx == other.idx; }
+        bool operator!=(const Iter &other) const { return idx != other.idx; }
+    };
+
+  public:
+    using iterator = Iter<false>;
+    using const_iterator = Iter<true>;
+
+    explicit PrefetchQueue(unsigned capacity)
+        : _capacity(capacity), slots(new Slot[capacity]), nodes(capacity)
+    {
+        fatal_if(capacity == 0, "A prefetch queue needs at least one entry");
+        freeList.reserve(capacity);
+        for (Index i = capacity; i > 0; i--) {
+            freeList.push_back(i - 1);
+        }
+        keyIndex.reserve(capacity);
+    }
+
+    ~PrefetchQueue() { clear(); }
+
+    PrefetchQueue(const PrefetchQueue &) = delete;
+    PrefetchQueue &operator=(const PrefetchQueue &) = delete;
+
+    std::size_t size() const { return _size; }
+    std::size_t capacity() const { return _capacity; }
+    bool empty() const { return _size == 0; }
+    bool full() const { return _size == _capacity; }
+
+    /** Oldest entry with the highest priority */
+    T &
+    front()
+    {
+        assert(!empty());
+        return entry(levels.back().head);
+    }
+
+    const T &
+    front() const
+    {
+        assert(!empty());
+        return entry(levels.back().head);
+    }
+
+    /** Oldest entry with the lowest priority */
+    T &
+    lowest()
+    {
+        assert(!empty());
+        return entry(levels.front().head);
+    }
+
+    /**
+     * Construct an entry behind the entries with the same or higher
+     * priority. The queue must not be full.
+     *
+     * @param key Key to find the entry with.
+     * @param args Arguments of the entry constructor.
+     * @return The new entry.
+     */
+    template <typename... Args>
+    T &
+    emplace(Addr key, Args &&...args)
+    {
+        assert(!full());
+        const Index i = freeList.back();
+        freeList.pop_back();
+        T *e = new (&slots[i]) T(std::forward<Args>(args)...);
+        Node &node = nodes[i];
+        node.valid = true;
+        node.priority = e->priority;
+        linkLevel(i);
+        linkKey(i, key);
+        _size++;
+        return *e;
+    }
+
+    /** Remove an entry of this queue */
+    void
+    erase(const T &e)
+    {
+        const Index i = indexOf(e);
+        unlinkLevel(i);
+        unlinkKey(i);
+        nodes[i].valid = false;
+        entry(i).~T();
+        freeList.push_back(i);
+        _size--;
+    }
+
+    void popFront() { erase(front()); }
+
+    /**
+     * Move an entry after its priority member has changed. It is placed
+     * behind the entries that already have the new priority.
+     */
+    void
+    reprioritize(T &e)
+    {
+        const Index i = indexOf(e);
+        unlinkLevel(i);
+        nodes[i].priority = e.priority;
+        linkLevel(i);
+    }
+
+    /**
+     * Find an entry registered under a key.
+     *
+     * @param key Key of the entry.
+     * @param pred Predicate the entry must satisfy.
+     * @return The entry, or nullptr if no entry matches.
+     */
+    template <typename Pred>
+    T *
+    find(Addr key, Pred &&pred)
+    {
+        auto it = keyIndex.find(key);
+        if (it == keyIndex.end()) {
+            return nullptr;
+        }
+        for (Index i = it->second; i != Invalid; i = nodes[i].keyNext) {
+            if (pred(entry(i))) {
+                return &entry(i);
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * Remove the entries registered under a key that satisfy a predicate.
+     *
+     * @return The number of entries removed.
+     */
+    template <typename Pred>
+    std::size_t
+    eraseIf(Addr key, Pred &&pred)
+    {
+        auto it = keyIndex.find(key);
+        if (it == keyIndex.end()) {
+            return 0;
+        }
+        std::size_t removed = 0;
+        Index i = it->second;
+        while (i != Invalid) {
+            const Index next = nodes[i].keyNext;
+            if (pred(entry(i))) {
+                erase(entry(i));
+                removed++;
+            }
+            i = next;
+        }
+        return removed;
+    }
+
+    void
+    clear()
+    {
+        while (!empty()) {
+            popFront();
+        }
+    }
+
+    /**
+     * Iterators go from the front to the lowest priority. Removing the
+     * entry an iterator points to invalidates only that iterator.
+     */
+    iterator
+    begin()
+    {
+        return empty() ? end() :
+            iterator(this, levels.size() - 1, levels.back().head);
+    }
+
+    iterator end() { return iterator(this, 0, Invalid); }
+
+    const_iterator
+    begin() const
+    {
+        return empty() ? end() :
+            const_iterator(this, levels.size() - 1, levels.back().head);
+    }
+
+    const_iterator end() const { return const_iterator(this, 0, Invalid); }
+};
+
+} // namespace prefetch
+} // namespace gem5
+
+#endif // __MEM_CACHE_PREFETCH_PREFETCH_QUEUE_HH__
@@ -0,0 +1,308 @@
+/*
+ * Copyright (c) 2025 Boston University
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include <list>
+#include <random>
+#include <vector>
+
+#include "mem/cache/prefetch/prefetch_queue.hh"
+
+using namespace gem5;
+using namespace gem5::prefetch;
+
+namespace
+{
+
+struct Entry
+{
+    Entry(Addr _addr, int32_t _priority, int _id)
+        : addr(_addr), priority(_priority), id(_id)
+    {}
+
+    Addr addr;
+    int32_t priority;
+    int id;
+};
+
+/**
+ * Reference model of the queue: a sorted list, walked on every operation,
+ * as the queued prefetcher used to do.
+ */
+class ListQueue
+{
+  public:
+    explicit ListQueue(std::size_t _capacity) : capacity(_capacity) {}
+
+    std::list<Entry> entries;
+    const std::size_t capacity;
+
+    Entry *
+    find(Addr addr)
+    {
+        for (auto &e : entries) {
+            if (e.addr == addr) {
+                return &e;
+            }
+        }
+        return nullptr;
+    }
+
+    /** Place an entry behind the ones with the same or higher priority */
+    void
+    place(const Entry &e)
+    {
+        auto it = entries.begin();
+        while (it != entries.end() && it->priority >= e.priority) {
+            it++;
+        }
+        entries.insert(it, e);
+    }
+
+    void
+    insert(const Entry &e)
+    {
+        if (entries.size() == capacity) {
+            // Oldest entry of the lowest priority
+            auto victim = std::prev(entries.end());
+            while (victim != entries.begin() &&
+                   std::prev(victim)->priority == victim->priority) {
+                victim--;
+            }
+            entries.erase(victim);
+        }
+        place(e);
+    }
+
+    void
+    reprioritize(Addr addr, int32_t priority)
+    {
+        for (auto it = entries.begin(); it != entries.end(); it++) {
+            if (it->addr == addr) {
+                Entry e = *it;
+                e.priority = priority;
+                entries.erase(it);
+                place(e);
+                return;
+            }
+        }
+    }
+
+    void
+    erase(Addr addr)
+    {
+        entries.remove_if([addr](const Entry &e) { return e.addr == addr; });
+    }
+};
+
+void
+insert(PrefetchQueue<Entry> &queue, const Entry &e)
+{
+    if (queue.full()) {
+        queue.erase(queue.lowest());
+    }
+    queue.emplace(e.addr, e);
+}
+
+void
+expectSame(PrefetchQueue<Entry> &queue, const ListQueue &ref)
+{
+    ASSERT_EQ(queue.size(), ref.entries.size());
+    auto it = ref.entries.begin();
+    for (const Entry &e : queue) {
+        EXPECT_EQ(e.id, it->id);
+        EXPECT_EQ(e.priority, it->priority);
+        it++;
+    }
+}
+
+} // anonymous namespace
+
+TEST(PrefetchQueueTest, Empty)
+{
+    PrefetchQueue<Entry> queue(4);
+    EXPECT_TRUE(queue.empty());
+    EXPECT_FALSE(queue.full());
+    EXPECT_EQ(queue.capacity(), 4);
+    EXPECT_EQ(queue.begin(), queue.end());
+    EXPECT_EQ(queue.find(0x40, [](const Entry &) { return true; }), nullptr);
+}
+
+/** Entries are ordered by priority, then by age */
+TEST(PrefetchQueueTest, Order)
+{
+    PrefetchQueue<Entry> queue(8);
+    queue.emplace(0x00, 0x00, 1, 0);
+    queue.emplace(0x40, 0x40, 3, 1);
+    queue.emplace(0x80, 0x80, 1, 2);
+    queue.emplace(0xc0, 0xc0, 2, 3);
+    queue.emplace(0x100, 0x100, 3, 4);
+
+    std::vector<int> ids;
+    for (const Entry &e : queue) {
+        ids.push_back(e.id);
+    }
+    EXPECT_EQ(ids, std::vector<int>({1, 4, 3, 0, 2}));
+    EXPECT_EQ(queue.front().id, 1);
+    EXPECT_EQ(queue.lowest().id, 0);
+
+    queue.popFront();
+    EXPECT_EQ(queue.front().id, 4);
+    queue.popFront();
+    EXPECT_EQ(queue.front().id, 3);
+}
+
+/** A reprioritized entry goes behind the entries of its new priority */
+TEST(PrefetchQueueTest, Reprioritize)
+{
+    PrefetchQueue<Entry> queue(8);
+    queue.emplace(0x00, 0x00, 2, 0);
+    queue.emplace(0x40, 0x40, 1, 1);
+    Entry &e = queue.emplace(0x80, 0x80, 0, 2);
+
+    e.priority = 2;
+    queue.reprioritize(e);
+
+    std::vector<int> ids;
+    for (const Entry &e : queue) {
+        ids.push_back(e.id);
+    }
+    EXPECT_EQ(ids, std::vector<int>({0, 2, 1}));
+    EXPECT_EQ(queue.lowest().id, 1);
+}
+
+/** Entries sharing a key are told apart by the predicate */
+TEST(PrefetchQueueTest, SharedKeys)
+{
+    PrefetchQueue<Entry> queue(8);
+    for (int i = 0; i < 4; i++) {
+        queue.emplace(0x40, 0x40 + i, 0, i);
+    }
+    queue.emplace(0x80, 0x80, 0, 4);
+
+    Entry *e = queue.find(0x40, [](const Entry &e) { return e.id == 2; });
+    ASSERT_NE(e, nullptr);
+    EXPECT_EQ(e->addr, 0x42);
+    EXPECT_EQ(queue.find(0x40, [](const Entry &e) { return e.id == 4; }),
+              nullptr);
+
+    EXPECT_EQ(queue.eraseIf(0x40,
+        [](const Entry &e) { return e.id % 2 == 0; }), 2);
+    EXPECT_EQ(queue.size(), 3);
+    EXPECT_EQ(queue.find(0x40, [](const Entry &e) { return e.id == 2; }),
+              nullptr);
+    EXPECT_EQ(queue.eraseIf(0x40, [](const Entry &) { return true; }), 2);
+    EXPECT_EQ(queue.eraseIf(0x40, [](const Entry &) { return true; }), 0);
+    EXPECT_EQ(queue.front().id, 4);
+}
+
+/** Entries do not move while they are queued */
+TEST(PrefetchQueueTest, StableReferences)
+{
+    PrefetchQueue<Entry> queue(16);
+    Entry *kept = &queue.emplace(0x1000, 0x1000, 0, -1);
+    for (int i = 0; i < 100; i++) {
+        if (queue.full()) {
+            queue.popFront();
+        }
+        queue.emplace(64 * i, 64 * i, 1 + i % 3, i);
+        ASSERT_EQ(kept, &queue.lowest());
+    }
+    kept->priority = 8;
+    queue.reprioritize(*kept);
+    EXPECT_EQ(kept, &queue.front());
+    EXPECT_EQ(kept->id, -1);
+}
+
+/** Removing the current entry does not disturb an advanced iterator */
+TEST(PrefetchQueueTest, EraseWhileIterating)
+{
+    PrefetchQueue<Entry> queue(8);
+    for (int i = 0; i < 8; i++) {
+        queue.emplace(64 * i, 64 * i, i % 3, i);
+    }
+
+    std::vector<int> visited;
+    auto it = queue.begin();
+    while (it != queue.end()) {
+        Entry &e = *it;
+        it++;
+        visited.push_back(e.id);
+        if (e.id % 2 == 0) {
+            queue.erase(e);
+        }
+    }
+    EXPECT_EQ(visited, std::vector<int>({2, 5, 1, 4, 7, 0, 3, 6}));
+    EXPECT_EQ(queue.size(), 4);
+}
+
+/** Random operations match the reference model */
+TEST(PrefetchQueueTest, MatchesList)
+{
+    std::mt19937 gen(0x5eed);
+    for (std::size_t capacity : {1, 2, 7, 32}) {
+        PrefetchQueue<Entry> queue(capacity);
+        ListQueue ref(capacity);
+        for (int i = 0; i < 20000; i++) {
+            // Few distinct addresses so that duplicates are frequent
+            const Addr addr = 64 * (gen() % (2 * capacity + 2));
+            const int32_t priority = gen() % 4;
+            switch (gen() % 4) {
+              case 0:
+                if (!queue.empty()) {
+                    EXPECT_EQ(queue.front().id, ref.entries.front().id);
+                    queue.popFront();
+                    ref.entries.pop_front();
+                }
+                break;
+              case 1:
+                queue.eraseIf(addr, [](const Entry &) { return true; });
+                ref.erase(addr);
+                break;
+              default:
+                if (Entry *e = queue.find(addr,
+                        [](const Entry &) { return true; })) {
+                    ASSERT_NE(ref.find(addr), nullptr);
+                    if (e->priority < priority) {
+                        e->priority = priority;
+                        queue.reprioritize(*e);
+                        ref.reprioritize(addr, priority);
+                    }
+                } else {
+                    ASSERT_EQ(ref.find(addr), nullptr);
+                    insert(queue, Entry(addr, priority, i));
+                    ref.insert(Entry(addr, priority, i));
+                }
+                break;
+            }
+            expectSame(queue, ref);
+        }
+    }
+}
@@ -54,11 +54,11 @@ namespace gem5
 namespace prefetch
 {
 
-void
-Queued::DeferredPacket::createPkt(Addr paddr, unsigned blk_size,
-                                            RequestorID requestor_id,
-                                            bool tag_prefetch,
-                                            Tick t) {
+PacketPtr
+Queued::DeferredPacket::createPkt(unsigned blk_size,
+                                  RequestorID requestor_id,
+                                  bool tag_prefetch) const
+{
     /* Create a prefetch memory request */
     RequestPtr req = std::make_shared<Request>(paddr, blk_size,
                                                 0, requestor_id);
@@ -67,13 +67,13 @@ Queued::DeferredPacket::createPkt(Addr paddr, unsigned blk_size,
         req->setFlags(Request::SECURE);
     }
     req->taskId(context_switch_task_id::Prefetcher);
-    pkt = new Packet(req, MemCmd::HardPFReq);
+    PacketPtr pkt = new Packet(req, MemCmd::HardPFReq);
     pkt->allocate();
     if (tag_prefetch && pfInfo.hasPC()) {
         // Tag prefetch packet with  accessing pc
         pkt->req->setPC(pfInfo.getPC());
     }
-    tick = t;
+    return pkt;
 }
 
 void
@@ -98,7 +98,8 @@ Queued::DeferredPacket::finish(const Fault &fault,
 }
 
 Queued::Queued(const QueuedPrefetcherParams &p)
-    : Base(p), queueSize(p.queue_size),
+    : Base(p), pfq(p.queue_size), pfqMissingTranslation(p.queue_size),
+      queueSize(p.queue_size),
       missingTranslationQueueSize(
         p.max_prefetch_requests_with_pending_translation),
       latency(p.latency), queueSquash(p.queue_squash),
@@ -108,16 +109,8 @@ Queued::Queued(const QueuedPrefetcherParams &p)
 {
 }
 
-Queued::~Queued()
-{
-    // Delete the queued prefetch packets
-    for (DeferredPacket &p : pfq) {
-        delete p.pkt;
-    }
-}
-
 void
-Queued::printQueue(const std::list<DeferredPacket> &queue) const
+Queued::printQueue(const DeferredQueue &queue) const
 {
     int pos = 0;
     std::string queue_name = "";
@@ -128,13 +121,10 @@ Queued::printQueue(const std::list<DeferredPacket> &queue) const
         queue_name = "PFTransQ";
     }
 
-    for (const_iterator it = queue.cbegin(); it != queue.cend();
-                                                            it++, pos++) {
-        Addr vaddr = it->pfInfo.getAddr();
-        /* Set paddr to 0 if not yet translated */
-        Addr paddr = it->pkt ? it->pkt->getAddr() : 0;
+    for (const DeferredPacket &dp : queue) {
         DPRINTF(HWPrefetchQueue, "%s[%d]: Prefetch Req VA: %#x PA: %#x "
-                "prio: %3d\n", queue_name, pos, vaddr, paddr, it->priority);
+                "prio: %3d\n", queue_name, pos++, dp.pfInfo.getAddr(),
+                dp.paddr, dp.priority);
     }
 }
 
@@ -178,21 +168,16 @@ Queued::notify(const CacheAccessProbeArg &acc, const PrefetchInfo &pfi)
 
     // Squash queued prefetches if demand miss to same line
     if (queueSquash) {
-        auto itr = pfq.begin();
-        while (itr != pfq.end()) {
-            if (blockAddress(itr->pfInfo.getAddr()) == blk_addr &&
-                itr->pfInfo.isSecure() == is_secure) {
-                DPRINTF(HWPrefetch, "Removing pf candidate addr: %#x "
-                        "(cl: %#x), demand request going to the same addr\n",
-                        itr->pfInfo.getAddr(),
-                        blockAddress(itr->pfInfo.getAddr()));
-                delete itr->pkt;
-                itr = pfq.erase(itr);
-                statsQueued.pfRemovedDemand++;
-            } else {
-                ++itr;
+        pfq.eraseIf(blk_addr, [&](const DeferredPacket &dp) {
+            if (dp.pfInfo.isSecure() != is_secure) {
+                return false;
             }
-        }
+            DPRINTF(HWPrefetch, "Removing pf candidate addr: %#x "
+                    "(cl: %#x), demand request going to the same addr\n",
+                    dp.pfInfo.getAddr(), blk_addr);
+            statsQueued.pfRemovedDemand++;
+            return true;
+        });
     }
 
     // Calculate prefetches given this access
@@ -251,8 +236,8 @@ Queued::getPacket()
         return nullptr;
     }
 
-    PacketPtr pkt = pfq.front().pkt;
-    pfq.pop_front();
+    PacketPtr pkt = pfq.front().createPkt(blkSize, requestorId, tagPrefetch);
+    pfq.popFront();
 
     prefetchStats.pfIssued++;
     issuedPrefetches += 1;
@@ -288,7 +273,7 @@ void
 Queued::processMissingTranslations(unsigned max)
 {
     unsigned count = 0;
-    iterator it = pfqMissingTranslation.begin();
+    auto it = pfqMissingTranslation.begin();
     while (it != pfqMissingTranslation.end() && count < max) {
         DeferredPacket &dp = *it;
         // Increase the iterator first because dp.startTranslation can end up
@@ -303,74 +288,55 @@ void
 Queued::translationComplete(DeferredPacket *dp, bool failed,
                             const CacheAccessor &cache)
 {
-    auto it = pfqMissingTranslation.begin();
-    while (it != pfqMissingTranslation.end()) {
-        if (&(*it) == dp) {
-            break;
-        }
-        it++;
-    }
-    assert(it != pfqMissingTranslation.end());
     if (!failed) {
         DPRINTF(HWPrefetch, "%s Translation of vaddr %#x succeeded: "
                 "paddr %#x \n", mmu->name(),
-                it->translationRequest->getVaddr(),
-                it->translationRequest->getPaddr());
-        Addr target_paddr = it->translationRequest->getPaddr();
+                dp->translationRequest->getVaddr(),
+                dp->translationRequest->getPaddr());
+        Addr target_paddr = dp->translationRequest->getPaddr();
         // check if this prefetch is already redundant
         if (cacheSnoop &&
-                (cache.inCache(target_paddr, it->pfInfo.isSecure()) ||
-                 cache.inMissQueue(target_paddr, it->pfInfo.isSecure()))) {
+                (cache.inCache(target_paddr, dp->pfInfo.isSecure()) ||
+                 cache.inMissQueue(target_paddr, dp->pfInfo.isSecure()))) {
             statsQueued.pfInCache++;
             DPRINTF(HWPrefetch, "Dropping redundant in "
                     "cache/MSHR prefetch addr:%#x\n", target_paddr);
         } else {
             Tick pf_time = curTick() + clockPeriod() * latency;
-            it->createPkt(target_paddr, blkSize, requestorId, tagPrefetch,
-                          pf_time);
-            addToQueue(pfq, *it);
+            dp->setTarget(target_paddr, pf_time);
+            addToQueue(pfq, *dp);
         }
     } else {
         DPRINTF(HWPrefetch, "%s Translation of vaddr %#x failed, dropping "
                 "prefetch request %#x \n", mmu->name(),
-                it->translationRequest->getVaddr());
+                dp->translationRequest->getVaddr());
     }
-    pfqMissingTranslation.erase(it);
+    pfqMissingTranslation.erase(*dp);
 }
 
 bool
-Queued::alreadyInQueue(std::list<DeferredPacket> &queue,
+Queued::alreadyInQueue(DeferredQueue &queue,
                                  const PrefetchInfo &pfi, int32_t priority)
 {
-    bool found = false;
-    iterator it;
-    for (it = queue.begin(); it != queue.end() && !found; it++) {
-        found = it->pfInfo.sameAddr(pfi);
+    DeferredPacket *dp = queue.find(blockAddress(pfi.getAddr()),
+        [&pfi](const DeferredPacket &p) { return p.pfInfo.sameAddr(pfi); });
+    if (dp == nullptr) {
+        return false;
     }
 
-    /* If the address is already in the queue, update priority and leave */
-    if (it != queue.end()) {
-        statsQueued.pfBufferHit++;
-        if (it->priority < priority) {
-            /* Update priority value and position in the queue */
-            it->priority = priority;
-            iterator prev = it;
-            while (prev != queue.begin()) {
-                prev--;
-                /* If the packet has higher priority, swap */
-                if (*it > *prev) {
-                    std::swap(*it, *prev);
-                    it = prev;
-                }
-            }
-            DPRINTF(HWPrefetch, "Prefetch addr already in "
-                "prefetch queue, priority updated\n");
-        } else {
-            DPRINTF(HWPrefetch, "Prefetch addr already in "
-                "prefetch queue\n");
-        }
+    /* The address is already in the queue, update priority and leave */
+    statsQueued.pfBufferHit++;
+    if (dp->priority < priority) {
+        /* Update priority value and position in the queue */
+        dp->priority = priority;
+        queue.reprioritize(*dp);
+        DPRINTF(HWPrefetch, "Prefetch addr already in "
+            "prefetch queue, priority updated\n");
+    } else {
+        DPRINTF(HWPrefetch, "Prefetch addr already in "
+            "prefetch queue\n");
     }
-    return found;
+    return true;
 }
 
 RequestPtr
@@ -463,12 +429,11 @@ Queued::insert(const PacketPtr &pkt, PrefetchInfo &new_pfi,
         return;
     }
 
-    /* Create the packet and find the spot to insert it */
+    /* Create the request and find the spot to insert it */
     DeferredPacket dpp(this, new_pfi, 0, priority, cache);
     if (has_target_pa) {
         Tick pf_time = curTick() + clockPeriod() * latency;
-        dpp.createPkt(target_paddr, blkSize, requestorId, tagPrefetch,
-                      pf_time);
+        dpp.setTarget(target_paddr, pf_time);
         DPRINTF(HWPrefetch, "Prefetch queued. "
                 "addr:%#x priority: %3d tick:%lld.\n",
                 new_pfi.getAddr(), priority, pf_time);
@@ -484,50 +449,26 @@ Queued::insert(const PacketPtr &pkt, PrefetchInfo &new_pfi,
 }
 
 void
-Queued::addToQueue(std::list<DeferredPacket> &queue,
-                             DeferredPacket &dpp)
+Queued::addToQueue(DeferredQueue &queue, DeferredPacket &dpp)
 {
     /* Verify prefetch buffer space for request */
-    if (queue.size() == queueSize) {
+    if (queue.full()) {
         statsQueued.pfRemovedFull++;
-        /* Lowest priority packet */
-        iterator it = queue.end();
-        panic_if (it == queue.begin(),
-            "Prefetch queue is both full and empty!");
-        --it;
-        /* Look for oldest in that level of priority */
-        panic_if (it == queue.begin(),
-            "Prefetch queue is full with 1 element!");
-        iterator prev = it;
-        bool cont = true;
-        /* While not at the head of the queue */
-        while (cont && prev != queue.begin()) {
-            prev--;
-            /* While at the same level of priority */
-            cont = prev->priority == it->priority;
-            if (cont)
-                /* update pointer */
-                it = prev;
+        /* Oldest packet of the lowest priority */
+        DeferredPacket &victim = queue.lowest();
+        if (victim.ongoingTranslation) {
+            /* The MMU still holds on to the victim, drop the new request */
+            DPRINTF(HWPrefetch, "Prefetch queue full, dropping packet, "
+                                "addr: %#x\n", dpp.pfInfo.getAddr());
+            return;
         }
         DPRINTF(HWPrefetch, "Prefetch queue full, removing lowest priority "
-                            "oldest packet, addr: %#x\n",it->pfInfo.getAddr());
-        delete it->pkt;
-        queue.erase(it);
+                            "oldest packet, addr: %#x\n",
+                            victim.pfInfo.getAddr());
+        queue.erase(victim);
     }
 
-    if ((queue.size() == 0) || (dpp <= queue.back())) {
-        queue.emplace_back(dpp);
-    } else {
-        iterator it = queue.end();
-        do {
-            --it;
-        } while (it != queue.begin() && dpp > *it);
-        /* If we reach the head, we have to see if the new element is new head
-         * or not */
-        if (it == queue.begin() && dpp <= *it)
-            it++;
-        queue.insert(it, dpp);
-    }
+    queue.emplace(blockAddress(dpp.pfInfo.getAddr()), dpp);
 
     if (debug::HWPrefetchQueue)
         printQueue(queue);
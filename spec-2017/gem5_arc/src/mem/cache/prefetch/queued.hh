@@ -39,13 +39,13 @@
 #define __MEM_CACHE_PREFETCH_QUEUED_HH__
 
 #include <cstdint>
-#include <list>
 #include <utility>
 
 #include "arch/generic/mmu.hh"
 #include "base/statistics.hh"
 #include "base/types.hh"
 #include "mem/cache/prefetch/base.hh"
+#include "mem/cache/prefetch/prefetch_queue.hh"
 #include "mem/packet.hh"
 
 namespace gem5
@@ -67,8 +67,8 @@ class Queued : public Base
         PrefetchInfo pfInfo;
         /** Time when this prefetch becomes ready */
         Tick tick;
-        /** The memory packet generated by this prefetch */
-        PacketPtr pkt;
+        /** Physical address of this prefetch, 0 if not yet translated */
+        Addr paddr;
         /** The priority of this prefetch */
         int32_t priority;
         /** Request used when a translation is needed */
@@ -82,41 +82,39 @@ class Queued : public Base
          * @param o QueuedPrefetcher in charge of this request
          * @param pfi PrefechInfo object associated to this packet
          * @param t Time when this prefetch becomes ready
-         * @param p PacketPtr with the memory request of the prefetch
          * @param prio This prefetch priority
          */
         DeferredPacket(Queued *o, PrefetchInfo const &pfi, Tick t,
             int32_t prio, const CacheAccessor &_cache)
-            : owner(o), pfInfo(pfi), tick(t), pkt(nullptr),
+            : owner(o), pfInfo(pfi), tick(t), paddr(0),
             priority(prio), translationRequest(), tc(nullptr),
             ongoingTranslation(false), cache(&_cache) {
         }
 
-        bool operator>(const DeferredPacket& that) const
-        {
-            return priority > that.priority;
-        }
-        bool operator<(const DeferredPacket& that) const
-        {
-            return priority < that.priority;
-        }
-        bool operator<=(const DeferredPacket& that) const
+        /**
+         * Sets the physical address of this prefetch once it is known
+         * @param _paddr physical address of the prefetch
+         * @param t time when the prefetch becomes ready
+         */
+        void setTarget(Addr _paddr, Tick t)
         {
-            return !(*this > that);
+            paddr = _paddr;
+            tick = t;
         }
 
         /**
-         * Create the associated memory packet
-         * @param paddr physical address of this packet
+         * Create the memory packet of this prefetch. This is deferred until
+         * the prefetch is issued, so that prefetches squashed or dropped
+         * while queued never allocate a packet.
          * @param blk_size block size used by the prefetcher
          * @param requestor_id Requestor ID of the access that generated
          * this prefetch
          * @param tag_prefetch flag to indicate if the packet needs to be
          *        tagged
-         * @param t time when the prefetch becomes ready
+         * @return the new packet
          */
-        void createPkt(Addr paddr, unsigned blk_size, RequestorID requestor_id,
-                       bool tag_prefetch, Tick t);
+        PacketPtr createPkt(unsigned blk_size, RequestorID requestor_id,
+                            bool tag_prefetch) const;
 
         /**
          * Sets the translation request needed to obtain the physical address
@@ -141,11 +139,14 @@ class Queued : public Base
         void startTranslation(BaseMMU *mmu);
     };
 
-    std::list<DeferredPacket> pfq;
-    std::list<DeferredPacket> pfqMissingTranslation;
+    /**
+     * Queued prefetches are looked up by block address, so duplicate
+     * filtering and demand squashing do not walk the queues.
+     */
+    using DeferredQueue = PrefetchQueue<DeferredPacket>;
 
-    using const_iterator = std::list<DeferredPacket>::const_iterator;
-    using iterator = std::list<DeferredPacket>::iterator;
+    DeferredQueue pfq;
+    DeferredQueue pfqMissingTranslation;
 
     // PARAMETERS
 
@@ -192,7 +193,6 @@ class Queued : public Base
     using AddrPriority = std::pair<Addr, int32_t>;
 
     Queued(const QueuedPrefetcherParams &p);
-    virtual ~Queued();
 
     void
     notify(const CacheAccessProbeArg &acc, const PrefetchInfo &pfi) override;
@@ -210,7 +210,7 @@ class Queued : public Base
         return pfq.empty() ? MaxTick : pfq.front().tick;
     }
 
-    void printQueue(const std::list<DeferredPacket> &queue) const;
+    void printQueue(const DeferredQueue &queue) const;
 
   private:
 
@@ -219,7 +219,7 @@ class Queued : public Base
      * @param queue selected queue to use
      * @param dpp DeferredPacket to add
      */
-    void addToQueue(std::list<DeferredPacket> &queue, DeferredPacket &dpp);
+    void addToQueue(DeferredQueue &queue, DeferredPacket &dpp);
 
     /**
      * Starts the translations of the queued prefetches with a
@@ -249,7 +249,7 @@ class Queued : public Base
      * @param priority priority of the prefetch request to be added
      * @return True if the prefetch request was found in the queue
      */
-    bool alreadyInQueue(std::list<DeferredPacket> &queue,
+    bool alreadyInQueue(DeferredQueue &queue,
                         const PrefetchInfo &pfi, int32_t priority);
 
     /**
@@ -301,7 +301,7 @@ class Packet : public Printable, public Extensible<Packet>
     enum : FlagsType
     {
         // Flags to transfer across when copying a packet
-        COPY_FLAGS             = 0x000000FF,
+        COPY_FLAGS             = 0x000004FF,
 
         // Flags that are used to create reponse packets
         RESPONDER_FLAGS        = 0x00000009,
@@ -346,6 +346,10 @@ class Packet : public Printable, public Extensible<Packet>
         VALID_ADDR             = 0x00000100,
         VALID_SIZE             = 0x00000200,
 
+        // The cache maintenance snoop is a snoop filter dropping the
+        // line to make room. See setBackInvalidation below.
+        BACK_INVALIDATION      = 0x00000400,
+
         /// Is the data pointer set to a value that shouldn't be freed
         /// when the packet is destroyed?
         STATIC_DATA            = 0x00001000,
@@ -754,6 +758,20 @@ class Packet : public Printable, public Extensible<Packet>
     }
     bool satisfied() const { return flags.isSet(SATISFIED); }
 
+    /**
+     * Set by a snoop filter on the CleanInvalidReq snoops it sends to
+     * the holders of a line it evicts. Nobody waits for a response to
+     * these, so a cache that has the line in a writeback keeps the
+     * writeback, which takes the dirty data below the filter.
+     */
+    void setBackInvalidation()
+    {
+        assert(cmd.isClean() && cmd.isInvalidate());
+        flags.set(BACK_INVALIDATION);
+    }
+    bool isBackInvalidation() const
+    { return flags.isSet(BACK_INVALIDATION); }
+
     void setSuppressFuncError()     { flags.set(SUPPRESS_FUNC_ERROR); }
     bool suppressFuncError() const  { return flags.isSet(SUPPRESS_FUNC_ERROR); }
     void setBlockCached()          { flags.set(BLOCK_CACHED); }
@@ -133,3 +133,37 @@ class QoSPropFairPolicy(QoSPolicy):
                     )
 
     weight = Param.Float(0.5, "Pf score weight")
+
+
+class QoSBlissPolicy(QoSPolicy):
+    type = "QoSBlissPolicy"
+    cxx_header = "mem/qos/policy_bliss.hh"
+    cxx_class = "gem5::memory::qos::BlissPolicy"
+
+    blacklist_threshold = Param.Unsigned(
+        4, "Consecutive requests serviced before blacklisting a requestor"
+    )
+    clearing_interval = Param.Latency(
+        "10us", "Period at which the blacklist is cleared"
+    )
+
+
+class QoSAtlasPolicy(QoSPolicy):
+    type = "QoSAtlasPolicy"
+    cxx_header = "mem/qos/policy_atlas.hh"
+    cxx_class = "gem5::memory::qos::AtlasPolicy"
+
+    quantum = Param.Latency("3ms", "Length of a ranking quantum")
+    history_weight = Param.Float(
+        0.875, "Weight of past quanta in the attained service"
+    )
+
+
+class QoSParBsPolicy(QoSPolicy):
+    type = "QoSParBsPolicy"
+    cxx_header = "mem/qos/policy_parbs.hh"
+    cxx_class = "gem5::memory::qos::ParBsPolicy"
+
+    marking_cap = Param.Unsigned(
+        5, "Maximum number of requests marked per requestor in a batch"
+    )
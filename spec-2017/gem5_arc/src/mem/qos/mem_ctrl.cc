@@ -116,6 +116,10 @@ MemCtrl::logRequest(BusState dir, RequestorID id, uint8_t _qos,
         requestTimes[id][addr].push_back(curTick());
     }
 
+    if (policy) {
+        policy->notifyRequest(id, _qos, entries);
+    }
+
     // Record statistics
     stats.avgPriority[id].sample(_qos);
 
@@ -193,6 +197,11 @@ MemCtrl::logResponse(BusState dir, RequestorID id, uint8_t _qos,
         double latency = (double) (curTick() + delay - requestTime)
                 / sim_clock::as_float::s;
 
+        if (policy) {
+            policy->notifyResponse(id, _qos,
+                                   Tick(curTick() + delay - requestTime));
+        }
+
         if (latency > 0) {
             // Record per-priority latency stats
             if (stats.priorityMaxLatency[_qos].value() < latency) {
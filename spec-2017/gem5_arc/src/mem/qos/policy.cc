@@ -38,6 +38,7 @@
 #include "mem/qos/policy.hh"
 
 #include "params/QoSPolicy.hh"
+#include "sim/system.hh"
 
 namespace gem5
 {
@@ -61,6 +62,83 @@ Policy::schedule(const PacketPtr pkt)
     return schedule(pkt->req->requestorId(), pkt->getSize());
 }
 
+Policy::ServiceStats::ServiceStats(Policy &_policy)
+    : statistics::Group(&_policy),
+    policy(_policy),
+
+    ADD_STAT(bytesRequested, statistics::units::Byte::get(),
+             "Per requestor bytes requested to the memory controller"),
+    ADD_STAT(bandwidthShare, statistics::units::Ratio::get(),
+             "Per requestor share of the requested bytes",
+             bytesRequested / sum(bytesRequested)),
+    ADD_STAT(numResponses, statistics::units::Count::get(),
+             "Per requestor number of serviced queue entries"),
+    ADD_STAT(totalLatency, statistics::units::Tick::get(),
+             "Per requestor cumulative request to response latency"),
+    ADD_STAT(minLatency, statistics::units::Tick::get(),
+             "Per requestor minimum request to response latency"),
+    ADD_STAT(avgLatency, statistics::units::Rate<
+                statistics::units::Tick, statistics::units::Count>::get(),
+             "Per requestor average request to response latency",
+             totalLatency / numResponses),
+    ADD_STAT(slowdown, statistics::units::Ratio::get(),
+             "Per requestor slowdown, average over minimum latency",
+             avgLatency / minLatency)
+{
+}
+
+void
+Policy::ServiceStats::regStats()
+{
+    statistics::Group::regStats();
+
+    using namespace statistics;
+
+    System *system = policy.memCtrl->system();
+    const auto max_requestors = system->maxRequestors();
+
+    bytesRequested.init(max_requestors).flags(nozero);
+    numResponses.init(max_requestors).flags(nozero);
+    totalLatency.init(max_requestors).flags(nozero);
+    minLatency.init(max_requestors).flags(nozero);
+
+    bandwidthShare.flags(nozero | nonan).precision(4);
+    avgLatency.flags(nozero | nonan).precision(2);
+    slowdown.flags(nozero | nonan).precision(4);
+
+    for (int i = 0; i < max_requestors; i++) {
+        const std::string name = system->getRequestorName(i);
+        bytesRequested.subname(i, name);
+        bandwidthShare.subname(i, name);
+        numResponses.subname(i, name);
+        totalLatency.subname(i, name);
+        minLatency.subname(i, name);
+        avgLatency.subname(i, name);
+        slowdown.subname(i, name);
+    }
+}
+
+void
+Policy::ServiceStats::recordRequest(const RequestorID id,
+                                    const uint64_t bytes)
+{
+    if (id < bytesRequested.size())
+        bytesRequested[id] += bytes;
+}
+
+void
+Policy::ServiceStats::recordResponse(const RequestorID id,
+                                     const Tick latency)
+{
+    if (id >= numResponses.size())
+        return;
+
+    numResponses[id]++;
+    totalLatency[id] += latency;
+    if (minLatency[id].value() == 0 || minLatency[id].value() > latency)
+        minLatency[id] = latency;
+}
+
 } // namespace qos
 } // namespace memory
 } // namespace gem5
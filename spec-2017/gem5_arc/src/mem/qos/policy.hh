@@ -43,6 +43,7 @@
 
 #include "base/compiler.hh"
 #include "base/logging.hh"
+#include "base/statistics.hh"
 #include "base/trace.hh"
 #include "debug/QOS.hh"
 #include "mem/qos/mem_ctrl.hh"
@@ -75,8 +76,6 @@ class Policy : public SimObject
 
     virtual ~Policy();
 
-    virtual void regStats() override {};
-
     virtual void init() override {};
 
     /**
@@ -118,7 +117,68 @@ class Policy : public SimObject
      */
     uint8_t schedule(const PacketPtr pkt);
 
+    /**
+     * Notifies the policy that the memory controller has queued
+     * a request, after its QoS priority has been assigned.
+     *
+     * @param requestor_id requestor id of the request
+     * @param qos QoS priority the request has been queued with
+     * @param entries number of queue entries occupied by the request
+     */
+    virtual void notifyRequest(const RequestorID requestor_id,
+                               const uint8_t qos, const uint64_t entries)
+    {}
+
+    /**
+     * Notifies the policy that the memory controller has serviced
+     * a queue entry; entries are notified in service order.
+     *
+     * @param requestor_id requestor id of the request
+     * @param qos QoS priority the request has been serviced with
+     * @param latency request to response latency
+     */
+    virtual void notifyResponse(const RequestorID requestor_id,
+                                const uint8_t qos, const Tick latency)
+    {}
+
   protected:
+    /**
+     * Per-requestor service statistics, used by the policies which
+     * trade throughput for fairness to report how bandwidth is shared
+     * among requestors and how much each of them is slowed down.
+     * The slowdown is estimated as the ratio between the average and
+     * the minimum (i.e. least interfered) latency of a requestor.
+     */
+    struct ServiceStats : public statistics::Group
+    {
+        ServiceStats(Policy &policy);
+
+        void regStats() override;
+
+        /** Records a request of the given size in bytes */
+        void recordRequest(const RequestorID id, const uint64_t bytes);
+
+        /** Records a serviced queue entry and its latency */
+        void recordResponse(const RequestorID id, const Tick latency);
+
+        const Policy &policy;
+
+        /** per-requestor bytes requested to the controller */
+        statistics::Vector bytesRequested;
+        /** per-requestor share of the requested bytes */
+        statistics::Formula bandwidthShare;
+        /** per-requestor number of serviced queue entries */
+        statistics::Vector numResponses;
+        /** per-requestor cumulative request to response latency */
+        statistics::Vector totalLatency;
+        /** per-requestor minimum request to response latency */
+        statistics::Vector minLatency;
+        /** per-requestor average request to response latency */
+        statistics::Formula avgLatency;
+        /** per-requestor estimated slowdown */
+        statistics::Formula slowdown;
+    };
+
     /** Pointer to parent memory controller implementing the policy */
     MemCtrl* memCtrl;
 };
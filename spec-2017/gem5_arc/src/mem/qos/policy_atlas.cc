@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2025 Boston University
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/qos/policy_atlas.hh"
+
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "debug/QOS.hh"
+#include "params/QoSAtlasPolicy.hh"
+
+namespace gem5
+{
+
+namespace memory
+{
+
+namespace qos
+{
+
+AtlasPolicy::AtlasPolicy(const Params &p)
+  : Policy(p), quantum(p.quantum), historyWeight(p.history_weight),
+    nextQuantum(p.quantum), serviceStats(*this)
+{
+    fatal_if(quantum == 0, "quantum must be greater than zero");
+    fatal_if(historyWeight < 0 || historyWeight > 1,
+        "history_weight must be a value between 0 and 1");
+}
+
+AtlasPolicy::~AtlasPolicy()
+{}
+
+void
+AtlasPolicy::init()
+{
+    fatal_if(memCtrl->numPriorities() < 2,
+        "%s requires at least two QoS priorities", name());
+}
+
+AtlasPolicy::AttainedService&
+AtlasPolicy::getService(const RequestorID id)
+{
+    auto it = service.find(id);
+    if (it == service.end()) {
+        // A requestor which has not attained any service yet is
+        // the least serviced one
+        it = service.emplace(id, AttainedService()).first;
+        it->second.priority = memCtrl->numPriorities() - 1;
+    }
+    return it->second;
+}
+
+void
+AtlasPolicy::updateRanking()
+{
+    if (curTick() < nextQuantum)
+        return;
+
+    using Rank = std::tuple<double, RequestorID, AttainedService*>;
+    std::vector<Rank> ranking;
+    ranking.reserve(service.size());
+
+    for (auto &[id, attained] : service) {
+        attained.total = historyWeight * attained.total +
+                         (1.0 - historyWeight) * attained.current;
+        attained.current = 0;
+        ranking.emplace_back(attained.total, id, &attained);
+    }
+
+    // Least attained service first, requestor id breaks ties
+    std::sort(ranking.begin(), ranking.end(),
+        [] (const Rank &lhs, const Rank &rhs)
+        {
+            return std::tie(std::get<0>(lhs), std::get<1>(lhs)) <
+                   std::tie(std::get<0>(rhs), std::get<1>(rhs));
+        });
+
+    const uint8_t max_priority = memCtrl->numPriorities() - 1;
+    for (size_t rank = 0; rank < ranking.size(); ++rank) {
+        auto &[total, id, attained] = ranking[rank];
+        attained->priority = max_priority - std::min<size_t>(rank,
+                                                             max_priority);
+        DPRINTF(QOS, "AtlasPolicy: requestor %s [id %d] attained %f, "
+                "rank %d, priority %d\n",
+                memCtrl->system()->getRequestorName(id), id, total, rank,
+                attained->priority);
+    }
+
+    nextQuantum = curTick() - (curTick() % quantum) + quantum;
+}
+
+uint8_t
+AtlasPolicy::schedule(const RequestorID id, const uint64_t pkt_size)
+{
+    updateRanking();
+
+    serviceStats.recordRequest(id, pkt_size);
+
+    return getService(id).priority;
+}
+
+void
+AtlasPolicy::notifyResponse(const RequestorID id, const uint8_t qos,
+                            const Tick latency)
+{
+    updateRanking();
+
+    serviceStats.recordResponse(id, latency);
+
+    getService(id).current++;
+}
+
+} // namespace qos
+} // namespace memory
+} // namespace gem5
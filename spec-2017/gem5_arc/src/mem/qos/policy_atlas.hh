@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2025 Boston University
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_QOS_POLICY_ATLAS_HH__
+#define __MEM_QOS_POLICY_ATLAS_HH__
+
+#include <cstdint>
+#include <unordered_map>
+
+#include "base/types.hh"
+#include "mem/qos/policy.hh"
+#include "mem/request.hh"
+
+namespace gem5
+{
+
+struct QoSAtlasPolicyParams;
+
+namespace memory
+{
+
+namespace qos
+{
+
+/**
+ * ATLAS QoS Policy
+ *
+ * Based on "ATLAS: A scalable and high-performance scheduling algorithm
+ * for multiple memory controllers", Kim et al., HPCA 2010.
+ *
+ * Time is divided in quanta. At the end of every quantum the service
+ * attained by each requestor (number of serviced queue entries) is
+ * folded into an exponentially weighted history, and requestors are
+ * ranked by it: the requestor with the least attained service gets the
+ * highest QoS priority. Requestors ranked beyond the number of available
+ * priorities share the lowest one.
+ */
+class AtlasPolicy : public Policy
+{
+    using Params = QoSAtlasPolicyParams;
+
+  public:
+    AtlasPolicy(const Params &);
+    virtual ~AtlasPolicy();
+
+    void init() override;
+
+    /**
+     * Schedules a packet based on the requestor's attained service rank
+     *
+     * @param id requestor id to schedule
+     * @param pkt_size size of the packet
+     * @return QoS priority value
+     */
+    uint8_t schedule(const RequestorID id, const uint64_t pkt_size) override;
+
+    void notifyResponse(const RequestorID id, const uint8_t qos,
+                        const Tick latency) override;
+
+  protected:
+    /** Service accounting of a single requestor */
+    struct AttainedService
+    {
+        /** Entries serviced during the current quantum */
+        uint64_t current = 0;
+        /** Weighted service attained over past quanta */
+        double total = 0;
+        /** QoS priority assigned for the current quantum */
+        uint8_t priority = 0;
+    };
+
+    /** Looks up a requestor, registering it if needed */
+    AttainedService& getService(const RequestorID id);
+
+    /** Ranks requestors again if the current quantum has elapsed */
+    void updateRanking();
+
+    /** Length of a ranking quantum */
+    const Tick quantum;
+
+    /** Weight of the service history in the attained service */
+    const double historyWeight;
+
+    /** Tick at which the current quantum ends */
+    Tick nextQuantum;
+
+    /** Attained service of every requestor seen by the policy */
+    std::unordered_map<RequestorID, AttainedService> service;
+
+    ServiceStats serviceStats;
+};
+
+} // namespace qos
+} // namespace memory
+} // namespace gem5
+
+#endif // __MEM_QOS_POLICY_ATLAS_HH__
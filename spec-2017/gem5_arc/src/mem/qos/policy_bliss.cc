@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2025 Boston University
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/qos/policy_bliss.hh"
+
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "debug/QOS.hh"
+#include "params/QoSBlissPolicy.hh"
+
+namespace gem5
+{
+
+namespace memory
+{
+
+namespace qos
+{
+
+BlissPolicy::BlissPolicy(const Params &p)
+  : Policy(p), blacklistThreshold(p.blacklist_threshold),
+    clearingInterval(p.clearing_interval), nextClearing(p.clearing_interval),
+    lastServiced(Request::invldRequestorId), streak(0),
+    serviceStats(*this)
+{
+    fatal_if(blacklistThreshold == 0,
+        "blacklist_threshold must be greater than zero");
+    fatal_if(clearingInterval == 0,
+        "clearing_interval must be greater than zero");
+}
+
+BlissPolicy::~BlissPolicy()
+{}
+
+void
+BlissPolicy::init()
+{
+    fatal_if(memCtrl->numPriorities() < 2,
+        "%s requires at least two QoS priorities", name());
+}
+
+void
+BlissPolicy::clearBlacklist()
+{
+    if (curTick() < nextClearing)
+        return;
+
+    DPRINTF(QOS, "BlissPolicy: clearing %d blacklisted requestors\n",
+            blacklist.size());
+
+    blacklist.clear();
+    nextClearing = curTick() - (curTick() % clearingInterval) +
+                   clearingInterval;
+}
+
+uint8_t
+BlissPolicy::schedule(const RequestorID id, const uint64_t pkt_size)
+{
+    clearBlacklist();
+
+    serviceStats.recordRequest(id, pkt_size);
+
+    // Non-blacklisted requestors are serviced first
+    return isBlacklisted(id) ? 0 : memCtrl->numPriorities() - 1;
+}
+
+void
+BlissPolicy::notifyResponse(const RequestorID id, const uint8_t qos,
+                            const Tick latency)
+{
+    clearBlacklist();
+
+    serviceStats.recordResponse(id, latency);
+
+    if (id == lastServiced) {
+        streak++;
+    } else {
+        lastServiced = id;
+        streak = 1;
+    }
+
+    if (streak > blacklistThreshold && !isBlacklisted(id)) {
+        DPRINTF(QOS, "BlissPolicy: blacklisting requestor %s [id %d] "
+                "after %d consecutive services\n",
+                memCtrl->system()->getRequestorName(id), id, streak);
+        blacklist.insert(id);
+    }
+}
+
+} // namespace qos
+} // namespace memory
+} // namespace gem5
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2025 Boston University
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_QOS_POLICY_BLISS_HH__
+#define __MEM_QOS_POLICY_BLISS_HH__
+
+#include <cstdint>
+#include <unordered_set>
+
+#include "base/types.hh"
+#include "mem/qos/policy.hh"
+#include "mem/request.hh"
+
+namespace gem5
+{
+
+struct QoSBlissPolicyParams;
+
+namespace memory
+{
+
+namespace qos
+{
+
+/**
+ * Blacklisting (BLISS) QoS Policy
+ *
+ * Based on "The Blacklisting Memory Scheduler: Achieving high performance
+ * and fairness at low cost", Subramanian et al., ICCD 2014.
+ *
+ * The policy observes the order in which the memory controller services
+ * requests: a requestor having more than a threshold of consecutive
+ * requests serviced is blacklisted, and the blacklist is cleared
+ * periodically. Blacklisted requestors are assigned the lowest QoS
+ * priority and every other requestor the highest one, leaving row hit
+ * first and oldest first ordering to the controller scheduler within
+ * each priority level.
+ */
+class BlissPolicy : public Policy
+{
+    using Params = QoSBlissPolicyParams;
+
+  public:
+    BlissPolicy(const Params &);
+    virtual ~BlissPolicy();
+
+    void init() override;
+
+    /**
+     * Schedules a packet based on the requestor's blacklisting status
+     *
+     * @param id requestor id to schedule
+     * @param pkt_size size of the packet
+     * @return QoS priority value
+     */
+    uint8_t schedule(const RequestorID id, const uint64_t pkt_size) override;
+
+    void notifyResponse(const RequestorID id, const uint8_t qos,
+                        const Tick latency) override;
+
+    /** @return true if the requestor is currently blacklisted */
+    bool isBlacklisted(const RequestorID id) const
+    { return blacklist.find(id) != blacklist.end(); }
+
+  protected:
+    /** Clears the blacklist if the clearing interval has elapsed */
+    void clearBlacklist();
+
+    /** Consecutive services after which a requestor is blacklisted */
+    const unsigned blacklistThreshold;
+
+    /** Period at which the blacklist is cleared */
+    const Tick clearingInterval;
+
+    /** Tick at which the blacklist will be cleared next */
+    Tick nextClearing;
+
+    /** Requestor whose request has been serviced last */
+    RequestorID lastServiced;
+
+    /** Number of consecutive requests serviced from lastServiced */
+    unsigned streak;
+
+    /** Currently blacklisted requestors */
+    std::unordered_set<RequestorID> blacklist;
+
+    ServiceStats serviceStats;
+};
+
+} // namespace qos
+} // namespace memory
+} // namespace gem5
+
+#endif // __MEM_QOS_POLICY_BLISS_HH__
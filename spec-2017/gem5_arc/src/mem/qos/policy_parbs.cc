@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2025 Boston University
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/qos/policy_parbs.hh"
+
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "debug/QOS.hh"
+#include "params/QoSParBsPolicy.hh"
+
+namespace gem5
+{
+
+namespace memory
+{
+
+namespace qos
+{
+
+ParBsPolicy::ParBsPolicy(const Params &p)
+  : Policy(p), markingCap(p.marking_cap), totalOutstanding(0),
+    serviceStats(*this)
+{
+    fatal_if(markingCap == 0, "marking_cap must be greater than zero");
+}
+
+ParBsPolicy::~ParBsPolicy()
+{}
+
+void
+ParBsPolicy::init()
+{
+    fatal_if(memCtrl->numPriorities() < 2,
+        "%s requires at least two QoS priorities", name());
+}
+
+ParBsPolicy::BatchState&
+ParBsPolicy::getState(const RequestorID id)
+{
+    auto it = batch.find(id);
+    if (it == batch.end()) {
+        // A new requestor joins the current batch with no job length
+        it = batch.emplace(id, BatchState()).first;
+        it->second.quota = markingCap;
+        it->second.priority = memCtrl->numPriorities() - 1;
+    }
+    return it->second;
+}
+
+void
+ParBsPolicy::formBatch()
+{
+    using Rank = std::tuple<unsigned, RequestorID, BatchState*>;
+    std::vector<Rank> ranking;
+    ranking.reserve(batch.size());
+
+    for (auto &[id, state] : batch) {
+        ranking.emplace_back(state.load, id, &state);
+    }
+
+    // Shortest job first, requestor id breaks ties
+    std::sort(ranking.begin(), ranking.end(),
+        [] (const Rank &lhs, const Rank &rhs)
+        {
+            return std::tie(std::get<0>(lhs), std::get<1>(lhs)) <
+                   std::tie(std::get<0>(rhs), std::get<1>(rhs));
+        });
+
+    // Priority zero is reserved to unmarked requests
+    const uint8_t max_priority = memCtrl->numPriorities() - 1;
+    for (size_t rank = 0; rank < ranking.size(); ++rank) {
+        auto &[load, id, state] = ranking[rank];
+        state->priority = max_priority - std::min<size_t>(rank,
+                                                          max_priority - 1);
+        state->quota = markingCap;
+        state->load = 0;
+        DPRINTF(QOS, "ParBsPolicy: requestor %s [id %d] marked %d in the "
+                "last batch, priority %d\n",
+                memCtrl->system()->getRequestorName(id), id, load,
+                state->priority);
+    }
+}
+
+uint8_t
+ParBsPolicy::schedule(const RequestorID id, const uint64_t pkt_size)
+{
+    BatchState &state = getState(id);
+
+    // Synchronised scheduling only queries the requestor's status
+    if (pkt_size == 0)
+        return state.quota > 0 ? state.priority : 0;
+
+    serviceStats.recordRequest(id, pkt_size);
+
+    // Marked requests which never got queued (e.g. writes merged
+    // into queued ones) must not keep the batch from completing
+    if (state.quota == 0 && totalOutstanding == 0)
+        formBatch();
+
+    if (state.quota == 0)
+        return 0;
+
+    state.quota--;
+    state.load++;
+    return state.priority;
+}
+
+void
+ParBsPolicy::notifyRequest(const RequestorID id, const uint8_t qos,
+                           const uint64_t entries)
+{
+    if (qos == 0)
+        return;
+
+    getState(id).outstanding += entries;
+    totalOutstanding += entries;
+}
+
+void
+ParBsPolicy::notifyResponse(const RequestorID id, const uint8_t qos,
+                            const Tick latency)
+{
+    serviceStats.recordResponse(id, latency);
+
+    BatchState &state = getState(id);
+    if (qos == 0 || state.outstanding == 0)
+        return;
+
+    state.outstanding--;
+    totalOutstanding--;
+
+    if (totalOutstanding == 0) {
+        DPRINTF(QOS, "ParBsPolicy: batch completed, forming a new one\n");
+        formBatch();
+    }
+}
+
+} // namespace qos
+} // namespace memory
+} // namespace gem5
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2025 Boston University
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_QOS_POLICY_PARBS_HH__
+#define __MEM_QOS_POLICY_PARBS_HH__
+
+#include <cstdint>
+#include <unordered_map>
+
+#include "base/types.hh"
+#include "mem/qos/policy.hh"
+#include "mem/request.hh"
+
+namespace gem5
+{
+
+struct QoSParBsPolicyParams;
+
+namespace memory
+{
+
+namespace qos
+{
+
+/**
+ * Parallelism-Aware Batch Scheduling (PAR-BS) QoS Policy
+ *
+ * Based on "Parallelism-Aware Batch Scheduling: Enhancing both
+ * performance and fairness of shared DRAM systems", Mutlu and
+ * Moscibroda, ISCA 2008.
+ *
+ * Up to marking_cap requests per requestor are marked as part of the
+ * current batch; a new batch is formed once all the marked requests
+ * have been serviced. Marked requests are prioritised over unmarked
+ * ones (which get the lowest QoS priority) and, within a batch,
+ * requestors are ranked shortest job first, using the number of
+ * requests they had marked in the previous batch as the job length.
+ *
+ * The policy is unaware of banks, hence the marking cap applies to a
+ * requestor as a whole rather than to each bank. As marked requests
+ * are tracked through the QoS priority they are queued with, priority
+ * escalation must not be enabled in the memory controller.
+ */
+class ParBsPolicy : public Policy
+{
+    using Params = QoSParBsPolicyParams;
+
+  public:
+    ParBsPolicy(const Params &);
+    virtual ~ParBsPolicy();
+
+    void init() override;
+
+    /**
+     * Schedules a packet based on the requestor's batch status
+     *
+     * @param id requestor id to schedule
+     * @param pkt_size size of the packet
+     * @return QoS priority value
+     */
+    uint8_t schedule(const RequestorID id, const uint64_t pkt_size) override;
+
+    void notifyRequest(const RequestorID id, const uint8_t qos,
+                       const uint64_t entries) override;
+
+    void notifyResponse(const RequestorID id, const uint8_t qos,
+                        const Tick latency) override;
+
+  protected:
+    /** Batch accounting of a single requestor */
+    struct BatchState
+    {
+        /** Requests which can still be marked in the current batch */
+        unsigned quota = 0;
+        /** Requests marked in the current batch */
+        unsigned load = 0;
+        /** Marked queue entries not serviced yet */
+        uint64_t outstanding = 0;
+        /** QoS priority of the marked requests */
+        uint8_t priority = 0;
+    };
+
+    /** Looks up a requestor, registering it if needed */
+    BatchState& getState(const RequestorID id);
+
+    /** Forms a new batch and ranks requestors within it */
+    void formBatch();
+
+    /** Maximum number of requests marked per requestor in a batch */
+    const unsigned markingCap;
+
+    /** Marked queue entries of the current batch not serviced yet */
+    uint64_t totalOutstanding;
+
+    /** Batch state of every requestor seen by the policy */
+    std::unordered_map<RequestorID, BatchState> batch;
+
+    ServiceStats serviceStats;
+};
+
+} // namespace qos
+} // namespace memory
+} // namespace gem5
+
+#endif // __MEM_QOS_POLICY_PARBS_HH__
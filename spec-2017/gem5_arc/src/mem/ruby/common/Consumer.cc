@@ -40,6 +40,8 @@
 
 #include "mem/ruby/common/Consumer.hh"
 
+#include "mem/ruby/system/ParallelWakeup.hh"
+
 namespace gem5
 {
 
@@ -55,6 +57,10 @@ Consumer::Consumer(ClockedObject *_em, Event::Priority ev_prio)
 void
 Consumer::scheduleEvent(Cycles timeDelta)
 {
+    if (ParallelWakeup::deferring()) {
+        ParallelWakeup::defer([this, timeDelta]{ scheduleEvent(timeDelta); });
+        return;
+    }
     m_wakeup_ticks.insert(em->clockEdge(timeDelta));
     scheduleNextWakeup();
 }
@@ -62,6 +68,11 @@ Consumer::scheduleEvent(Cycles timeDelta)
 void
 Consumer::scheduleEventAbsolute(Tick evt_time)
 {
+    if (ParallelWakeup::deferring()) {
+        ParallelWakeup::defer([this, evt_time]{
+            scheduleEventAbsolute(evt_time); });
+        return;
+    }
     m_wakeup_ticks.insert(
         divCeil(evt_time, em->clockPeriod()) * em->clockPeriod());
     scheduleNextWakeup();
@@ -91,9 +102,16 @@ Consumer::processCurrentEvent()
     // remove the current tick from the wakeup list, wake up, and then schedule
     // the next wakeup
     m_wakeup_ticks.erase(curr);
-    wakeup();
+    if (!m_parallel || !m_parallel->wakeup(this))
+        wakeup();
     scheduleNextWakeup();
 }
 
+bool
+Consumer::ranAhead() const
+{
+    return m_parallel && m_parallel->pending(this);
+}
+
 } // namespace ruby
 } // namespace gem5
@@ -58,6 +58,8 @@ namespace gem5
 namespace ruby
 {
 
+class ParallelWakeup;
+
 class Consumer
 {
   public:
@@ -87,11 +89,20 @@ class Consumer
     void scheduleEventAbsolute(Tick timeAbs);
     void scheduleEvent(Cycles timeDelta);
 
+    /** True while a wakeup that ran ahead in this tick awaits replay. */
+    bool ranAhead() const;
+
   private:
+    friend class ParallelWakeup;
+
     std::set<Tick> m_wakeup_ticks;
     EventFunctionWrapper m_wakeup_event;
     ClockedObject *em;
 
+    // Set when the wakeups may run ahead on a ParallelWakeup thread
+    ParallelWakeup *m_parallel = nullptr;
+    int m_parallel_id = -1;
+
     void scheduleNextWakeup();
     void processCurrentEvent();
 };
@@ -41,6 +41,7 @@
 #include "mem/ruby/common/DataBlock.hh"
 
 #include "mem/ruby/common/Address.hh"
+#include "mem/ruby/common/DataBlockKernels.hh"
 #include "mem/ruby/common/WriteMask.hh"
 
 namespace gem5
@@ -126,16 +127,24 @@ DataBlock::equal(const DataBlock& obj) const
     return true;
 }
 
+bool
+DataBlock::equal(const DataBlock& obj, const WriteMask &mask) const
+{
+    assert(m_alloc);
+    assert(m_block_size > 0);
+    assert(mask.getBlockSize() >= m_block_size);
+    return block_kernels::maskedEqual(m_data, obj.m_data, mask.getWords(),
+                                      m_block_size);
+}
+
 void
 DataBlock::copyPartial(const DataBlock &dblk, const WriteMask &mask)
 {
     assert(m_alloc);
     assert(m_block_size > 0);
-    for (int i = 0; i < m_block_size; i++) {
-        if (mask.getMask(i, 1)) {
-            m_data[i] = dblk.m_data[i];
-        }
-    }
+    assert(mask.getBlockSize() >= m_block_size);
+    block_kernels::maskedCopy(m_data, dblk.m_data, mask.getWords(),
+                              m_block_size);
 }
 
 void
@@ -144,9 +153,7 @@ DataBlock::atomicPartial(const DataBlock &dblk, const WriteMask &mask,
 {
     assert(m_alloc);
     assert(m_block_size > 0);
-    for (int i = 0; i < m_block_size; i++) {
-        m_data[i] = dblk.m_data[i];
-    }
+    memcpy(m_data, dblk.m_data, m_block_size);
     mask.performAtomic(m_data, m_atomicLog, isAtomicNoReturn);
 }
 
@@ -223,6 +230,9 @@ DataBlock::setData(PacketPtr pkt)
 DataBlock &
 DataBlock::operator=(const DataBlock & obj)
 {
+    if (this == &obj)
+        return *this;
+
     // Reallocate if needed
     if (m_alloc && m_block_size != obj.getBlockSize()) {
         delete [] m_data;
@@ -247,7 +257,9 @@ DataBlock::operator=(const DataBlock & obj)
     memcpy(m_data, obj.m_data, block_bytes);
     // If this data block is involved in an atomic operation, the effect
     // of applying the atomic operations on the data block are recorded in
-    // m_atomicLog. If so, we must copy over every entry in the change log
+    // m_atomicLog. If so, we must copy over every entry in the change log,
+    // replacing the entries of this block
+    clearAtomicLogEntries();
     for (size_t i = 0; i < obj.m_atomicLog.size(); i++) {
         block_update = new uint8_t[block_bytes];
         memcpy(block_update, obj.m_atomicLog[i], block_bytes);
@@ -105,6 +105,8 @@ class DataBlock
     void atomicPartial(const DataBlock & dblk, const WriteMask & mask,
             bool isAtomicNoReturn=true);
     bool equal(const DataBlock& obj) const;
+    /** Compare only the bytes selected by a mask */
+    bool equal(const DataBlock& obj, const WriteMask &mask) const;
     void print(std::ostream& out) const;
 
     int getBlockSize() const { return m_block_size; }
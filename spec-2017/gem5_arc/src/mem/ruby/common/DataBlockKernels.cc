@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2025 Boston University
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "mem/ruby/common/DataBlockKernels.hh"
+
+#include <cstring>
+
+#if GEM5_SIMD_HAVE_AVX2
+#include <immintrin.h>
+#endif
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+namespace block_kernels
+{
+
+namespace
+{
+
+/** Get the 8 mask bits of the bytes starting at offset, a multiple of 8 */
+inline uint8_t
+maskByte(const uint64_t *mask, std::size_t offset)
+{
+    return mask[offset / 64] >> (offset % 64);
+}
+
+namespace scalar
+{
+
+/** Turn 8 mask bits into a mask of 8 bytes, byte i set if bit i is */
+inline uint64_t
+expand(uint8_t bits)
+{
+    // Isolate bit i in byte i, then smear each byte's bit over the byte
+    const uint64_t select = 0x8040201008040201ULL;
+    const uint64_t isolated = (bits * 0x0101010101010101ULL) & select;
+    const uint64_t high =
+        ((isolated + 0x7f7f7f7f7f7f7f7fULL) | isolated) &
+        0x8080808080808080ULL;
+    return (high >> 7) * 0xff;
+}
+
+inline uint64_t
+load(const uint8_t *p)
+{
+    uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+void
+maskedCopy(uint8_t *dst, const uint8_t *src, const uint64_t *mask,
+    std::size_t begin, std::size_t size)
+{
+    std::size_t i = begin;
+    for (; i + 8 <= size; i += 8) {
+        const uint8_t bits = maskByte(mask, i);
+        if (bits == 0xff) {
+            std::memcpy(dst + i, src + i, 8);
+        } else if (bits) {
+            const uint64_t m = expand(bits);
+            const uint64_t v = (load(dst + i) & ~m) | (load(src + i) & m);
+            std::memcpy(dst + i, &v, 8);
+        }
+    }
+    for (; i < size; i++) {
+        if ((mask[i / 64] >> (i % 64)) & 1)
+            dst[i] = src[i];
+    }
+}
+
+bool
+maskedEqual(const uint8_t *a, const uint8_t *b, const uint64_t *mask,
+    std::size_t begin, std::size_t size)
+{
+    std::size_t i = begin;
+    uint64_t diff = 0;
+    for (; i + 8 <= size; i += 8) {
+        diff |= (load(a + i) ^ load(b + i)) & expand(maskByte(mask, i));
+    }
+    for (; i < size; i++) {
+        if ((mask[i / 64] >> (i % 64)) & 1)
+            diff |= a[i] ^ b[i];
+    }
+    return !diff;
+}
+
+} // namespace scalar
+
+#if GEM5_SIMD_HAVE_AVX2
+namespace avx2
+{
+
+/** Turn 32 mask bits into a mask of 32 bytes, byte i set if bit i is */
+GEM5_SIMD_AVX2 inline __m256i
+expand(uint32_t bits)
+{
+    // Byte i gets mask byte i / 8, and keeps bit i % 8 of it
+    const __m256i shuffle = _mm256_setr_epi8(
+        0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1,
+        2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3);
+    const __m256i select = _mm256_set1_epi64x(0x8040201008040201LL);
+    const __m256i spread =
+        _mm256_shuffle_epi8(_mm256_set1_epi32(bits), shuffle);
+    return _mm256_cmpeq_epi8(_mm256_and_si256(spread, select), select);
+}
+
+GEM5_SIMD_AVX2 void
+maskedCopy(uint8_t *dst, const uint8_t *src, const uint64_t *mask,
+    std::size_t size)
+{
+    std::size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        const uint32_t bits = mask[i / 64] >> (i % 64);
+        if (!bits)
+            continue;
+        const __m256i s = _mm256_loadu_si256((const __m256i *)(src + i));
+        if (bits != 0xffffffff) {
+            const __m256i d =
+                _mm256_loadu_si256((const __m256i *)(dst + i));
+            _mm256_storeu_si256((__m256i *)(dst + i),
+                _mm256_blendv_epi8(d, s, expand(bits)));
+        } else {
+            _mm256_storeu_si256((__m256i *)(dst + i), s);
+        }
+    }
+    scalar::maskedCopy(dst, src, mask, i, size);
+}
+
+GEM5_SIMD_AVX2 bool
+maskedEqual(const uint8_t *a, const uint8_t *b, const uint64_t *mask,
+    std::size_t size)
+{
+    std::size_t i = 0;
+    __m256i diff = _mm256_setzero_si256();
+    for (; i + 32 <= size; i += 32) {
+        const uint32_t bits = mask[i / 64] >> (i % 64);
+        const __m256i va = _mm256_loadu_si256((const __m256i *)(a + i));
+        const __m256i vb = _mm256_loadu_si256((const __m256i *)(b + i));
+        diff = _mm256_or_si256(diff,
+            _mm256_and_si256(_mm256_xor_si256(va, vb), expand(bits)));
+    }
+    return _mm256_testz_si256(diff, diff) &&
+        scalar::maskedEqual(a, b, mask, i, size);
+}
+
+} // namespace avx2
+#endif // GEM5_SIMD_HAVE_AVX2
+
+} // anonymous namespace
+
+void
+maskedCopy(uint8_t *dst, const uint8_t *src, const uint64_t *mask,
+    std::size_t size, Isa isa)
+{
+#if GEM5_SIMD_HAVE_AVX2
+    if (isa == Isa::AVX2) {
+        avx2::maskedCopy(dst, src, mask, size);
+        return;
+    }
+#endif
+    scalar::maskedCopy(dst, src, mask, 0, size);
+}
+
+bool
+maskedEqual(const uint8_t *a, const uint8_t *b, const uint64_t *mask,
+    std::size_t size, Isa isa)
+{
+#if GEM5_SIMD_HAVE_AVX2
+    if (isa == Isa::AVX2)
+        return avx2::maskedEqual(a, b, mask, size);
+#endif
+    return scalar::maskedEqual(a, b, mask, 0, size);
+}
+
+} // namespace block_kernels
+} // namespace ruby
+} // namespace gem5
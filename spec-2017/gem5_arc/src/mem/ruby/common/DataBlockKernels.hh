@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2025 Boston University
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef __MEM_RUBY_COMMON_DATABLOCKKERNELS_HH__
+#define __MEM_RUBY_COMMON_DATABLOCKKERNELS_HH__
+
+#include <cstddef>
+#include <cstdint>
+
+#include "base/simd.hh"
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+/**
+ * Masked operations on the bytes of a data block. The masks have one bit
+ * per byte, packed in 64-bit words as in WriteMask. Each operation has a
+ * scalar implementation, which works on 8 bytes at a time, and an AVX2
+ * one, selected at run time when the host supports it.
+ */
+namespace block_kernels
+{
+
+using simd::Isa;
+using simd::isSupported;
+using simd::bestIsa;
+
+/**
+ * Copy the bytes selected by a mask.
+ *
+ * @param dst Destination bytes.
+ * @param src Source bytes.
+ * @param mask Mask words, bit i selects byte i.
+ * @param size Number of bytes.
+ * @param isa Instruction set to use.
+ */
+void maskedCopy(uint8_t *dst, const uint8_t *src, const uint64_t *mask,
+    std::size_t size, Isa isa = bestIsa());
+
+/**
+ * Compare the bytes selected by a mask.
+ *
+ * @param a First bytes.
+ * @param b Second bytes.
+ * @param mask Mask words, bit i selects byte i.
+ * @param size Number of bytes.
+ * @param isa Instruction set to use.
+ * @return Whether all the selected bytes are equal.
+ */
+bool maskedEqual(const uint8_t *a, const uint8_t *b, const uint64_t *mask,
+    std::size_t size, Isa isa = bestIsa());
+
+} // namespace block_kernels
+} // namespace ruby
+} // namespace gem5
+
+#endif // __MEM_RUBY_COMMON_DATABLOCKKERNELS_HH__
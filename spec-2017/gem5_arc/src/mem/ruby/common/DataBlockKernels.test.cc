@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2025 Boston University
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "mem/ruby/common/DataBlockKernels.hh"
+
+using namespace gem5;
+using namespace gem5::ruby;
+
+namespace
+{
+
+/** Instruction sets to be checked, restricted to the ones the host has. */
+std::vector<block_kernels::Isa>
+supportedIsas()
+{
+    std::vector<block_kernels::Isa> isas;
+    for (auto isa : {block_kernels::Isa::Scalar, block_kernels::Isa::AVX2}) {
+        if (block_kernels::isSupported(isa)) {
+            isas.push_back(isa);
+        }
+    }
+    return isas;
+}
+
+bool
+maskBit(const std::vector<uint64_t> &mask, std::size_t i)
+{
+    return (mask[i / 64] >> (i % 64)) & 1;
+}
+
+/**
+ * Generate a mask with runs of set and cleared bytes, as left by stores
+ * of various sizes, with some empty and full words.
+ */
+std::vector<uint64_t>
+randomMask(std::mt19937_64 &rng, std::size_t size)
+{
+    std::vector<uint64_t> mask((size + 63) / 64, 0);
+    switch (rng() % 4) {
+      case 0:
+        return mask;
+      case 1:
+        for (std::size_t i = 0; i < size; i++)
+            mask[i / 64] |= uint64_t(1) << (i % 64);
+        return mask;
+      case 2:
+        for (auto &word : mask)
+            word = rng();
+        break;
+      default:
+        for (std::size_t i = 0; i < size; ) {
+            const std::size_t run = 1 << (rng() % 4);
+            const bool set = rng() % 2;
+            for (std::size_t j = i; j < i + run && j < size; j++) {
+                if (set)
+                    mask[j / 64] |= uint64_t(1) << (j % 64);
+            }
+            i += run;
+        }
+        break;
+    }
+    // Bits past the block are never set
+    if (size % 64)
+        mask.back() &= (uint64_t(1) << (size % 64)) - 1;
+    return mask;
+}
+
+std::vector<uint8_t>
+randomBytes(std::mt19937_64 &rng, std::size_t size)
+{
+    std::vector<uint8_t> bytes(size);
+    for (auto &byte : bytes)
+        byte = rng();
+    return bytes;
+}
+
+const std::vector<std::size_t> sizes = {8, 24, 32, 40, 64, 72, 128, 256};
+
+} // anonymous namespace
+
+TEST(DataBlockKernelsTest, MaskedCopy)
+{
+    std::mt19937_64 rng(1);
+    for (const auto size : sizes) {
+        for (int iter = 0; iter < 1000; iter++) {
+            const auto mask = randomMask(rng, size);
+            const auto src = randomBytes(rng, size);
+            const auto dst = randomBytes(rng, size);
+
+            std::vector<uint8_t> expected = dst;
+            for (std::size_t i = 0; i < size; i++) {
+                if (maskBit(mask, i))
+                    expected[i] = src[i];
+            }
+
+            for (auto isa : supportedIsas()) {
+                std::vector<uint8_t> result = dst;
+                block_kernels::maskedCopy(result.data(), src.data(),
+                    mask.data(), size, isa);
+                ASSERT_EQ(result, expected);
+            }
+        }
+    }
+}
+
+TEST(DataBlockKernelsTest, MaskedEqual)
+{
+    std::mt19937_64 rng(2);
+    for (const auto size : sizes) {
+        for (int iter = 0; iter < 1000; iter++) {
+            const auto mask = randomMask(rng, size);
+            const auto a = randomBytes(rng, size);
+            std::vector<uint8_t> b = a;
+            // Change a few bytes, selected or not
+            for (int n = rng() % 3; n > 0; n--)
+                b[rng() % size] ^= 1 << (rng() % 8);
+
+            bool expected = true;
+            for (std::size_t i = 0; i < size; i++) {
+                if (maskBit(mask, i) && a[i] != b[i])
+                    expected = false;
+            }
+
+            for (auto isa : supportedIsas()) {
+                ASSERT_EQ(block_kernels::maskedEqual(a.data(), b.data(),
+                    mask.data(), size, isa), expected);
+            }
+        }
+    }
+}
@@ -45,24 +45,19 @@ NetDest::NetDest()
 NetDest::NetDest(RubySystem *ruby_system)
     : m_ruby_system(ruby_system)
 {
-    resize();
 }
 
 void
 NetDest::add(MachineID newElement)
 {
-    assert(m_bits.size() > 0);
-    assert(bitIndex(newElement.num) < m_bits[vecIndex(newElement)].getSize());
-    m_bits[vecIndex(newElement)].add(bitIndex(newElement.num));
+    m_bits[wordIdx(newElement)] |= bitMask(newElement);
 }
 
 void
 NetDest::addNetDest(const NetDest& netDest)
 {
-    assert(m_bits.size() > 0);
-    assert(m_bits.size() == netDest.getSize());
-    for (int i = 0; i < m_bits.size(); i++) {
-        m_bits[i].addSet(netDest.m_bits[i]);
+    for (int i = 0; i < NumWords; i++) {
+        m_bits[i] |= netDest.m_bits[i];
     }
 }
 
@@ -71,36 +66,29 @@ NetDest::setNetDest(MachineType machine, const Set& set)
 {
     assert(m_ruby_system != nullptr);
 
-    // assure that there is only one set of destinations for this machine
-    assert(MachineType_base_level((MachineType)(machine + 1)) -
-           MachineType_base_level(machine) == 1);
-    m_bits[MachineType_base_level(machine)] = set;
+    for (int i = 0; i < WordsPerType; i++) {
+        m_bits[machine * WordsPerType + i] = set.getWord(i);
+    }
 }
 
 void
 NetDest::remove(MachineID oldElement)
 {
-    assert(m_bits.size() > 0);
-    m_bits[vecIndex(oldElement)].remove(bitIndex(oldElement.num));
+    m_bits[wordIdx(oldElement)] &= ~bitMask(oldElement);
 }
 
 void
 NetDest::removeNetDest(const NetDest& netDest)
 {
-    assert(m_bits.size() > 0);
-    assert(m_bits.size() == netDest.getSize());
-    for (int i = 0; i < m_bits.size(); i++) {
-        m_bits[i].removeSet(netDest.m_bits[i]);
+    for (int i = 0; i < NumWords; i++) {
+        m_bits[i] &= ~netDest.m_bits[i];
     }
 }
 
 void
 NetDest::clear()
 {
-    assert(m_bits.size() > 0);
-    for (int i = 0; i < m_bits.size(); i++) {
-        m_bits[i].clear();
-    }
+    m_bits.fill(0);
 }
 
 void
@@ -117,9 +105,10 @@ NetDest::broadcast(MachineType machineType)
 {
     assert(m_ruby_system != nullptr);
 
-    for (NodeID i = 0; i < MachineType_base_count(machineType); i++) {
-        MachineID mach = {machineType, i};
-        add(mach);
+    Set all(MachineType_base_count(machineType));
+    all.broadcast();
+    for (int i = 0; i < WordsPerType; i++) {
+        m_bits[machineType * WordsPerType + i] |= all.getWord(i);
     }
 }
 
@@ -128,29 +117,21 @@ std::vector<NodeID>
 NetDest::getAllDest()
 {
     assert(m_ruby_system != nullptr);
-    assert(m_bits.size() > 0);
 
     std::vector<NodeID> dest;
-    dest.clear();
-    for (int i = 0; i < m_bits.size(); i++) {
-        for (int j = 0; j < m_bits[i].getSize(); j++) {
-            if (m_bits[i].isElement(j)) {
-                int id = MachineType_base_number((MachineType)i) + j;
-                dest.push_back((NodeID)id);
-            }
-        }
-    }
+    dest.reserve(count());
+    forEachElement([&](MachineID mach) {
+        dest.push_back(MachineType_base_number(mach.type) + mach.num);
+    });
     return dest;
 }
 
 int
 NetDest::count() const
 {
-    assert(m_bits.size() > 0);
-
     int counter = 0;
-    for (int i = 0; i < m_bits.size(); i++) {
-        counter += m_bits[i].count();
+    for (int i = 0; i < NumWords; i++) {
+        counter += popCount(m_bits[i]);
     }
     return counter;
 }
@@ -158,21 +139,17 @@ NetDest::count() const
 NodeID
 NetDest::elementAt(MachineID index)
 {
-    assert(m_bits.size() > 0);
-    return m_bits[vecIndex(index)].elementAt(bitIndex(index.num));
+    return isElement(index);
 }
 
 MachineID
 NetDest::smallestElement() const
 {
-    assert(m_bits.size() > 0);
-    assert(count() > 0);
-    for (int i = 0; i < m_bits.size(); i++) {
-        for (NodeID j = 0; j < m_bits[i].getSize(); j++) {
-            if (m_bits[i].isElement(j)) {
-                MachineID mach = {MachineType_from_base_level(i), j};
-                return mach;
-            }
+    for (int i = 0; i < NumWords; i++) {
+        if (m_bits[i]) {
+            return MachineID(MachineType(i / WordsPerType),
+                             (i % WordsPerType) * BitsPerWord +
+                             ctz64(m_bits[i]));
         }
     }
     panic("No smallest element of an empty set.");
@@ -181,14 +158,10 @@ NetDest::smallestElement() const
 MachineID
 NetDest::smallestElement(MachineType machine) const
 {
-    assert(m_bits.size() > 0);
-    assert(m_ruby_system != nullptr);
-
-    int size = m_bits[MachineType_base_level(machine)].getSize();
-    for (NodeID j = 0; j < size; j++) {
-        if (m_bits[MachineType_base_level(machine)].isElement(j)) {
-            MachineID mach = {machine, j};
-            return mach;
+    for (int i = 0; i < WordsPerType; i++) {
+        uint64_t word = m_bits[machine * WordsPerType + i];
+        if (word) {
+            return MachineID(machine, i * BitsPerWord + ctz64(word));
         }
     }
 
@@ -199,10 +172,16 @@ NetDest::smallestElement(MachineType machine) const
 bool
 NetDest::isBroadcast() const
 {
-    assert(m_bits.size() > 0);
-    for (int i = 0; i < m_bits.size(); i++) {
-        if (!m_bits[i].isBroadcast()) {
-            return false;
+    assert(m_ruby_system != nullptr);
+
+    for (MachineType machine = MachineType_FIRST;
+         machine < MachineType_NUM; ++machine) {
+        Set all(MachineType_base_count(machine));
+        all.broadcast();
+        for (int i = 0; i < WordsPerType; i++) {
+            if (m_bits[machine * WordsPerType + i] != all.getWord(i)) {
+                return false;
+            }
         }
     }
     return true;
@@ -212,9 +191,8 @@ NetDest::isBroadcast() const
 bool
 NetDest::isEmpty() const
 {
-    assert(m_bits.size() > 0);
-    for (int i = 0; i < m_bits.size(); i++) {
-        if (!m_bits[i].isEmpty()) {
+    for (int i = 0; i < NumWords; i++) {
+        if (m_bits[i]) {
             return false;
         }
     }
@@ -225,11 +203,9 @@ NetDest::isEmpty() const
 NetDest
 NetDest::OR(const NetDest& orNetDest) const
 {
-    assert(m_bits.size() > 0);
-    assert(m_bits.size() == orNetDest.getSize());
     NetDest result(m_ruby_system);
-    for (int i = 0; i < m_bits.size(); i++) {
-        result.m_bits[i] = m_bits[i].OR(orNetDest.m_bits[i]);
+    for (int i = 0; i < NumWords; i++) {
+        result.m_bits[i] = m_bits[i] | orNetDest.m_bits[i];
     }
     return result;
 }
@@ -238,37 +214,18 @@ NetDest::OR(const NetDest& orNetDest) const
 NetDest
 NetDest::AND(const NetDest& andNetDest) const
 {
-    assert(m_bits.size() > 0);
-    assert(m_bits.size() == andNetDest.getSize());
     NetDest result(m_ruby_system);
-    for (int i = 0; i < m_bits.size(); i++) {
-        result.m_bits[i] = m_bits[i].AND(andNetDest.m_bits[i]);
+    for (int i = 0; i < NumWords; i++) {
+        result.m_bits[i] = m_bits[i] & andNetDest.m_bits[i];
     }
     return result;
 }
 
-// Returns true if the intersection of the two sets is non-empty
-bool
-NetDest::intersectionIsNotEmpty(const NetDest& other_netDest) const
-{
-    assert(m_bits.size() > 0);
-    assert(m_bits.size() == other_netDest.getSize());
-    for (int i = 0; i < m_bits.size(); i++) {
-        if (!m_bits[i].intersectionIsEmpty(other_netDest.m_bits[i])) {
-            return true;
-        }
-    }
-    return false;
-}
-
 bool
 NetDest::isSuperset(const NetDest& test) const
 {
-    assert(m_bits.size() > 0);
-    assert(m_bits.size() == test.getSize());
-
-    for (int i = 0; i < m_bits.size(); i++) {
-        if (!m_bits[i].isSuperset(test.m_bits[i])) {
+    for (int i = 0; i < NumWords; i++) {
+        if (test.m_bits[i] & ~m_bits[i]) {
             return false;
         }
     }
@@ -278,8 +235,7 @@ NetDest::isSuperset(const NetDest& test) const
 bool
 NetDest::isElement(MachineID element) const
 {
-    assert(m_bits.size() > 0);
-    return ((m_bits[vecIndex(element)])).isElement(bitIndex(element.num));
+    return m_bits[wordIdx(element)] & bitMask(element);
 }
 
 void
@@ -287,23 +243,21 @@ NetDest::resize()
 {
     assert(m_ruby_system != nullptr);
 
-    m_bits.resize(MachineType_base_level(MachineType_NUM));
-    assert(m_bits.size() == MachineType_NUM);
-
-    for (int i = 0; i < m_bits.size(); i++) {
-        m_bits[i].setSize(MachineType_base_count((MachineType)i));
-    }
+    // The width is fixed at build time, and RubySystem makes sure every
+    // machine type fits in it when its controllers register.
+    clear();
 }
 
 void
 NetDest::print(std::ostream& out) const
 {
-    assert(m_bits.size() > 0);
-    out << "[NetDest (" << m_bits.size() << ") ";
+    out << "[NetDest (" << getSize() << ") ";
 
-    for (int i = 0; i < m_bits.size(); i++) {
-        for (int j = 0; j < m_bits[i].getSize(); j++) {
-            out << (bool) m_bits[i].isElement(j) << " ";
+    for (MachineType machine = MachineType_FIRST;
+         machine < MachineType_NUM; ++machine) {
+        int size = m_ruby_system ? MachineType_base_count(machine) : 0;
+        for (NodeID j = 0; j < size; j++) {
+            out << isElement(MachineID(machine, j)) << " ";
         }
         out << " - ";
     }
@@ -313,24 +267,18 @@ NetDest::print(std::ostream& out) const
 bool
 NetDest::isEqual(const NetDest& n) const
 {
-    assert(m_bits.size() > 0);
-    assert(m_bits.size() == n.m_bits.size());
-    for (unsigned int i = 0; i < m_bits.size(); ++i) {
-        if (!m_bits[i].isEqual(n.m_bits[i]))
-            return false;
-    }
-    return true;
+    return m_bits == n.m_bits;
 }
 
 int
-NetDest::MachineType_base_count(const MachineType& obj)
+NetDest::MachineType_base_count(const MachineType& obj) const
 {
     assert(m_ruby_system != nullptr);
     return m_ruby_system->MachineType_base_count(obj);
 }
 
 int
-NetDest::MachineType_base_number(const MachineType& obj)
+NetDest::MachineType_base_number(const MachineType& obj) const
 {
     assert(m_ruby_system != nullptr);
     return m_ruby_system->MachineType_base_number(obj);
@@ -29,9 +29,12 @@
 #ifndef __MEM_RUBY_COMMON_NETDEST_HH__
 #define __MEM_RUBY_COMMON_NETDEST_HH__
 
+#include <array>
+#include <cstdint>
 #include <iostream>
 #include <vector>
 
+#include "base/bitfield.hh"
 #include "mem/ruby/common/Set.hh"
 #include "mem/ruby/common/MachineID.hh"
 
@@ -44,16 +47,23 @@ namespace ruby
 class RubySystem;
 
 // NetDest specifies the network destination of a Message
+//
+// The destinations are kept in a fixed-width bitset stored inline in the
+// object: every MachineType owns Set::NumWords 64-bit words, so the
+// width is fixed by the protocol and NUMBER_BITS_PER_SET at build time.
+// Copying a NetDest never allocates, and set operations work a word at a
+// time.
 class NetDest
 {
   public:
+    static constexpr int BitsPerWord = Set::BitsPerWord;
+    static constexpr int WordsPerType = Set::NumWords;
+    static constexpr int NumWords = MachineType_NUM * WordsPerType;
+
     // Constructors
     // creates and empty set
     NetDest();
     NetDest(RubySystem *ruby_system);
-    explicit NetDest(int bit_size);
-
-    NetDest& operator=(const Set& obj);
 
     ~NetDest()
     { }
@@ -76,10 +86,22 @@ class NetDest
     NetDest AND(const NetDest& andNetDest) const;
 
     // Returns true if the intersection of the two netDests is non-empty
-    bool intersectionIsNotEmpty(const NetDest& other_netDest) const;
+    bool
+    intersectionIsNotEmpty(const NetDest& other_netDest) const
+    {
+        for (int i = 0; i < NumWords; i++) {
+            if (m_bits[i] & other_netDest.m_bits[i])
+                return true;
+        }
+        return false;
+    }
 
     // Returns true if the intersection of the two netDests is empty
-    bool intersectionIsEmpty(const NetDest& other_netDest) const;
+    bool
+    intersectionIsEmpty(const NetDest& other_netDest) const
+    {
+        return !intersectionIsNotEmpty(other_netDest);
+    }
 
     bool isSuperset(const NetDest& test) const;
     bool isSubset(const NetDest& test) const { return test.isSuperset(*this); }
@@ -87,6 +109,23 @@ class NetDest
     bool isBroadcast() const;
     bool isEmpty() const;
 
+    /**
+     * Calls fn(MachineID) for every destination, in ascending order of
+     * machine type and then machine number. This visits only the set bits
+     * and does not allocate.
+     */
+    template <typename F>
+    void
+    forEachElement(F &&fn) const
+    {
+        for (int i = 0; i < NumWords; i++) {
+            for (uint64_t w = m_bits[i]; w; w &= w - 1) {
+                fn(MachineID(MachineType(i / WordsPerType),
+                             (i % WordsPerType) * BitsPerWord + ctz64(w)));
+            }
+        }
+    }
+
     // For Princeton Network
     std::vector<NodeID> getAllDest();
 
@@ -94,7 +133,7 @@ class NetDest
     MachineID smallestElement(MachineType machine) const;
 
     void resize();
-    int getSize() const { return m_bits.size(); }
+    int getSize() const { return MachineType_NUM; }
 
     // get element for a index
     NodeID elementAt(MachineID index);
@@ -104,25 +143,28 @@ class NetDest
     void setRubySystem(RubySystem *rs) { m_ruby_system = rs; resize(); }
 
   private:
-    // returns a value >= MachineType_base_level("this machine")
-    // and < MachineType_base_level("next highest machine")
-    int
-    vecIndex(MachineID m) const
+    // Index of the word holding machine m, and its mask within that word
+    static int
+    wordIdx(MachineID m)
     {
-        int vec_index = MachineType_base_level(m.type);
-        assert(vec_index < m_bits.size());
-        return vec_index;
+        assert(m.type < MachineType_NUM);
+        assert(m.num < NUMBER_BITS_PER_SET);
+        return m.type * WordsPerType + m.num / BitsPerWord;
     }
 
-    NodeID bitIndex(NodeID index) const { return index; }
+    static uint64_t
+    bitMask(MachineID m)
+    {
+        return uint64_t(1) << (m.num % BitsPerWord);
+    }
 
-    std::vector<Set> m_bits;  // a vector of bit vectors - i.e. Sets
+    std::array<uint64_t, NumWords> m_bits{};
 
     // Needed to call MacheinType_base_count/level
     RubySystem *m_ruby_system = nullptr;
 
-    int MachineType_base_count(const MachineType& obj);
-    int MachineType_base_number(const MachineType& obj);
+    int MachineType_base_count(const MachineType& obj) const;
+    int MachineType_base_number(const MachineType& obj) const;
 };
 
 inline std::ostream&
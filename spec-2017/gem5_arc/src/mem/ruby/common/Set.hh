@@ -32,10 +32,12 @@
 #ifndef __MEM_RUBY_COMMON_SET_HH__
 #define __MEM_RUBY_COMMON_SET_HH__
 
-#include <bitset>
+#include <array>
 #include <cassert>
+#include <cstdint>
 #include <iostream>
 
+#include "base/bitfield.hh"
 #include "base/logging.hh"
 #include "mem/ruby/common/TypeDefines.hh"
 
@@ -47,16 +49,28 @@ namespace ruby
 
 class Set
 {
+  public:
+    static constexpr int BitsPerWord = 64;
+    static constexpr int NumWords =
+        (NUMBER_BITS_PER_SET + BitsPerWord - 1) / BitsPerWord;
+
   private:
     // Number of bits in use in this set.
     // can be defined in build_opts file (default=64).
     int m_nSize;
-    std::bitset<NUMBER_BITS_PER_SET> bits;
+    // Bits at or above m_nSize are always zero.
+    std::array<uint64_t, NumWords> bits;
+
+    static int wordIdx(NodeID index) { return index / BitsPerWord; }
+    static uint64_t bitMask(NodeID index)
+    {
+        return uint64_t(1) << (index % BitsPerWord);
+    }
 
   public:
-    Set() : m_nSize(0) {}
+    Set() : m_nSize(0), bits{} {}
 
-    Set(int size) : m_nSize(size)
+    Set(int size) : m_nSize(size), bits{}
     {
         if (size > NUMBER_BITS_PER_SET)
             fatal("Number of bits(%d) < size specified(%d). "
@@ -64,20 +78,16 @@ class Set
                   NUMBER_BITS_PER_SET, size);
     }
 
-    Set(const Set& obj) : m_nSize(obj.m_nSize), bits(obj.bits) {}
+    Set(const Set& obj) = default;
     ~Set() {}
 
-    Set& operator=(const Set& obj)
-    {
-        m_nSize = obj.m_nSize;
-        bits = obj.bits;
-        return *this;
-    }
+    Set& operator=(const Set& obj) = default;
 
     void
     add(NodeID index)
     {
-        bits.set(index);
+        assert(index < NUMBER_BITS_PER_SET);
+        bits[wordIdx(index)] |= bitMask(index);
     }
 
     /*
@@ -88,7 +98,8 @@ class Set
     addSet(const Set& obj)
     {
         assert(m_nSize == obj.m_nSize);
-        bits |= obj.bits;
+        for (int i = 0; i < NumWords; i++)
+            bits[i] |= obj.bits[i];
     }
 
     /*
@@ -97,7 +108,8 @@ class Set
     void
     remove(NodeID index)
     {
-        bits.reset(index);
+        assert(index < NUMBER_BITS_PER_SET);
+        bits[wordIdx(index)] &= ~bitMask(index);
     }
 
     /*
@@ -107,26 +119,32 @@ class Set
     removeSet(const Set& obj)
     {
         assert(m_nSize == obj.m_nSize);
-        bits &= (~obj.bits);
+        for (int i = 0; i < NumWords; i++)
+            bits[i] &= ~obj.bits[i];
     }
 
-    void clear() { bits.reset(); }
+    void clear() { bits.fill(0); }
 
     /*
      * this function sets all bits in the set
      */
     void broadcast()
     {
-        bits.set();
-        for (int j = m_nSize; j < NUMBER_BITS_PER_SET; ++j) {
-            bits.reset(j);
-        }
+        for (int i = 0; i < NumWords; i++)
+            bits[i] = wordMask(i);
     }
 
     /*
      * This function returns the population count of 1's in the set
      */
-    int count() const { return bits.count(); }
+    int
+    count() const
+    {
+        int c = 0;
+        for (int i = 0; i < NumWords; i++)
+            c += popCount(bits[i]);
+        return c;
+    }
 
     /*
      * This function checks for set equality
@@ -144,7 +162,8 @@ class Set
     {
         assert(m_nSize == obj.m_nSize);
         Set r(m_nSize);
-        r.bits = bits | obj.bits;
+        for (int i = 0; i < NumWords; i++)
+            r.bits[i] = bits[i] | obj.bits[i];
         return r;
     };
 
@@ -154,7 +173,8 @@ class Set
     {
         assert(m_nSize == obj.m_nSize);
         Set r(m_nSize);
-        r.bits = bits & obj.bits;
+        for (int i = 0; i < NumWords; i++)
+            r.bits[i] = bits[i] & obj.bits[i];
         return r;
     }
 
@@ -162,8 +182,11 @@ class Set
     bool
     intersectionIsEmpty(const Set& obj) const
     {
-        std::bitset<NUMBER_BITS_PER_SET> r = bits & obj.bits;
-        return r.none();
+        for (int i = 0; i < NumWords; i++) {
+            if (bits[i] & obj.bits[i])
+                return false;
+        }
+        return true;
     }
 
     /*
@@ -174,13 +197,21 @@ class Set
     isSuperset(const Set& test) const
     {
         assert(m_nSize == test.m_nSize);
-        std::bitset<NUMBER_BITS_PER_SET> r = bits | test.bits;
-        return (r == bits);
+        for (int i = 0; i < NumWords; i++) {
+            if (test.bits[i] & ~bits[i])
+                return false;
+        }
+        return true;
     }
 
     bool isSubset(const Set& test) const { return test.isSuperset(*this); }
 
-    bool isElement(NodeID element) const { return bits.test(element); }
+    bool
+    isElement(NodeID element) const
+    {
+        assert(element < NUMBER_BITS_PER_SET);
+        return bits[wordIdx(element)] & bitMask(element);
+    }
 
     /*
      * this function returns true iff all bits in use are set
@@ -188,25 +219,61 @@ class Set
     bool
     isBroadcast() const
     {
-        return (bits.count() == m_nSize);
+        return (count() == m_nSize);
     }
 
-    bool isEmpty() const { return bits.none(); }
+    bool
+    isEmpty() const
+    {
+        for (int i = 0; i < NumWords; i++) {
+            if (bits[i])
+                return false;
+        }
+        return true;
+    }
 
     NodeID smallestElement() const
     {
-        for (int i = 0; i < m_nSize; ++i) {
-            if (bits.test(i)) {
-                return i;
-            }
+        for (int i = 0; i < NumWords; i++) {
+            if (bits[i])
+                return i * BitsPerWord + ctz64(bits[i]);
         }
         panic("No smallest element of an empty set.");
     }
 
-    bool elementAt(int index) const { return bits[index]; }
+    /**
+     * Calls fn(NodeID) for every element of the set in ascending order.
+     * Only set bits are visited, so a sparse set costs one step per
+     * element rather than one per possible member.
+     */
+    template <typename F>
+    void
+    forEach(F &&fn) const
+    {
+        for (int i = 0; i < NumWords; i++) {
+            for (uint64_t w = bits[i]; w; w &= w - 1)
+                fn(NodeID(i * BitsPerWord + ctz64(w)));
+        }
+    }
+
+    bool elementAt(int index) const { return isElement(index); }
 
     int getSize() const { return m_nSize; }
 
+    /** Raw access to the idx-th 64-bit word of the set. */
+    uint64_t getWord(int idx) const { return bits[idx]; }
+    void setWord(int idx, uint64_t word) { bits[idx] = word & wordMask(idx); }
+
+    /** Mask of the bits of word idx that are in use. */
+    uint64_t
+    wordMask(int idx) const
+    {
+        int valid = m_nSize - idx * BitsPerWord;
+        if (valid >= BitsPerWord)
+            return ~uint64_t(0);
+        return valid > 0 ? mask(valid) : 0;
+    }
+
     void
     setSize(int size)
     {
@@ -215,12 +282,16 @@ class Set
                   "Increase the number of bits and recompile.\n",
                   NUMBER_BITS_PER_SET, size);
         m_nSize = size;
-        bits.reset();
+        clear();
     }
 
     void print(std::ostream& out) const
     {
-        out << "[Set (" << m_nSize << "): " << bits << "]";
+        // Same layout as printing a std::bitset: most significant first
+        out << "[Set (" << m_nSize << "): ";
+        for (int i = NUMBER_BITS_PER_SET - 1; i >= 0; i--)
+            out << (isElement(i) ? '1' : '0');
+        out << "]";
     }
 };
 
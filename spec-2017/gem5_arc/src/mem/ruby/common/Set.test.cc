@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2025 Boston University
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include "mem/ruby/common/Set.hh"
+
+using namespace gem5;
+using namespace gem5::ruby;
+
+namespace
+{
+
+/** A set filled at random and the bool vector it must match */
+struct SetAndModel
+{
+    Set set;
+    std::vector<bool> model;
+
+    SetAndModel(std::mt19937_64 &rng, int size)
+        : set(size), model(size, false)
+    {
+        for (int n = rng() % (size + 1); n > 0; n--) {
+            const NodeID id = rng() % size;
+            set.add(id);
+            model[id] = true;
+        }
+    }
+};
+
+} // anonymous namespace
+
+TEST(SetTest, AddRemoveCount)
+{
+    std::mt19937_64 rng(1);
+    for (int iter = 0; iter < 200; iter++) {
+        const int size = 1 + rng() % NUMBER_BITS_PER_SET;
+        SetAndModel s(rng, size);
+        int count = 0;
+        for (int i = 0; i < size; i++) {
+            ASSERT_EQ(s.set.isElement(i), s.model[i]);
+            count += s.model[i];
+        }
+        EXPECT_EQ(s.set.count(), count);
+        EXPECT_EQ(s.set.isEmpty(), count == 0);
+
+        for (int i = 0; i < size; i++)
+            s.set.remove(i);
+        EXPECT_TRUE(s.set.isEmpty());
+    }
+}
+
+TEST(SetTest, SmallestAndForEach)
+{
+    std::mt19937_64 rng(2);
+    for (int iter = 0; iter < 200; iter++) {
+        const int size = 1 + rng() % NUMBER_BITS_PER_SET;
+        SetAndModel s(rng, size);
+
+        std::vector<NodeID> expected;
+        for (int i = 0; i < size; i++) {
+            if (s.model[i])
+                expected.push_back(i);
+        }
+        std::vector<NodeID> visited;
+        s.set.forEach([&](NodeID id) { visited.push_back(id); });
+        EXPECT_EQ(visited, expected);
+
+        if (!expected.empty()) {
+            EXPECT_EQ(s.set.smallestElement(), expected.front());
+        }
+    }
+}
+
+TEST(SetTest, SetOperations)
+{
+    std::mt19937_64 rng(3);
+    for (int iter = 0; iter < 200; iter++) {
+        const int size = 1 + rng() % NUMBER_BITS_PER_SET;
+        SetAndModel a(rng, size);
+        SetAndModel b(rng, size);
+
+        Set both = a.set.AND(b.set);
+        Set either = a.set.OR(b.set);
+        Set only_a = a.set;
+        only_a.removeSet(b.set);
+        bool disjoint = true;
+        for (int i = 0; i < size; i++) {
+            ASSERT_EQ(both.isElement(i), a.model[i] && b.model[i]);
+            ASSERT_EQ(either.isElement(i), a.model[i] || b.model[i]);
+            ASSERT_EQ(only_a.isElement(i), a.model[i] && !b.model[i]);
+            disjoint &= !(a.model[i] && b.model[i]);
+        }
+        EXPECT_EQ(a.set.intersectionIsEmpty(b.set), disjoint);
+        EXPECT_TRUE(either.isSuperset(a.set));
+        EXPECT_TRUE(both.isSubset(b.set));
+    }
+}
+
+TEST(SetTest, Broadcast)
+{
+    for (int size = 1; size <= NUMBER_BITS_PER_SET; size++) {
+        Set s(size);
+        s.broadcast();
+        EXPECT_EQ(s.count(), size);
+        EXPECT_TRUE(s.isBroadcast());
+        for (int i = size; i < NUMBER_BITS_PER_SET; i++)
+            ASSERT_FALSE(s.isElement(i));
+    }
+}
+
+TEST(SetTest, Print)
+{
+    Set s(4);
+    s.add(0);
+    s.add(2);
+    std::ostringstream os;
+    s.print(os);
+    EXPECT_EQ(os.str(), "[Set (4): " +
+        std::string(NUMBER_BITS_PER_SET - 3, '0') + "101]");
+}
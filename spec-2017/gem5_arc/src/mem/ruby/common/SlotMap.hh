@@ -0,0 +1,357 @@
+/*
+ * Copyright (c) 2025 Boston University
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef __MEM_RUBY_COMMON_SLOTMAP_HH__
+#define __MEM_RUBY_COMMON_SLOTMAP_HH__
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "base/intmath.hh"
+#include "mem/ruby/common/Address.hh"
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+/**
+ * A pool of slots holding objects of type T, identified by their index.
+ * The slots are created up front by reserve(), so allocating and
+ * releasing objects only constructs and destroys them in place. An
+ * object never moves while it is allocated, even if the pool has to
+ * grow past its reserved capacity; growing is counted as an overflow.
+ */
+template <class T>
+class SlotPool
+{
+  public:
+    explicit SlotPool(int capacity = 0) { reserve(capacity); }
+
+    SlotPool(const SlotPool &) = delete;
+    SlotPool &operator=(const SlotPool &) = delete;
+
+    /** Make sure there are slots for at least n objects. */
+    void
+    reserve(int n)
+    {
+        while (capacity() < n)
+            addSlot();
+    }
+
+    /** Construct an object in a free slot and return the slot index. */
+    template <class... Args>
+    int
+    allocate(Args&&... args)
+    {
+        if (m_free_head < 0) {
+            m_overflows++;
+            addSlot();
+        }
+        const int id = m_free_head;
+        Slot &slot = m_slots[id];
+        m_free_head = slot.nextFree;
+        slot.value.emplace(std::forward<Args>(args)...);
+        m_size++;
+        return id;
+    }
+
+    /** Destroy the object in a slot and make the slot free. */
+    void
+    release(int id)
+    {
+        Slot &slot = m_slots[id];
+        assert(slot.value);
+        slot.value.reset();
+        slot.nextFree = m_free_head;
+        m_free_head = id;
+        m_size--;
+    }
+
+    T &operator[](int id) { return *m_slots[id].value; }
+    const T &operator[](int id) const { return *m_slots[id].value; }
+
+    bool isAllocated(int id) const { return m_slots[id].value.has_value(); }
+
+    /** Number of allocated objects. */
+    int size() const { return m_size; }
+
+    /** Number of slots, allocated or not. */
+    int capacity() const { return m_slots.size(); }
+
+    /** Number of times the pool grew past the reserved capacity. */
+    uint64_t overflows() const { return m_overflows; }
+
+  private:
+    struct Slot
+    {
+        Slot(int next_free) : nextFree(next_free) {}
+
+        std::optional<T> value;
+        int nextFree;
+    };
+
+    void
+    addSlot()
+    {
+        // Slots are added at the back of a deque, which leaves the
+        // other slots where they are
+        m_slots.emplace_back(m_free_head);
+        m_free_head = m_slots.size() - 1;
+    }
+
+    std::deque<Slot> m_slots;
+    int m_free_head = -1;
+    int m_size = 0;
+    uint64_t m_overflows = 0;
+};
+
+/**
+ * A map from addresses to objects of type T, meant for tables with a
+ * known bound on their number of entries such as TBE and request tables.
+ * The entries live in a SlotPool and an open-addressing index with
+ * linear probing maps addresses to slots. The index is kept at most half
+ * full, so once the table has been reserved for its bound, inserting and
+ * erasing entries does not allocate memory. Pointers to entries stay
+ * valid until the entries are erased.
+ *
+ * Iterating visits the entries as std::pair<const Addr, T>, in slot
+ * order.
+ */
+template <class T>
+class SlotMap
+{
+  public:
+    typedef std::pair<const Addr, T> value_type;
+
+  private:
+    typedef SlotPool<value_type> Pool;
+
+    template <class Map, class Value>
+    class Iterator
+    {
+      public:
+        Iterator(Map *map, int id) : m_map(map), m_id(id) { skip(); }
+
+        Value &operator*() const { return m_map->m_pool[m_id]; }
+        Value *operator->() const { return &m_map->m_pool[m_id]; }
+
+        Iterator &
+        operator++()
+        {
+            m_id++;
+            skip();
+            return *this;
+        }
+
+        bool operator==(const Iterator &o) const { return m_id == o.m_id; }
+        bool operator!=(const Iterator &o) const { return m_id != o.m_id; }
+
+      private:
+        void
+        skip()
+        {
+            while (m_id < m_map->m_pool.capacity() &&
+                   !m_map->m_pool.isAllocated(m_id)) {
+                m_id++;
+            }
+        }
+
+        Map *m_map;
+        int m_id;
+    };
+
+  public:
+    typedef Iterator<SlotMap, value_type> iterator;
+    typedef Iterator<const SlotMap, const value_type> const_iterator;
+
+    explicit SlotMap(int capacity = 0) { reserve(capacity); }
+
+    /** Preallocate the slots and index for capacity entries. */
+    void
+    reserve(int capacity)
+    {
+        m_pool.reserve(capacity);
+        if (int(m_index.size()) < 2 * capacity)
+            rebuildIndex(2 * capacity);
+    }
+
+    int size() const { return m_pool.size(); }
+    bool empty() const { return m_pool.size() == 0; }
+
+    /** Number of entries the table holds without allocating. */
+    int capacity() const { return m_pool.capacity(); }
+
+    /** Number of times the table grew past the reserved capacity. */
+    uint64_t overflows() const { return m_pool.overflows(); }
+
+    T *
+    find(Addr addr)
+    {
+        const int pos = position(addr);
+        return m_index[pos] < 0 ? nullptr : &m_pool[m_index[pos]].second;
+    }
+
+    const T *
+    find(Addr addr) const
+    {
+        const int pos = position(addr);
+        return m_index[pos] < 0 ? nullptr : &m_pool[m_index[pos]].second;
+    }
+
+    bool contains(Addr addr) const { return find(addr) != nullptr; }
+
+    /** Insert an entry for an address that is not in the table. */
+    template <class... Args>
+    T &
+    emplace(Addr addr, Args&&... args)
+    {
+        assert(!contains(addr));
+        return insert(addr, std::forward<Args>(args)...);
+    }
+
+    /**
+     * Return the entry for an address, inserting one constructed from
+     * args if there is none.
+     */
+    template <class... Args>
+    T &
+    tryEmplace(Addr addr, Args&&... args)
+    {
+        T *entry = find(addr);
+        return entry ? *entry : insert(addr, std::forward<Args>(args)...);
+    }
+
+    /** Erase the entry for an address, if there is one. */
+    void
+    erase(Addr addr)
+    {
+        int pos = position(addr);
+        if (m_index[pos] < 0)
+            return;
+        m_pool.release(m_index[pos]);
+        m_index[pos] = -1;
+
+        // Backward-shift deletion: move up the following entries of the
+        // probe sequence that would no longer be found across the hole
+        const int mask = m_index.size() - 1;
+        for (int next = (pos + 1) & mask; m_index[next] >= 0;
+             next = (next + 1) & mask) {
+            const int home = hash(m_pool[m_index[next]].first);
+            if (((next - home) & mask) >= ((next - pos) & mask)) {
+                m_index[pos] = m_index[next];
+                m_index[next] = -1;
+                pos = next;
+            }
+        }
+    }
+
+    void
+    clear()
+    {
+        for (auto &id : m_index) {
+            if (id >= 0) {
+                m_pool.release(id);
+                id = -1;
+            }
+        }
+    }
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, m_pool.capacity()); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator
+    end() const
+    {
+        return const_iterator(this, m_pool.capacity());
+    }
+
+  private:
+    int
+    hash(Addr addr) const
+    {
+        // Fibonacci hashing keeps the high bits of the product, which
+        // depend on all the bits of the address, line offset or not
+        return (uint64_t(addr) * 0x9e3779b97f4a7c15ULL) >> m_hash_shift;
+    }
+
+    /** Slot of the index holding addr, or the empty slot ending its probe */
+    int
+    position(Addr addr) const
+    {
+        const int mask = m_index.size() - 1;
+        int pos = hash(addr);
+        while (m_index[pos] >= 0 && m_pool[m_index[pos]].first != addr)
+            pos = (pos + 1) & mask;
+        return pos;
+    }
+
+    template <class... Args>
+    T &
+    insert(Addr addr, Args&&... args)
+    {
+        if (2 * (m_pool.size() + 1) > int(m_index.size()))
+            rebuildIndex(2 * (m_pool.size() + 1));
+        const int id = m_pool.allocate(std::piecewise_construct,
+                                       std::forward_as_tuple(addr),
+                                       std::forward_as_tuple(
+                                           std::forward<Args>(args)...));
+        m_index[position(addr)] = id;
+        return m_pool[id].second;
+    }
+
+    void
+    rebuildIndex(int min_size)
+    {
+        const int size = 1 << ceilLog2(std::max(8, min_size));
+        std::vector<int> old_index(size, -1);
+        old_index.swap(m_index);
+        m_hash_shift = 64 - floorLog2(size);
+        for (int id : old_index) {
+            if (id >= 0)
+                m_index[position(m_pool[id].first)] = id;
+        }
+    }
+
+    Pool m_pool;
+    std::vector<int> m_index = std::vector<int>(8, -1);
+    int m_hash_shift = 61;
+};
+
+} // namespace ruby
+} // namespace gem5
+
+#endif // __MEM_RUBY_COMMON_SLOTMAP_HH__
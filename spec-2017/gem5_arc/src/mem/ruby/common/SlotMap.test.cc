@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2025 Boston University
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <map>
+#include <random>
+
+#include "mem/ruby/common/SlotMap.hh"
+
+using namespace gem5;
+using namespace gem5::ruby;
+
+TEST(SlotMapTest, EmplaceFindErase)
+{
+    SlotMap<int> map(4);
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.capacity(), 4);
+
+    map.emplace(0x40, 1);
+    map.emplace(0x80, 2);
+    EXPECT_EQ(map.size(), 2);
+    ASSERT_NE(map.find(0x40), nullptr);
+    EXPECT_EQ(*map.find(0x40), 1);
+    EXPECT_EQ(*map.find(0x80), 2);
+    EXPECT_EQ(map.find(0xc0), nullptr);
+
+    map.erase(0x40);
+    EXPECT_FALSE(map.contains(0x40));
+    EXPECT_TRUE(map.contains(0x80));
+    map.erase(0x40);
+    EXPECT_EQ(map.size(), 1);
+}
+
+TEST(SlotMapTest, TryEmplaceKeepsExistingEntry)
+{
+    SlotMap<int> map(2);
+    EXPECT_EQ(map.tryEmplace(0x100, 5), 5);
+    EXPECT_EQ(map.tryEmplace(0x100, 6), 5);
+    EXPECT_EQ(map.size(), 1);
+}
+
+/** Entries do not move while other entries come and go. */
+TEST(SlotMapTest, StablePointers)
+{
+    SlotMap<int> map(4);
+    int *first = &map.emplace(0x1000, 1);
+    for (Addr a = 0; a < 64; a++) {
+        map.emplace(a * 64, int(a));
+        map.erase(a * 64);
+    }
+    EXPECT_EQ(map.find(0x1000), first);
+    EXPECT_EQ(*first, 1);
+}
+
+/** Within the reserved capacity the table does not grow. */
+TEST(SlotMapTest, NoOverflowWithinCapacity)
+{
+    SlotMap<int> map(16);
+    for (int round = 0; round < 100; round++) {
+        for (int i = 0; i < 16; i++)
+            map.emplace((round * 16 + i) * 64, i);
+        for (int i = 0; i < 16; i++)
+            map.erase((round * 16 + i) * 64);
+    }
+    EXPECT_EQ(map.overflows(), 0u);
+    EXPECT_EQ(map.capacity(), 16);
+}
+
+/** Past the reserved capacity the table grows and keeps working. */
+TEST(SlotMapTest, GrowsPastCapacity)
+{
+    SlotMap<int> map(2);
+    int *first = &map.emplace(0, 0);
+    for (int i = 1; i < 100; i++)
+        map.emplace(i * 64, i);
+    EXPECT_EQ(map.size(), 100);
+    EXPECT_GT(map.overflows(), 0u);
+    EXPECT_EQ(map.find(0), first);
+    for (int i = 0; i < 100; i++)
+        EXPECT_EQ(*map.find(i * 64), i);
+}
+
+TEST(SlotMapTest, Iterate)
+{
+    SlotMap<int> map(8);
+    map.emplace(0x40, 1);
+    map.emplace(0x80, 2);
+    map.emplace(0xc0, 3);
+    map.erase(0x80);
+
+    std::map<Addr, int> seen;
+    for (const auto &entry : map)
+        seen[entry.first] = entry.second;
+    EXPECT_EQ(seen, (std::map<Addr, int>{{0x40, 1}, {0xc0, 3}}));
+}
+
+/** Random inserts and erases, including colliding ones, against std::map */
+TEST(SlotMapTest, MatchesReference)
+{
+    std::mt19937_64 rng(1);
+    SlotMap<uint64_t> map(32);
+    std::map<Addr, uint64_t> ref;
+    for (int i = 0; i < 100000; i++) {
+        // Few distinct addresses, so probe sequences overlap a lot
+        const Addr addr = (rng() % 64) * 64;
+        if (ref.count(addr)) {
+            EXPECT_EQ(*map.find(addr), ref[addr]);
+            map.erase(addr);
+            ref.erase(addr);
+        } else if (ref.size() < 32) {
+            const uint64_t value = rng();
+            map.emplace(addr, value);
+            ref[addr] = value;
+        }
+        ASSERT_EQ(map.size(), int(ref.size()));
+    }
+    for (const auto &[addr, value] : ref)
+        EXPECT_EQ(*map.find(addr), value);
+    EXPECT_EQ(map.overflows(), 0u);
+}
@@ -39,7 +39,7 @@ namespace ruby
 {
 
 WriteMask::WriteMask()
-    : mSize(0), mMask(mSize, false), mAtomic(false)
+    : mSize(0), mMask{}, mAtomic(false)
 {}
 
 void
@@ -48,7 +48,7 @@ WriteMask::print(std::ostream& out) const
     assert(mSize > 0);
     std::string str(mSize,'0');
     for (int i = 0; i < mSize; i++) {
-        str[i] = mMask[i] ? ('1') : ('0');
+        str[i] = test(i) ? ('1') : ('0');
     }
     out << "dirty mask="
         << str
@@ -41,12 +41,17 @@
 #ifndef __MEM_RUBY_COMMON_WRITEMASK_HH__
 #define __MEM_RUBY_COMMON_WRITEMASK_HH__
 
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <cstdint>
 #include <iomanip>
 #include <iostream>
 #include <vector>
 
 #include "base/amo.hh"
+#include "base/bitfield.hh"
+#include "base/intmath.hh"
 #include "mem/ruby/common/DataBlock.hh"
 #include "mem/ruby/common/TypeDefines.hh"
 
@@ -56,24 +61,43 @@ namespace gem5
 namespace ruby
 {
 
+/**
+ * Mask of the bytes of a block written by a request. The mask is kept as
+ * a fixed array of 64-bit words, one bit per byte, so that masks can be
+ * combined a word at a time and copied without heap allocations. Bits
+ * past the block size are always zero.
+ */
 class WriteMask
 {
   public:
     typedef std::vector<std::pair<int, AtomicOpFunctor* >> AtomicOpVector;
 
+    /** Largest block size, in bytes, that a mask can cover */
+    static constexpr int MaxBlockSize = 256;
+    static constexpr int BitsPerWord = 64;
+    static constexpr int MaxWords = MaxBlockSize / BitsPerWord;
+
     WriteMask();
 
     WriteMask(int size)
-      : mSize(size), mMask(size, false), mAtomic(false)
-    {}
+      : mSize(size), mMask{}, mAtomic(false)
+    {
+        assert(size <= MaxBlockSize);
+    }
 
     WriteMask(int size, std::vector<bool> & mask)
-      : mSize(size), mMask(mask), mAtomic(false)
-    {}
+      : WriteMask(size)
+    {
+        setFromVector(mask);
+    }
 
     WriteMask(int size, std::vector<bool> &mask, AtomicOpVector atomicOp)
-      : mSize(size), mMask(mask), mAtomic(true), mAtomicOp(atomicOp)
-    {}
+      : WriteMask(size)
+    {
+        setFromVector(mask);
+        mAtomic = true;
+        mAtomicOp = atomicOp;
+    }
 
     ~WriteMask()
     {}
@@ -86,6 +110,7 @@ class WriteMask
         // by src/mem/ruby/protocol/RubySlicc_MemControl.sm.
         assert(mSize == 0);
         assert(size > 0);
+        assert(size <= MaxBlockSize);
         mSize = size;
         clear();
     }
@@ -93,7 +118,7 @@ class WriteMask
     void
     clear()
     {
-        mMask = std::vector<bool>(mSize, false);
+        mMask.fill(0);
     }
 
     bool
@@ -101,7 +126,7 @@ class WriteMask
     {
         assert(mSize > 0);
         assert(offset < mSize);
-        return mMask[offset];
+        return bits(mMask[offset / BitsPerWord], offset % BitsPerWord);
     }
 
     void
@@ -109,78 +134,80 @@ class WriteMask
     {
         assert(mSize > 0);
         assert(mSize >= (offset + len));
-        for (int i = 0; i < len; i++) {
-            mMask[offset + i] = val;
+        while (len > 0) {
+            const int bit = offset % BitsPerWord;
+            const int n = std::min(len, BitsPerWord - bit);
+            const uint64_t field = mask(n) << bit;
+            if (val)
+                mMask[offset / BitsPerWord] |= field;
+            else
+                mMask[offset / BitsPerWord] &= ~field;
+            offset += n;
+            len -= n;
         }
     }
     void
     fillMask()
     {
         assert(mSize > 0);
-        for (int i = 0; i < mSize; i++) {
-            mMask[i] = true;
-        }
+        setMask(0, mSize);
     }
 
     bool
     getMask(int offset, int len) const
     {
-        bool tmp = true;
         assert(mSize > 0);
         assert(mSize >= (offset + len));
-        for (int i = 0; i < len; i++) {
-            tmp = tmp & mMask.at(offset + i);
+        while (len > 0) {
+            const int bit = offset % BitsPerWord;
+            const int n = std::min(len, BitsPerWord - bit);
+            const uint64_t field = mask(n) << bit;
+            if ((mMask[offset / BitsPerWord] & field) != field)
+                return false;
+            offset += n;
+            len -= n;
         }
-        return tmp;
+        return true;
     }
 
     bool
     isOverlap(const WriteMask &readMask) const
     {
-        bool tmp = false;
         assert(mSize > 0);
         assert(mSize == readMask.mSize);
-        for (int i = 0; i < mSize; i++) {
-            if (readMask.mMask.at(i)) {
-                tmp = tmp | mMask.at(i);
-            }
-        }
-        return tmp;
+        uint64_t overlap = 0;
+        for (int i = 0; i < numWords(); i++)
+            overlap |= mMask[i] & readMask.mMask[i];
+        return overlap;
     }
 
     bool
     containsMask(const WriteMask &readMask) const
     {
-        bool tmp = true;
         assert(mSize > 0);
         assert(mSize == readMask.mSize);
-        for (int i = 0; i < mSize; i++) {
-            if (readMask.mMask.at(i)) {
-                tmp = tmp & mMask.at(i);
-            }
-        }
-        return tmp;
+        uint64_t missing = 0;
+        for (int i = 0; i < numWords(); i++)
+            missing |= readMask.mMask[i] & ~mMask[i];
+        return !missing;
     }
 
     bool isEmpty() const
     {
         assert(mSize > 0);
-        for (int i = 0; i < mSize; i++) {
-            if (mMask.at(i)) {
-                return false;
-            }
-        }
-        return true;
+        uint64_t set = 0;
+        for (int i = 0; i < numWords(); i++)
+            set |= mMask[i];
+        return !set;
     }
 
     bool
     isFull() const
     {
         assert(mSize > 0);
-        for (int i = 0; i < mSize; i++) {
-            if (!mMask.at(i)) {
+        for (int i = 0; i < numWords(); i++) {
+            if (mMask[i] != wordMask(i))
                 return false;
-            }
         }
         return true;
     }
@@ -190,9 +217,8 @@ class WriteMask
     {
         assert(mSize > 0);
         assert(mSize == writeMask.mSize);
-        for (int i = 0; i < mSize; i++) {
-            mMask[i] = (mMask.at(i)) && (writeMask.mMask.at(i));
-        }
+        for (int i = 0; i < numWords(); i++)
+            mMask[i] &= writeMask.mMask[i];
 
         if (writeMask.mAtomic) {
             mAtomic = true;
@@ -205,9 +231,8 @@ class WriteMask
     {
         assert(mSize > 0);
         assert(mSize == writeMask.mSize);
-        for (int i = 0; i < mSize; i++) {
-            mMask[i] = (mMask.at(i)) || (writeMask.mMask.at(i));
-        }
+        for (int i = 0; i < numWords(); i++)
+            mMask[i] |= writeMask.mMask[i];
 
         if (writeMask.mAtomic) {
             mAtomic = true;
@@ -220,18 +245,21 @@ class WriteMask
     {
         assert(mSize > 0);
         assert(mSize == writeMask.mSize);
-        for (int i = 0; i < mSize; i++) {
-            mMask[i] = !writeMask.mMask.at(i);
-        }
+        for (int i = 0; i < numWords(); i++)
+            mMask[i] = ~writeMask.mMask[i] & wordMask(i);
     }
 
     int
     firstBitSet(bool val, int offset = 0) const
     {
         assert(mSize > 0);
-        for (int i = offset; i < mSize; ++i)
-            if (mMask[i] == val)
-                return i;
+        for (int i = offset / BitsPerWord; i < numWords(); i++) {
+            uint64_t word = (val ? mMask[i] : ~mMask[i]) & wordMask(i);
+            if (i == offset / BitsPerWord)
+                word &= ~mask(offset % BitsPerWord);
+            if (word)
+                return i * BitsPerWord + ctz64(word);
+        }
         return mSize;
     }
 
@@ -240,11 +268,30 @@ class WriteMask
     {
         assert(mSize > 0);
         int count = 0;
-        for (int i = offset; i < mSize; ++i)
-            count += mMask[i];
+        for (int i = offset / BitsPerWord; i < numWords(); i++) {
+            uint64_t word = mMask[i];
+            if (i == offset / BitsPerWord)
+                word &= ~mask(offset % BitsPerWord);
+            count += popCount(word);
+        }
         return count;
     }
 
+    /**
+     * Get 64 bits of the mask, bit i being the byte at i + 64 * idx.
+     *
+     * @param idx Index of the word.
+     */
+    uint64_t
+    getWord(int idx) const
+    {
+        assert(idx < numWords());
+        return mMask[idx];
+    }
+
+    /** The mask as words, least significant bit first */
+    const uint64_t *getWords() const { return mMask.data(); }
+
     void print(std::ostream& out) const;
 
     /*
@@ -272,8 +319,28 @@ class WriteMask
     }
 
   private:
+    int numWords() const { return divCeil(mSize, BitsPerWord); }
+
+    /** Bits of a word that are within the block */
+    uint64_t
+    wordMask(int idx) const
+    {
+        const int valid = mSize - idx * BitsPerWord;
+        return valid >= BitsPerWord ? ~uint64_t(0) : mask(valid);
+    }
+
+    void
+    setFromVector(const std::vector<bool> &vec)
+    {
+        assert(vec.size() <= (size_t)mSize);
+        for (size_t i = 0; i < vec.size(); i++) {
+            if (vec[i])
+                mMask[i / BitsPerWord] |= uint64_t(1) << (i % BitsPerWord);
+        }
+    }
+
     int mSize;
-    std::vector<bool> mMask;
+    std::array<uint64_t, MaxWords> mMask;
     bool mAtomic;
     AtomicOpVector mAtomicOp;
 };
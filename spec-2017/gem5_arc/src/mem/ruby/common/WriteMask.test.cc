@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2025 Boston University
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "mem/ruby/common/WriteMask.hh"
+
+using namespace gem5;
+using namespace gem5::ruby;
+
+namespace
+{
+
+/** A mask and the byte by byte model it must match */
+struct MaskAndModel
+{
+    WriteMask mask;
+    std::vector<bool> model;
+
+    MaskAndModel(std::mt19937_64 &rng, int size)
+        : mask(size), model(size, false)
+    {
+        for (int n = rng() % 4; n > 0; n--) {
+            const int offset = rng() % size;
+            const int len = 1 + rng() % (size - offset);
+            const bool val = rng() % 4;
+            mask.setMask(offset, len, val);
+            for (int i = offset; i < offset + len; i++)
+                model[i] = val;
+        }
+    }
+
+    void
+    check() const
+    {
+        for (int i = 0; i < (int)model.size(); i++)
+            ASSERT_EQ(mask.test(i), model[i]) << "byte " << i;
+    }
+};
+
+const std::vector<int> sizes = {16, 64, 100, 128, 256};
+
+} // anonymous namespace
+
+TEST(WriteMaskTest, SetAndGet)
+{
+    std::mt19937_64 rng(1);
+    for (const int size : sizes) {
+        for (int iter = 0; iter < 500; iter++) {
+            MaskAndModel m(rng, size);
+            m.check();
+
+            const int offset = rng() % size;
+            const int len = 1 + rng() % (size - offset);
+            bool all = true;
+            for (int i = offset; i < offset + len; i++)
+                all = all && m.model[i];
+            ASSERT_EQ(m.mask.getMask(offset, len), all);
+
+            int count = 0;
+            for (int i = offset; i < size; i++)
+                count += m.model[i];
+            ASSERT_EQ(m.mask.count(offset), count);
+
+            for (const bool val : {false, true}) {
+                int first = offset;
+                while (first < size && m.model[first] != val)
+                    first++;
+                ASSERT_EQ(m.mask.firstBitSet(val, offset), first);
+            }
+
+            bool empty = true, full = true;
+            for (const bool bit : m.model) {
+                empty = empty && !bit;
+                full = full && bit;
+            }
+            ASSERT_EQ(m.mask.isEmpty(), empty);
+            ASSERT_EQ(m.mask.isFull(), full);
+        }
+
+        WriteMask mask(size);
+        mask.fillMask();
+        ASSERT_TRUE(mask.isFull());
+        ASSERT_EQ(mask.count(), size);
+        mask.clear();
+        ASSERT_TRUE(mask.isEmpty());
+    }
+}
+
+TEST(WriteMaskTest, Combine)
+{
+    std::mt19937_64 rng(2);
+    for (const int size : sizes) {
+        for (int iter = 0; iter < 500; iter++) {
+            MaskAndModel a(rng, size);
+            MaskAndModel b(rng, size);
+
+            bool overlap = false, contains = true;
+            for (int i = 0; i < size; i++) {
+                overlap = overlap || (a.model[i] && b.model[i]);
+                contains = contains && (!b.model[i] || a.model[i]);
+            }
+            ASSERT_EQ(a.mask.isOverlap(b.mask), overlap);
+            ASSERT_EQ(a.mask.containsMask(b.mask), contains);
+
+            MaskAndModel and_mask = a;
+            and_mask.mask.andMask(b.mask);
+            MaskAndModel or_mask = a;
+            or_mask.mask.orMask(b.mask);
+            MaskAndModel inverted = a;
+            inverted.mask.setInvertedMask(b.mask);
+            for (int i = 0; i < size; i++) {
+                and_mask.model[i] = a.model[i] && b.model[i];
+                or_mask.model[i] = a.model[i] || b.model[i];
+                inverted.model[i] = !b.model[i];
+            }
+            and_mask.check();
+            or_mask.check();
+            inverted.check();
+            // Bits past the block must not be set by the inversion
+            ASSERT_EQ(inverted.mask.count(),
+                      size - b.mask.count());
+        }
+    }
+}
+
+TEST(WriteMaskTest, FromVector)
+{
+    std::mt19937_64 rng(3);
+    for (const int size : sizes) {
+        std::vector<bool> bits(size);
+        for (int i = 0; i < size; i++)
+            bits[i] = rng() % 2;
+        WriteMask mask(size, bits);
+        for (int i = 0; i < size; i++)
+            ASSERT_EQ(mask.test(i), bits[i]);
+    }
+}
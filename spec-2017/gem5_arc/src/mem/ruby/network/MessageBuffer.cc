@@ -43,10 +43,12 @@
 #include <cassert>
 
 #include "base/cprintf.hh"
+#include "base/intmath.hh"
 #include "base/logging.hh"
 #include "base/random.hh"
 #include "base/stl_helpers.hh"
 #include "debug/RubyQueue.hh"
+#include "mem/ruby/system/ParallelWakeup.hh"
 
 namespace gem5
 {
@@ -57,7 +59,8 @@ namespace ruby
 using stl_helpers::operator<<;
 
 MessageBuffer::MessageBuffer(const Params &p)
-    : SimObject(p), m_stall_map_size(0), m_max_size(p.buffer_size),
+    : SimObject(p), m_tick_buckets(p.tick_buckets),
+    m_stall_map_size(0), m_max_size(p.buffer_size),
     m_max_dequeue_rate(p.max_dequeue_rate), m_dequeues_this_cy(0),
     m_time_last_time_size_checked(0),
     m_time_last_time_enqueue(0), m_time_last_time_pop(0),
@@ -92,7 +95,9 @@ MessageBuffer::MessageBuffer(const Params &p)
     m_msgs_this_cycle = 0;
     m_priority_rank = 0;
 
-    m_stall_msg_map.clear();
+    // A finite buffer cannot stall more messages than it holds
+    m_stall_msg_map.reserve(m_max_size);
+    m_stall_msgs.reserve(m_max_size);
     m_input_link_id = 0;
     m_vnet_id = 0;
 
@@ -137,7 +142,7 @@ MessageBuffer::getSize(Tick curTime)
 {
     if (m_time_last_time_size_checked != curTime) {
         m_time_last_time_size_checked = curTime;
-        m_size_last_time_size_checked = m_prio_heap.size();
+        m_size_last_time_size_checked = queueSize();
     }
 
     return m_size_last_time_size_checked;
@@ -161,7 +166,7 @@ MessageBuffer::areNSlotsAvailable(unsigned int n, Tick current_time)
 
     if (m_time_last_time_pop < current_time) {
         // no pops this cycle - heap and stall queue size is correct
-        current_size = m_prio_heap.size();
+        current_size = queueSize();
         current_stall_size = m_stall_map_size;
     } else {
         if (m_time_last_time_enqueue < current_time) {
@@ -184,7 +189,7 @@ MessageBuffer::areNSlotsAvailable(unsigned int n, Tick current_time)
         DPRINTF(RubyQueue, "n: %d, current_size: %d, heap size: %d, "
                 "m_max_size: %d\n",
                 n, current_size + current_stall_size,
-                m_prio_heap.size(), m_max_size);
+                queueSize(), m_max_size);
         m_not_avail_count++;
         return false;
     }
@@ -194,7 +199,7 @@ const Message*
 MessageBuffer::peek() const
 {
     DPRINTF(RubyQueue, "Peeking at head of queue.\n");
-    const Message* msg_ptr = m_prio_heap.front().get();
+    const Message* msg_ptr = peekMsgPtr().get();
     assert(msg_ptr);
 
     DPRINTF(RubyQueue, "Message: %s\n", (*msg_ptr));
@@ -283,20 +288,30 @@ MessageBuffer::enqueue(MsgPtr message, Tick current_time, Tick delta,
     msg_ptr->setLastEnqueueTime(arrival_time);
     msg_ptr->setMsgCounter(m_msg_counter);
 
-    // Insert the message into the priority heap
-    m_prio_heap.push_back(message);
-    push_heap(m_prio_heap.begin(), m_prio_heap.end(), std::greater<MsgPtr>());
+    // Insert the message into the priority queue
+    pushMsg(message);
     // Increment the number of messages statistic
     m_buf_msgs++;
 
     assert((m_max_size == 0) ||
-           ((m_prio_heap.size() + m_stall_map_size) <= m_max_size));
+           ((queueSize() + m_stall_map_size) <= m_max_size));
 
     DPRINTF(RubyQueue, "Enqueue arrival_time: %lld, Message: %s\n",
             arrival_time, *(message.get()));
 
     // Schedule the wakeup
     assert(m_consumer != NULL);
+    if (m_consumer->ranAhead())
+        ParallelWakeup::checkEnqueue(m_consumer, arrival_time);
+    if (ParallelWakeup::deferring()) {
+        Consumer *consumer = m_consumer;
+        int vnet_id = m_vnet_id;
+        ParallelWakeup::defer([consumer, arrival_time, vnet_id]{
+            consumer->scheduleEventAbsolute(arrival_time);
+            consumer->storeEventInfo(vnet_id);
+        });
+        return;
+    }
     m_consumer->scheduleEventAbsolute(arrival_time);
     m_consumer->storeEventInfo(m_vnet_id);
 }
@@ -308,7 +323,7 @@ MessageBuffer::dequeue(Tick current_time, bool decrement_messages)
     assert(isReady(current_time));
 
     // get MsgPtr of the message about to be dequeued
-    MsgPtr message = m_prio_heap.front();
+    MsgPtr message = peekMsgPtr();
 
     // get the delay cycles
     message->updateDelayedTicks(current_time);
@@ -317,15 +332,14 @@ MessageBuffer::dequeue(Tick current_time, bool decrement_messages)
     // record previous size and time so the current buffer size isn't
     // adjusted until schd cycle
     if (m_time_last_time_pop < current_time) {
-        m_size_at_cycle_start = m_prio_heap.size();
+        m_size_at_cycle_start = queueSize();
         m_stalled_at_cycle_start = m_stall_map_size;
         m_time_last_time_pop = current_time;
         m_dequeues_this_cy = 0;
     }
     ++m_dequeues_this_cy;
 
-    pop_heap(m_prio_heap.begin(), m_prio_heap.end(), std::greater<MsgPtr>());
-    m_prio_heap.pop_back();
+    popHead();
     if (decrement_messages) {
         // Record how much time is passed since the message was enqueued
         m_stall_time += curTick() - message->getLastEnqueueTime();
@@ -338,7 +352,10 @@ MessageBuffer::dequeue(Tick current_time, bool decrement_messages)
 
     // if a dequeue callback was requested, call it now
     if (m_dequeue_callback) {
-        m_dequeue_callback();
+        if (ParallelWakeup::deferring())
+            ParallelWakeup::defer(m_dequeue_callback);
+        else
+            m_dequeue_callback();
     }
 
     return delay;
@@ -356,10 +373,35 @@ MessageBuffer::unregisterDequeueCallback()
     m_dequeue_callback = nullptr;
 }
 
+void
+MessageBuffer::pushMsg(MsgPtr message)
+{
+    if (m_tick_buckets) {
+        m_bucket_queue.push(std::move(message));
+    } else {
+        m_prio_heap.push_back(std::move(message));
+        push_heap(m_prio_heap.begin(), m_prio_heap.end(),
+                  std::greater<MsgPtr>());
+    }
+}
+
+MsgPtr
+MessageBuffer::popHead()
+{
+    if (m_tick_buckets)
+        return m_bucket_queue.pop();
+
+    pop_heap(m_prio_heap.begin(), m_prio_heap.end(), std::greater<MsgPtr>());
+    MsgPtr message = std::move(m_prio_heap.back());
+    m_prio_heap.pop_back();
+    return message;
+}
+
 void
 MessageBuffer::clear()
 {
     m_prio_heap.clear();
+    m_bucket_queue.clear();
 
     m_msg_counter = 0;
     m_time_last_time_enqueue = 0;
@@ -372,55 +414,83 @@ MessageBuffer::clear()
 void
 MessageBuffer::recycle(Tick current_time, Tick recycle_latency)
 {
-    DPRINTF(RubyQueue, "Recycling.\n");
-    assert(isReady(current_time));
-    MsgPtr node = m_prio_heap.front();
-    pop_heap(m_prio_heap.begin(), m_prio_heap.end(), std::greater<MsgPtr>());
-
     Tick future_time = current_time + recycle_latency;
+    DPRINTF(RubyQueue, "Recycling, arrival_time: %lld\n", future_time);
+    assert(isReady(current_time));
+    MsgPtr node = popHead();
     node->setLastEnqueueTime(future_time);
-
-    m_prio_heap.back() = node;
-    push_heap(m_prio_heap.begin(), m_prio_heap.end(), std::greater<MsgPtr>());
+    pushMsg(std::move(node));
     m_consumer->scheduleEventAbsolute(future_time);
 }
 
 void
-MessageBuffer::reanalyzeList(std::list<MsgPtr> &lt, Tick schdTick)
+MessageBuffer::unstallChain(StallChain &chain, Tick schdTick)
 {
-    while (!lt.empty()) {
-        MsgPtr m = lt.front();
+    while (chain.head >= 0) {
+        const int id = chain.head;
+        MsgPtr &m = m_stall_msgs[id].msg;
         assert(m->getLastEnqueueTime() <= schdTick);
 
-        m_prio_heap.push_back(m);
-        push_heap(m_prio_heap.begin(), m_prio_heap.end(),
-                  std::greater<MsgPtr>());
-
-        m_consumer->scheduleEventAbsolute(schdTick);
-
         DPRINTF(RubyQueue, "Requeue arrival_time: %lld, Message: %s\n",
             schdTick, *(m.get()));
 
-        lt.pop_front();
+        if (m_tick_buckets)
+            m_bucket_queue.push(std::move(m));
+        else
+            m_prio_heap.push_back(std::move(m));
+        chain.head = m_stall_msgs[id].next;
+        m_stall_msgs.release(id);
+    }
+    m_stall_map_size -= chain.size;
+    assert(m_stall_map_size >= 0);
+}
+
+void
+MessageBuffer::reheapStalled(unsigned int count, Tick schdTick)
+{
+    if (count == 0)
+        return;
+
+    // The order messages come out of the heap depends only on their
+    // arrival times and counters, so rebuilding the heap once is
+    // equivalent to pushing the messages one at a time. Rebuilding is
+    // linear in the heap size, so only do it when that is cheaper. The
+    // bucket queue was kept ordered as the messages were added.
+    if (!m_tick_buckets) {
+        const auto size = m_prio_heap.size();
+        if (count * floorLog2(size) > size) {
+            std::make_heap(m_prio_heap.begin(), m_prio_heap.end(),
+                           std::greater<MsgPtr>());
+        } else {
+            auto it = m_prio_heap.end() - count;
+            while (it != m_prio_heap.end()) {
+                ++it;
+                std::push_heap(m_prio_heap.begin(), it,
+                               std::greater<MsgPtr>());
+            }
+        }
     }
+
+    m_consumer->scheduleEventAbsolute(schdTick);
 }
 
 void
 MessageBuffer::reanalyzeMessages(Addr addr, Tick current_time)
 {
     DPRINTF(RubyQueue, "ReanalyzeMessages %#x\n", addr);
-    assert(m_stall_msg_map.count(addr) > 0);
+    StallChain *chain = m_stall_msg_map.find(addr);
+    assert(chain);
 
     //
     // Put all stalled messages associated with this address back on the
-    // prio heap.  The reanalyzeList call will make sure the consumer is
+    // prio heap.  The reheapStalled call will make sure the consumer is
     // scheduled for the current cycle so that the previously stalled messages
     // will be observed before any younger messages that may arrive this cycle
     //
-    m_stall_map_size -= m_stall_msg_map[addr].size();
-    assert(m_stall_map_size >= 0);
-    reanalyzeList(m_stall_msg_map[addr], current_time);
+    const unsigned int count = chain->size;
+    unstallChain(*chain, current_time);
     m_stall_msg_map.erase(addr);
+    reheapStalled(count, current_time);
 }
 
 void
@@ -430,17 +500,17 @@ MessageBuffer::reanalyzeAllMessages(Tick current_time)
 
     //
     // Put all stalled messages associated with this address back on the
-    // prio heap.  The reanalyzeList call will make sure the consumer is
+    // prio heap.  The reheapStalled call will make sure the consumer is
     // scheduled for the current cycle so that the previously stalled messages
     // will be observed before any younger messages that may arrive this cycle.
     //
-    for (StallMsgMapType::iterator map_iter = m_stall_msg_map.begin();
-         map_iter != m_stall_msg_map.end(); ++map_iter) {
-        m_stall_map_size -= map_iter->second.size();
-        assert(m_stall_map_size >= 0);
-        reanalyzeList(map_iter->second, current_time);
+    unsigned int count = 0;
+    for (auto &[addr, chain] : m_stall_msg_map) {
+        count += chain.size;
+        unstallChain(chain, current_time);
     }
     m_stall_msg_map.clear();
+    reheapStalled(count, current_time);
 }
 
 void
@@ -448,7 +518,7 @@ MessageBuffer::stallMessage(Addr addr, Tick current_time)
 {
     DPRINTF(RubyQueue, "Stalling due to %#x\n", addr);
     assert(isReady(current_time));
-    MsgPtr message = m_prio_heap.front();
+    MsgPtr message = peekMsgPtr();
 
     // Since the message will just be moved to stall map, indicate that the
     // buffer should not decrement the m_buf_msgs statistic
@@ -459,7 +529,14 @@ MessageBuffer::stallMessage(Addr addr, Tick current_time)
     // Instead the controller is responsible to call reanalyzeMessages when
     // these addresses change state.
     //
-    (m_stall_msg_map[addr]).push_back(message);
+    const int id = m_stall_msgs.allocate(message);
+    StallChain &chain = m_stall_msg_map.tryEmplace(addr);
+    if (chain.tail < 0)
+        chain.head = id;
+    else
+        m_stall_msgs[chain.tail].next = id;
+    chain.tail = id;
+    chain.size++;
     m_stall_map_size++;
     m_stall_count++;
 }
@@ -467,7 +544,7 @@ MessageBuffer::stallMessage(Addr addr, Tick current_time)
 bool
 MessageBuffer::hasStalledMsg(Addr addr) const
 {
-    return (m_stall_msg_map.count(addr) != 0);
+    return m_stall_msg_map.contains(addr);
 }
 
 void
@@ -509,8 +586,13 @@ MessageBuffer::print(std::ostream& out) const
         ccprintf(out, " consumer-yes ");
     }
 
-    std::vector<MsgPtr> copy(m_prio_heap);
-    std::sort_heap(copy.begin(), copy.end(), std::greater<MsgPtr>());
+    std::vector<MsgPtr> copy;
+    if (m_tick_buckets) {
+        m_bucket_queue.forEach([&](const MsgPtr &m) { copy.push_back(m); });
+    } else {
+        copy = m_prio_heap;
+        std::sort_heap(copy.begin(), copy.end(), std::greater<MsgPtr>());
+    }
     ccprintf(out, "%s] %s", copy, name());
 }
 
@@ -521,8 +603,8 @@ MessageBuffer::isReady(Tick current_time) const
     bool can_dequeue = (m_max_dequeue_rate == 0) ||
                        (m_time_last_time_pop < current_time) ||
                        (m_dequeues_this_cy < m_max_dequeue_rate);
-    bool is_ready = (m_prio_heap.size() > 0) &&
-                   (m_prio_heap.front()->getLastEnqueueTime() <= current_time);
+    bool is_ready = (queueSize() > 0) &&
+                   (peekMsgPtr()->getLastEnqueueTime() <= current_time);
     if (!can_dequeue && is_ready) {
         // Make sure the Consumer executes next cycle to dequeue the ready msg
         m_consumer->scheduleEvent(Cycles(1));
@@ -533,10 +615,10 @@ MessageBuffer::isReady(Tick current_time) const
 Tick
 MessageBuffer::readyTime() const
 {
-    if (m_prio_heap.empty())
+    if (isEmpty())
         return MaxTick;
     else
-        return m_prio_heap.front()->getLastEnqueueTime();
+        return peekMsgPtr()->getLastEnqueueTime();
 }
 
 uint32_t
@@ -559,16 +641,27 @@ MessageBuffer::functionalAccess(Packet *pkt, bool is_read, WriteMask *mask)
             num_functional_accesses++;
     }
 
+    // Same for the bucket queue
+    bool found = false;
+    m_bucket_queue.forEach([&](const MsgPtr &m) {
+        Message *msg = m.get();
+        if (found)
+            return;
+        if (is_read && !mask && msg->functionalRead(pkt))
+            found = true;
+        else if (is_read && mask && msg->functionalRead(pkt, *mask))
+            num_functional_accesses++;
+        else if (!is_read && msg->functionalWrite(pkt))
+            num_functional_accesses++;
+    });
+    if (found)
+        return 1;
+
     // Check the stall queue and write any messages that may
     // correspond to the address in the packet.
-    for (StallMsgMapType::iterator map_iter = m_stall_msg_map.begin();
-         map_iter != m_stall_msg_map.end();
-         ++map_iter) {
-
-        for (std::list<MsgPtr>::iterator it = (map_iter->second).begin();
-            it != (map_iter->second).end(); ++it) {
-
-            Message *msg = (*it).get();
+    for (const auto &[addr, chain] : m_stall_msg_map) {
+        for (int id = chain.head; id >= 0; id = m_stall_msgs[id].next) {
+            Message *msg = m_stall_msgs[id].msg.get();
             if (is_read && !mask && msg->functionalRead(pkt))
                 return 1;
             else if (is_read && mask && msg->functionalRead(pkt, *mask))
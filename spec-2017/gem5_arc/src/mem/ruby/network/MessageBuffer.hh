@@ -60,6 +60,8 @@
 #include "mem/port.hh"
 #include "mem/ruby/common/Address.hh"
 #include "mem/ruby/common/Consumer.hh"
+#include "mem/ruby/common/SlotMap.hh"
+#include "mem/ruby/network/TickBucketQueue.hh"
 #include "mem/ruby/network/dummy_port.hh"
 #include "mem/ruby/slicc_interface/Message.hh"
 #include "params/MessageBuffer.hh"
@@ -93,10 +95,7 @@ class MessageBuffer : public SimObject
     delayHead(Tick current_time, Tick delta, bool ruby_is_random,
               bool ruby_warmup)
     {
-        MsgPtr m = m_prio_heap.front();
-        std::pop_heap(m_prio_heap.begin(), m_prio_heap.end(),
-                      std::greater<MsgPtr>());
-        m_prio_heap.pop_back();
+        MsgPtr m = popHead();
         enqueue(m, current_time, delta, ruby_is_random, ruby_warmup);
     }
 
@@ -122,7 +121,11 @@ class MessageBuffer : public SimObject
     //! message queue.  The function assumes that the queue is nonempty.
     const Message* peek() const;
 
-    const MsgPtr &peekMsgPtr() const { return m_prio_heap.front(); }
+    const MsgPtr &
+    peekMsgPtr() const
+    {
+        return m_tick_buckets ? m_bucket_queue.front() : m_prio_heap.front();
+    }
 
     void enqueue(MsgPtr message, Tick curTime, Tick delta,
                 bool ruby_is_random, bool ruby_warmup,
@@ -149,8 +152,8 @@ class MessageBuffer : public SimObject
     void unregisterDequeueCallback();
 
     void recycle(Tick current_time, Tick recycle_latency);
-    bool isEmpty() const { return m_prio_heap.size() == 0; }
-    bool isStallMapEmpty() { return m_stall_msg_map.size() == 0; }
+    bool isEmpty() const { return queueSize() == 0; }
+    bool isStallMapEmpty() { return m_stall_msg_map.empty(); }
     unsigned int getStallMapSize() { return m_stall_msg_map.size(); }
 
     unsigned int getSize(Tick curTime);
@@ -197,7 +200,47 @@ class MessageBuffer : public SimObject
     int routingPriority() const { return m_routing_priority; }
 
   private:
-    void reanalyzeList(std::list<MsgPtr> &, Tick);
+    /** Number of messages in m_prio_heap or m_bucket_queue. */
+    std::size_t
+    queueSize() const
+    {
+        return m_tick_buckets ? m_bucket_queue.size() : m_prio_heap.size();
+    }
+
+    /** Add a message to the queue at its last enqueue time. */
+    void pushMsg(MsgPtr message);
+
+    /** Remove and return the message at the head of the queue. */
+    MsgPtr popHead();
+
+    /** A stalled message and the next one stalled on the same line. */
+    struct StalledMsg
+    {
+        StalledMsg(const MsgPtr &m) : msg(m) {}
+
+        MsgPtr msg;
+        int next = -1;
+    };
+
+    /** The messages stalled on one line, oldest first. */
+    struct StallChain
+    {
+        int head = -1;
+        int tail = -1;
+        int size = 0;
+    };
+
+    /**
+     * Move the messages of a stall chain back to the queue. With the
+     * binary heap they are appended without restoring the heap property.
+     */
+    void unstallChain(StallChain &chain, Tick schdTick);
+
+    /**
+     * Restore the heap property after count messages were appended to
+     * m_prio_heap, if it is in use, and wake up the consumer at schdTick.
+     */
+    void reheapStalled(unsigned int count, Tick schdTick);
 
     uint32_t functionalAccess(Packet *pkt, bool is_read, WriteMask *mask);
 
@@ -207,14 +250,18 @@ class MessageBuffer : public SimObject
     Consumer* m_consumer;
     std::vector<MsgPtr> m_prio_heap;
 
-    std::function<void()> m_dequeue_callback;
+    /**
+     * Queue used instead of m_prio_heap when tick_buckets is set. It
+     * gives messages in the same order with O(1) enqueue and dequeue for
+     * messages arriving in order.
+     */
+    const bool m_tick_buckets;
+    TickBucketQueue<MsgPtr> m_bucket_queue;
 
-    // use a std::map for the stalled messages as this container is
-    // sorted and ensures a well-defined iteration order
-    typedef std::map<Addr, std::list<MsgPtr> > StallMsgMapType;
+    std::function<void()> m_dequeue_callback;
 
     /**
-     * A map from line addresses to lists of stalled messages for that line.
+     * A map from line addresses to chains of stalled messages for that line.
      * If this buffer allows the receiver to stall messages, on a stall
      * request, the stalled message is removed from the m_prio_heap and placed
      * in the m_stall_msg_map. Messages are held there until the receiver
@@ -225,8 +272,12 @@ class MessageBuffer : public SimObject
      * initially received, and when a line is unblocked, the messages are
      * moved back to the m_prio_heap in the same order. This prevents starving
      * older requests with younger ones.
+     *
+     * The chains link messages held in m_stall_msgs, so stalling does not
+     * allocate once the pool has grown to the buffer's working set.
      */
-    StallMsgMapType m_stall_msg_map;
+    SlotMap<StallChain> m_stall_msg_map;
+    SlotPool<StalledMsg> m_stall_msgs;
 
     /**
      * A map from line addresses to corresponding vectors of messages that
@@ -82,6 +82,12 @@ class MessageBuffer(SimObject):
                                           be dequeued per cycle \
                                     (0 allows dequeueing all ready messages)",
     )
+    tick_buckets = Param.Bool(
+        False,
+        "Keep messages in a sorted ring buffer, where each arrival tick "
+        "is a FIFO bucket, instead of a binary heap. Messages leave in the "
+        "same order either way.",
+    )
     routing_priority = Param.Int(
         0,
         "Buffer priority when messages are \
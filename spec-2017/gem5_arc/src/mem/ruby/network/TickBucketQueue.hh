@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2025 Boston University
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef __MEM_RUBY_NETWORK_TICKBUCKETQUEUE_HH__
+#define __MEM_RUBY_NETWORK_TICKBUCKETQUEUE_HH__
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "base/types.hh"
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+/**
+ * A priority queue of messages ordered by arrival tick and then by
+ * message counter, the same order as MessageBuffer's binary heap.
+ * The messages are kept sorted in a ring buffer, so the messages that
+ * arrive in the same tick form a FIFO bucket. Buffers enqueue with a few
+ * fixed latencies, so a message almost always goes last or a few places
+ * before, and leaves from the head: both are O(1) and touch a single
+ * array. Messages that arrive further out of order, such as recycled or
+ * unstalled ones, are placed by a binary search and shift the shorter
+ * side of the ring.
+ *
+ * Ptr is a pointer-like type to objects providing getLastEnqueueTime()
+ * and getMsgCounter().
+ */
+template <class Ptr>
+class TickBucketQueue
+{
+  public:
+    void
+    push(Ptr msg)
+    {
+        if (m_size == m_ring.size())
+            grow();
+
+        // Messages almost always go last, or a few places before
+        std::size_t pos = m_size;
+        for (int steps = 0; pos > 0 && before(msg, at(pos - 1)); steps++) {
+            if (steps == maxWalk) {
+                pos = upperBound(msg, pos);
+                break;
+            }
+            pos--;
+        }
+
+        if (pos < m_size / 2) {
+            // Closer to the head: make room by moving the head back
+            m_head = (m_head - 1) & (m_ring.size() - 1);
+            for (std::size_t i = 0; i < pos; i++)
+                at(i) = std::move(at(i + 1));
+        } else {
+            for (std::size_t i = m_size; i > pos; i--)
+                at(i) = std::move(at(i - 1));
+        }
+        at(pos) = std::move(msg);
+        m_size++;
+    }
+
+    const Ptr &
+    front() const
+    {
+        assert(!empty());
+        return m_ring[m_head];
+    }
+
+    Ptr
+    pop()
+    {
+        assert(!empty());
+        Ptr msg = std::move(m_ring[m_head]);
+        m_head = (m_head + 1) & (m_ring.size() - 1);
+        m_size--;
+        return msg;
+    }
+
+    std::size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    void
+    clear()
+    {
+        while (!empty())
+            pop();
+    }
+
+    /** Call f on every message, in the order they would be popped. */
+    template <class F>
+    void
+    forEach(F f) const
+    {
+        for (std::size_t i = 0; i < m_size; i++)
+            f(at(i));
+    }
+
+  private:
+    /** Longest walk from the tail before searching instead */
+    static constexpr int maxWalk = 8;
+
+    /** Whether message a comes out before message b */
+    static bool
+    before(const Ptr &a, const Ptr &b)
+    {
+        const Tick ta = a->getLastEnqueueTime();
+        const Tick tb = b->getLastEnqueueTime();
+        return ta < tb ||
+            (ta == tb && a->getMsgCounter() < b->getMsgCounter());
+    }
+
+    /** Position of the first of the first n messages that msg precedes */
+    std::size_t
+    upperBound(const Ptr &msg, std::size_t n) const
+    {
+        std::size_t lo = 0;
+        while (lo < n) {
+            const std::size_t mid = (lo + n) / 2;
+            if (before(msg, at(mid)))
+                n = mid;
+            else
+                lo = mid + 1;
+        }
+        return lo;
+    }
+
+    Ptr &
+    at(std::size_t i)
+    {
+        return m_ring[(m_head + i) & (m_ring.size() - 1)];
+    }
+
+    const Ptr &
+    at(std::size_t i) const
+    {
+        return m_ring[(m_head + i) & (m_ring.size() - 1)];
+    }
+
+    void
+    grow()
+    {
+        std::vector<Ptr> ring(std::max<std::size_t>(8, 2 * m_ring.size()));
+        for (std::size_t i = 0; i < m_size; i++)
+            ring[i] = std::move(at(i));
+        m_ring.swap(ring);
+        m_head = 0;
+    }
+
+    std::vector<Ptr> m_ring;
+    std::size_t m_head = 0;
+    std::size_t m_size = 0;
+};
+
+} // namespace ruby
+} // namespace gem5
+
+#endif // __MEM_RUBY_NETWORK_TICKBUCKETQUEUE_HH__
@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2025 Boston University
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <queue>
+#include <random>
+#include <vector>
+
+#include "mem/ruby/network/TickBucketQueue.hh"
+
+using namespace gem5;
+using namespace gem5::ruby;
+
+namespace
+{
+
+struct Msg
+{
+    Msg(Tick t, uint64_t c) : time(t), counter(c) {}
+
+    Tick getLastEnqueueTime() const { return time; }
+    uint64_t getMsgCounter() const { return counter; }
+
+    Tick time;
+    uint64_t counter;
+};
+
+typedef std::shared_ptr<Msg> MsgPtr;
+
+/** MessageBuffer's heap order, earliest tick and then lowest counter */
+struct Later
+{
+    bool
+    operator()(const MsgPtr &l, const MsgPtr &r) const
+    {
+        if (l->time == r->time)
+            return l->counter > r->counter;
+        return l->time > r->time;
+    }
+};
+
+} // anonymous namespace
+
+TEST(TickBucketQueueTest, OrderByTickThenCounter)
+{
+    TickBucketQueue<MsgPtr> queue;
+    EXPECT_TRUE(queue.empty());
+
+    // Out of order ticks, and counters out of order within a tick
+    queue.push(std::make_shared<Msg>(20, 3));
+    queue.push(std::make_shared<Msg>(10, 4));
+    queue.push(std::make_shared<Msg>(20, 1));
+    queue.push(std::make_shared<Msg>(30, 2));
+    queue.push(std::make_shared<Msg>(10, 5));
+    queue.push(std::make_shared<Msg>(20, 2));
+    EXPECT_EQ(queue.size(), 6u);
+
+    const std::vector<std::pair<Tick, uint64_t>> expected = {
+        {10, 4}, {10, 5}, {20, 1}, {20, 2}, {20, 3}, {30, 2}};
+
+    std::vector<std::pair<Tick, uint64_t>> visited;
+    queue.forEach([&](const MsgPtr &m) {
+        visited.emplace_back(m->time, m->counter);
+    });
+    EXPECT_EQ(visited, expected);
+
+    for (const auto &[tick, counter] : expected) {
+        ASSERT_FALSE(queue.empty());
+        EXPECT_EQ(queue.front()->time, tick);
+        const MsgPtr m = queue.pop();
+        EXPECT_EQ(m->time, tick);
+        EXPECT_EQ(m->counter, counter);
+    }
+    EXPECT_TRUE(queue.empty());
+}
+
+/** Pushes into a bucket that was partly popped go after its head */
+TEST(TickBucketQueueTest, PushIntoPartlyPoppedBucket)
+{
+    TickBucketQueue<MsgPtr> queue;
+    queue.push(std::make_shared<Msg>(10, 1));
+    queue.push(std::make_shared<Msg>(10, 3));
+    EXPECT_EQ(queue.pop()->counter, 1);
+
+    // A recycled message with an older counter than the bucket's rest
+    queue.push(std::make_shared<Msg>(10, 2));
+    EXPECT_EQ(queue.pop()->counter, 2);
+    EXPECT_EQ(queue.pop()->counter, 3);
+    EXPECT_TRUE(queue.empty());
+}
+
+/**
+ * Random enqueues at fixed latencies, recycles into the future and
+ * unstalls of old messages must pop in the same order as a binary heap.
+ */
+TEST(TickBucketQueueTest, MatchesHeap)
+{
+    std::mt19937_64 rng(1);
+    TickBucketQueue<MsgPtr> queue;
+    std::priority_queue<MsgPtr, std::vector<MsgPtr>, Later> heap;
+    std::vector<MsgPtr> stalled;
+    uint64_t counter = 0;
+    Tick now = 0;
+
+    for (int i = 0; i < 100000; i++) {
+        now += rng() % 3;
+        switch (rng() % 8) {
+          case 0:
+          case 1:
+          case 2: {
+            const Tick latency = (rng() % 4) * 500;
+            const auto m = std::make_shared<Msg>(now + latency, ++counter);
+            queue.push(m);
+            heap.push(m);
+            break;
+          }
+          case 3:
+            if (!stalled.empty()) {
+                // Unstalled messages keep their old tick and counter
+                const MsgPtr m = stalled.back();
+                stalled.pop_back();
+                queue.push(m);
+                heap.push(m);
+            }
+            break;
+          default:
+            if (queue.empty()) {
+                ASSERT_TRUE(heap.empty());
+                break;
+            }
+            ASSERT_EQ(queue.size(), heap.size());
+            MsgPtr m = queue.pop();
+            ASSERT_EQ(m, heap.top());
+            heap.pop();
+            if (rng() % 8 == 0) {
+                stalled.push_back(m);
+            } else if (rng() % 8 == 0) {
+                m->time = now + rng() % 2000;
+                queue.push(m);
+                heap.push(m);
+            }
+            break;
+        }
+    }
+
+    while (!heap.empty()) {
+        ASSERT_EQ(queue.pop(), heap.top());
+        heap.pop();
+    }
+    EXPECT_TRUE(queue.empty());
+}
+
+/**
+ * Deep queues with messages placed anywhere, which are found by binary
+ * search and shift either side of the ring, must also match a heap.
+ */
+TEST(TickBucketQueueTest, DeepOutOfOrder)
+{
+    std::mt19937_64 rng(2);
+    TickBucketQueue<MsgPtr> queue;
+    std::priority_queue<MsgPtr, std::vector<MsgPtr>, Later> heap;
+    uint64_t counter = 0;
+
+    for (int i = 0; i < 20000; i++) {
+        if (rng() % 3) {
+            const auto m = std::make_shared<Msg>(rng() % 5000, ++counter);
+            queue.push(m);
+            heap.push(m);
+        } else if (!heap.empty()) {
+            ASSERT_EQ(queue.size(), heap.size());
+            ASSERT_EQ(queue.pop(), heap.top());
+            heap.pop();
+        }
+    }
+
+    while (!heap.empty()) {
+        ASSERT_EQ(queue.pop(), heap.top());
+        heap.pop();
+    }
+    EXPECT_TRUE(queue.empty());
+}
@@ -64,6 +64,19 @@ class Credit : public flit
 
     ~Credit() {};
 
+    static void *
+    operator new(size_t size)
+    {
+        assert(size == sizeof(Credit));
+        return FlitPool<Credit>::allocate();
+    }
+
+    static void
+    operator delete(void *ptr)
+    {
+        FlitPool<Credit>::release(ptr);
+    }
+
     bool is_free_signal() { return m_is_free_signal; }
 
   private:
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2025 Boston University
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef __MEM_RUBY_NETWORK_GARNET_0_FLITPOOL_HH__
+#define __MEM_RUBY_NETWORK_GARNET_0_FLITPOOL_HH__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+namespace garnet
+{
+
+/*
+ * Free list for the fixed-size objects Garnet creates and destroys every
+ * cycle (flits and credits). Each host thread keeps a small private
+ * list, so the common case takes no lock. Threads that free more than
+ * they allocate (the sink side of a partition boundary) hand batches
+ * back to a shared list, where threads that run dry pick them up. Only
+ * when that is empty too does the pool fall back to the heap, which is
+ * counted as a miss.
+ *
+ * Memory is never returned to the heap; the pool settles at the peak
+ * number of live objects.
+ */
+template <class T>
+class FlitPool
+{
+  public:
+    static void *
+    allocate()
+    {
+        Cache &cache = t_cache;
+        if (!cache.head)
+            refill(cache);
+        if (!cache.head) {
+            s_misses.fetch_add(1, std::memory_order_relaxed);
+            return ::operator new(sizeof(T));
+        }
+
+        Node *node = cache.head;
+        cache.head = node->next;
+        cache.count--;
+        return node;
+    }
+
+    static void
+    release(void *ptr)
+    {
+        Cache &cache = t_cache;
+        Node *node = static_cast<Node *>(ptr);
+        node->next = cache.head;
+        cache.head = node;
+        if (++cache.count > MaxCached)
+            spill(cache, MaxCached / 2);
+    }
+
+    // Put count fresh objects on the shared list up front
+    static void
+    reserve(size_t count)
+    {
+        std::lock_guard<std::mutex> lock(s_mutex);
+        for (; s_shared_count < count; s_shared_count++) {
+            Node *node = static_cast<Node *>(::operator new(sizeof(T)));
+            node->next = s_shared;
+            s_shared = node;
+        }
+    }
+
+    // Objects that had to come from the heap since start-up
+    static uint64_t misses() { return s_misses.load(); }
+
+  private:
+    struct Node
+    {
+        Node *next;
+    };
+    static_assert(sizeof(T) >= sizeof(Node), "object too small to pool");
+
+    struct Cache
+    {
+        Node *head = nullptr;
+        size_t count = 0;
+
+        // Don't strand a finished thread's objects
+        ~Cache() { spill(*this, count); }
+    };
+
+    static constexpr size_t MaxCached = 512;
+    static constexpr size_t Batch = MaxCached / 4;
+
+    static void
+    refill(Cache &cache)
+    {
+        std::lock_guard<std::mutex> lock(s_mutex);
+        for (size_t i = 0; i < Batch && s_shared; i++) {
+            Node *node = s_shared;
+            s_shared = node->next;
+            s_shared_count--;
+            node->next = cache.head;
+            cache.head = node;
+            cache.count++;
+        }
+    }
+
+    static void
+    spill(Cache &cache, size_t count)
+    {
+        std::lock_guard<std::mutex> lock(s_mutex);
+        for (size_t i = 0; i < count && cache.head; i++) {
+            Node *node = cache.head;
+            cache.head = node->next;
+            cache.count--;
+            node->next = s_shared;
+            s_shared = node;
+            s_shared_count++;
+        }
+    }
+
+    static inline thread_local Cache t_cache;
+    static inline std::mutex s_mutex;
+    static inline Node *s_shared = nullptr;
+    static inline size_t s_shared_count = 0;
+    static inline std::atomic<uint64_t> s_misses{0};
+};
+
+} // namespace garnet
+} // namespace ruby
+} // namespace gem5
+
+#endif // __MEM_RUBY_NETWORK_GARNET_0_FLITPOOL_HH__
@@ -55,6 +55,9 @@ class NetworkLink(ClockedObject):
         Parent.supported_vnets, "Vnets supported"
     )
     width = Param.UInt32(Parent.width, "bit-width of the link")
+    elide_idle_cycles = Param.Bool(
+        Parent.elide_idle_cycles, "skip cycles with no flit ready to send"
+    )
 
 
 class CreditLink(NetworkLink):
@@ -31,15 +31,19 @@
 
 #include "mem/ruby/network/garnet/GarnetNetwork.hh"
 
+#include <algorithm>
 #include <cassert>
 
 #include "base/cast.hh"
 #include "base/compiler.hh"
+#include "base/random.hh"
 #include "debug/RubyNetwork.hh"
 #include "mem/ruby/common/NetDest.hh"
 #include "mem/ruby/network/MessageBuffer.hh"
 #include "mem/ruby/network/garnet/CommonTypes.hh"
+#include "mem/ruby/network/garnet/Credit.hh"
 #include "mem/ruby/network/garnet/CreditLink.hh"
+#include "mem/ruby/network/garnet/FlitPool.hh"
 #include "mem/ruby/network/garnet/GarnetLink.hh"
 #include "mem/ruby/network/garnet/NetworkInterface.hh"
 #include "mem/ruby/network/garnet/NetworkLink.hh"
@@ -70,7 +74,13 @@ GarnetNetwork::GarnetNetwork(const Params &p)
     m_buffers_per_data_vc = p.buffers_per_data_vc;
     m_buffers_per_ctrl_vc = p.buffers_per_ctrl_vc;
     m_routing_algorithm = p.routing_algorithm;
+    m_compile_routing_tables = p.compile_routing_tables;
+    m_elide_idle_cycles = p.elide_idle_cycles;
     m_next_packet_id = 0;
+    m_partition_quantum = MaxTick;
+    m_partition_barrier = nullptr;
+    m_flit_pool_miss_base = 0;
+    m_credit_pool_miss_base = 0;
 
     m_enable_fault_model = p.enable_fault_model;
     if (m_enable_fault_model)
@@ -134,6 +144,35 @@ GarnetNetwork::init()
         m_num_cols = -1;
     }
 
+    if (m_routing_algorithm >= WEST_FIRST_ &&
+        m_routing_algorithm < NUM_ROUTING_ALGORITHM_) {
+        fatal_if(m_num_rows <= 0, "Adaptive routing algorithm %d needs a "
+                 "mesh topology (num_rows > 0).", m_routing_algorithm);
+    }
+    if (m_routing_algorithm == DYXY_) {
+        for (auto &router : m_routers) {
+            fatal_if(router->get_vc_per_vnet() < 2, "DyXY routing needs at "
+                     "least 2 VCs per vnet to stay deadlock-free; %s has %d.",
+                     router->name(), router->get_vc_per_vnet());
+        }
+    }
+
+    // All routes are known now; turn the routing tables into dense
+    // per-destination lookups
+    if (m_compile_routing_tables) {
+        for (auto &router : m_routers) {
+            router->compileRoutingTable();
+        }
+    }
+
+    // Routing table ties are broken by a generator of each router's own,
+    // so a partitioned run makes the same choices as a serial one
+    for (auto &router : m_routers)
+        router->seedTieBreaks(Random::globalSeed + router->get_id());
+
+    reserveFlitPools();
+    initPartitions();
+
     // FaultModel: declare each router to the fault model
     if (isFaultModelEnabled()) {
         for (std::vector<Router*>::const_iterator i= m_routers.begin();
@@ -152,6 +191,109 @@ GarnetNetwork::init()
     }
 }
 
+/*
+ * Every flit or credit in flight sits in, or is owed to, a VC buffer
+ * slot, so the total number of slots is what the pools need to cover
+ * saturated traffic without going to the heap.
+ */
+void
+GarnetNetwork::reserveFlitPools()
+{
+    size_t buffer_slots = 0;
+    for (auto &router : m_routers) {
+        size_t slots_per_port = 0;
+        for (int vnet = 0; vnet < m_virtual_networks; vnet++) {
+            slots_per_port += router->get_vc_per_vnet() *
+                (m_vnet_type[vnet] == DATA_VNET_ ? m_buffers_per_data_vc :
+                                                   m_buffers_per_ctrl_vc);
+        }
+        buffer_slots += router->get_num_inports() * slots_per_port;
+    }
+
+    FlitPool<flit>::reserve(buffer_slots);
+    FlitPool<Credit>::reserve(buffer_slots);
+}
+
+/*
+ * Routers (and their outgoing links) may be spread over several event
+ * queues by the config, each run by its own host thread. Find the
+ * links that cross between queues and the longest quantum their
+ * latency allows.
+ */
+void
+GarnetNetwork::initPartitions()
+{
+    std::vector<NetworkLink *> links(m_networklinks);
+    links.insert(links.end(), m_creditlinks.begin(), m_creditlinks.end());
+
+    for (auto &link : links) {
+        // The source wakes the link directly, so they must share a queue
+        fatal_if(link->eventQueue() != link->getSourceObject()->eventQueue(),
+                 "%s must be on the same event queue as its source %s.",
+                 link->name(), link->getSourceObject()->name());
+
+        EventQueue *consumer_eq =
+            link->getLinkConsumer()->getObject()->eventQueue();
+        if (consumer_eq == link->eventQueue())
+            continue;
+
+        link->setCrossPartition();
+        m_partition_links.push_back(link);
+        m_partition_quantum = std::min(m_partition_quantum,
+            link->cyclesToTicks(link->getLatency()));
+    }
+
+    if (!isPartitioned())
+        return;
+
+    fatal_if(!m_networkbridges.empty(),
+             "Network bridges (CDC/SerDes) are not supported when garnet "
+             "routers are spread over several event queues.");
+    fatal_if(m_partition_quantum == 0,
+             "Links between garnet partitions need a non-zero latency.");
+    // Garnet syncs the partitions itself, but gem5 only runs several
+    // event queues with a global quantum
+    fatal_if(simQuantum == 0,
+             "Garnet routers are spread over several event queues, but "
+             "root.sim_quantum is not set.");
+
+    inform("Garnet: %d links cross event queues, barrier every %d ticks\n",
+           m_partition_links.size(), m_partition_quantum);
+}
+
+void
+GarnetNetwork::startup()
+{
+    Network::startup();
+
+    if (isPartitioned() && !m_partition_barrier) {
+        m_partition_barrier =
+            new PartitionBarrier(this, m_partition_quantum);
+        m_partition_barrier->schedule(curTick() + m_partition_quantum);
+    }
+}
+
+void
+GarnetNetwork::exchangePartitionFlits()
+{
+    for (auto &link : m_partition_links) {
+        link->exchangeStagedFlits();
+    }
+}
+
+void
+GarnetNetwork::PartitionBarrier::process()
+{
+    m_net->exchangePartitionFlits();
+    GlobalSyncEvent::process();
+}
+
+const char *
+GarnetNetwork::PartitionBarrier::description() const
+{
+    return "GarnetNetwork partition barrier";
+}
+
 /*
  * This function creates a link from the Network Interface (NI)
  * into the Network.
@@ -512,6 +654,10 @@ GarnetNetwork::regStats()
     m_avg_hops.name(name() + ".average_hops");
     m_avg_hops = m_total_hops / sum(m_flits_received);
 
+    // Allocation pools
+    m_flit_pool_misses.name(name() + ".flit_pool_misses");
+    m_credit_pool_misses.name(name() + ".credit_pool_misses");
+
     // Links
     m_total_ext_in_link_utilization
         .name(name() + ".ext_in_link_utilization");
@@ -580,6 +726,10 @@ GarnetNetwork::collateStats()
     for (int i = 0; i < m_routers.size(); i++) {
         m_routers[i]->collateStats();
     }
+
+    m_flit_pool_misses = FlitPool<flit>::misses() - m_flit_pool_miss_base;
+    m_credit_pool_misses =
+        FlitPool<Credit>::misses() - m_credit_pool_miss_base;
 }
 
 void
@@ -594,6 +744,9 @@ GarnetNetwork::resetStats()
     for (int i = 0; i < m_creditlinks.size(); i++) {
         m_creditlinks[i]->resetStats();
     }
+
+    m_flit_pool_miss_base = FlitPool<flit>::misses();
+    m_credit_pool_miss_base = FlitPool<Credit>::misses();
 }
 
 void
@@ -39,6 +39,7 @@
 #include "mem/ruby/network/fault_model/FaultModel.hh"
 #include "mem/ruby/network/garnet/CommonTypes.hh"
 #include "params/GarnetNetwork.hh"
+#include "sim/global_event.hh"
 
 namespace gem5
 {
@@ -66,6 +67,7 @@ class GarnetNetwork : public Network
     ~GarnetNetwork() = default;
 
     void init();
+    void startup();
 
     const char *garnetVersion = "3.0";
 
@@ -80,6 +82,8 @@ class GarnetNetwork : public Network
     uint32_t getBuffersPerDataVC() { return m_buffers_per_data_vc; }
     uint32_t getBuffersPerCtrlVC() { return m_buffers_per_ctrl_vc; }
     int getRoutingAlgorithm() const { return m_routing_algorithm; }
+    bool isIdleCycleElisionEnabled() const { return m_elide_idle_cycles; }
+    bool isPartitioned() const { return !m_partition_links.empty(); }
 
     bool isFaultModelEnabled() const { return m_enable_fault_model; }
     FaultModel* fault_model;
@@ -166,6 +170,8 @@ class GarnetNetwork : public Network
     uint32_t m_buffers_per_ctrl_vc;
     uint32_t m_buffers_per_data_vc;
     int m_routing_algorithm;
+    bool m_compile_routing_tables;
+    bool m_elide_idle_cycles;
     bool m_enable_fault_model;
 
     // Statistical variables
@@ -200,6 +206,13 @@ class GarnetNetwork : public Network
     statistics::Scalar  m_total_hops;
     statistics::Formula m_avg_hops;
 
+    // Flits and credits that could not be recycled from their pools;
+    // a host-side measure, so it may vary with the thread layout
+    statistics::Scalar m_flit_pool_misses;
+    statistics::Scalar m_credit_pool_misses;
+    uint64_t m_flit_pool_miss_base;
+    uint64_t m_credit_pool_miss_base;
+
     std::vector<std::vector<statistics::Scalar *>> m_data_traffic_distribution;
     std::vector<std::vector<statistics::Scalar *>> m_ctrl_traffic_distribution;
 
@@ -207,6 +220,39 @@ class GarnetNetwork : public Network
     GarnetNetwork(const GarnetNetwork& obj);
     GarnetNetwork& operator=(const GarnetNetwork& obj);
 
+    /*
+     * Barrier between router partitions. Routers on different event
+     * queues (host threads) only talk through links whose latency is at
+     * least one quantum, so flits sent in one quantum cannot be due
+     * before the next; they are staged on the link and handed over here
+     * while every thread waits, in a fixed order.
+     */
+    class PartitionBarrier : public GlobalSyncEvent
+    {
+      public:
+        PartitionBarrier(GarnetNetwork *net, Tick quantum)
+            : GlobalSyncEvent(Event::Minimum_Pri, 0), m_net(net)
+        {
+            repeat = quantum;
+        }
+
+        void process() override;
+        const char *description() const override;
+
+      private:
+        GarnetNetwork *m_net;
+    };
+
+    void reserveFlitPools();
+    void initPartitions();
+    void exchangePartitionFlits();
+
+    // Links whose consumer is on another event queue, and the largest
+    // quantum they allow
+    std::vector<NetworkLink *> m_partition_links;
+    Tick m_partition_quantum;
+    PartitionBarrier *m_partition_barrier;
+
     std::vector<VNET_type > m_vnet_type;
     std::vector<Router *> m_routers;   // All Routers in Network
     std::vector<NetworkLink *> m_networklinks; // All flit links in the network
@@ -46,7 +46,22 @@ class GarnetNetwork(RubyNetwork):
     vcs_per_vnet = Param.UInt32(4, "virtual channels per virtual network")
     buffers_per_data_vc = Param.UInt32(4, "buffers per data virtual channel")
     buffers_per_ctrl_vc = Param.UInt32(1, "buffers per ctrl virtual channel")
-    routing_algorithm = Param.Int(0, "0: Weight-based Table, 1: XY, 2: Custom")
+    routing_algorithm = Param.Int(
+        0,
+        "0: Weight-based Table, 1: XY, 2: Custom, 3: West-first, "
+        "4: Odd-even, 5: DyXY",
+    )
+    compile_routing_tables = Param.Bool(
+        True,
+        "compile the routing tables into per-destination outport arrays "
+        "at init instead of scanning every link for each head flit",
+    )
+    elide_idle_cycles = Param.Bool(
+        False,
+        "only wake routers, links and network interfaces in cycles in "
+        "which they can make progress; cycle-accurate with the default "
+        "per-cycle wakeups",
+    )
     enable_fault_model = Param.Bool(False, "enable network fault model")
     fault_model = Param.FaultModel(NULL, "network fault model")
     garnet_deadlock_threshold = Param.UInt32(
@@ -268,7 +268,7 @@ NetworkBridge::wakeup()
 
     // Reschedule in case there is a waiting flit.
     if (!link_srcQueue->isEmpty()) {
-        scheduleEvent(Cycles(1));
+        scheduleNextFlit();
     }
 }
 
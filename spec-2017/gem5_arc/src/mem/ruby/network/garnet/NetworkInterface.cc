@@ -57,7 +57,8 @@ NetworkInterface::NetworkInterface(const Params &p)
     m_virtual_networks(p.virt_nets), m_vc_per_vnet(0),
     m_vc_allocator(m_virtual_networks, 0),
     m_deadlock_threshold(p.garnet_deadlock_threshold),
-    vc_busy_counter(m_virtual_networks, 0)
+    vc_busy_counter(m_virtual_networks, 0),
+    m_vc_busy_cycle(m_virtual_networks, Cycles(0))
 {
     m_stall_count.resize(m_virtual_networks);
     niOutVcs.resize(0);
@@ -376,8 +377,9 @@ NetworkInterface::flitisizeMessage(MsgPtr msg_ptr, int vnet)
     Message *net_msg_ptr = msg_ptr.get();
     NetDest net_msg_dest = net_msg_ptr->getDestination();
 
-    // gets all the destinations associated with this message.
-    std::vector<NodeID> dest_nodes = net_msg_dest.getAllDest();
+    // Destinations are taken smallest first straight from the bitset, so
+    // a multicast message does not need a separate list of its nodes.
+    bool multicast = net_msg_dest.count() > 1;
 
     // Number of flits is dependent on the link bandwidth available.
     // This is expressed in terms of bytes/cycle or the flit size
@@ -391,7 +393,7 @@ NetworkInterface::flitisizeMessage(MsgPtr msg_ptr, int vnet)
         vnet, oPort->bitWidth());
 
     // loop to convert all multicast messages into unicast messages
-    for (int ctr = 0; ctr < dest_nodes.size(); ctr++) {
+    while (!net_msg_dest.isEmpty()) {
 
         // this will return a free output virtual channel
         int vc = calculateVC(vnet);
@@ -400,27 +402,21 @@ NetworkInterface::flitisizeMessage(MsgPtr msg_ptr, int vnet)
             return false ;
         }
         MsgPtr new_msg_ptr = msg_ptr->clone();
-        NodeID destID = dest_nodes[ctr];
+        MachineID dest_mach = net_msg_dest.smallestElement();
+        NodeID destID = MachineType_base_number(dest_mach.type) +
+            dest_mach.num;
+        net_msg_dest.remove(dest_mach);
 
         Message *new_net_msg_ptr = new_msg_ptr.get();
-        if (dest_nodes.size() > 1) {
+        if (multicast) {
+            // calculating the NetDest associated with this destID
             NetDest personal_dest(m_net_ptr->getRubySystem());
-            for (int m = 0; m < (int) MachineType_NUM; m++) {
-                if ((destID >= MachineType_base_number((MachineType) m)) &&
-                    destID < MachineType_base_number((MachineType) (m+1))) {
-                    // calculating the NetDest associated with this destID
-                    personal_dest.clear();
-                    personal_dest.add((MachineID) {(MachineType) m, (destID -
-                        MachineType_base_number((MachineType) m))});
-                    new_net_msg_ptr->getDestination() = personal_dest;
-                    break;
-                }
-            }
-            net_msg_dest.removeNetDest(personal_dest);
+            personal_dest.add(dest_mach);
+            new_net_msg_ptr->getDestination() = personal_dest;
             // removing the destination from the original message to reflect
             // that a message with this particular destination has been
             // flitisized and an output vc is acquired
-            net_msg_ptr->getDestination().removeNetDest(personal_dest);
+            net_msg_ptr->getDestination().remove(dest_mach);
         }
 
         // Embed Route into the flits
@@ -477,7 +473,13 @@ NetworkInterface::calculateVC(int vnet)
         }
     }
 
-    vc_busy_counter[vnet] += 1;
+    if (m_net_ptr->isIdleCycleElisionEnabled() && vc_busy_counter[vnet]) {
+        // The NI may have slept through some of the busy cycles
+        vc_busy_counter[vnet] += curCycle() - m_vc_busy_cycle[vnet];
+    } else {
+        vc_busy_counter[vnet] += 1;
+    }
+    m_vc_busy_cycle[vnet] = curCycle();
     panic_if(vc_busy_counter[vnet] > m_deadlock_threshold,
         "%s: Possible network deadlock in vnet: %d at time: %llu \n",
         name(), vnet, curTick());
@@ -485,6 +487,18 @@ NetworkInterface::calculateVC(int vnet)
     return -1;
 }
 
+// True if calculateVC(vnet) would find an output vc at the given time
+bool
+NetworkInterface::hasFreeVC(int vnet, Tick time)
+{
+    for (int vc = vnet * m_vc_per_vnet; vc < (vnet + 1) * m_vc_per_vnet;
+         vc++) {
+        if (outVcState[vc].isInState(IDLE_, time))
+            return true;
+    }
+    return false;
+}
+
 void
 NetworkInterface::scheduleOutputPort(OutputPort *oPort)
 {
@@ -626,22 +640,42 @@ NetworkInterface::get_vnet(int vc)
 // output VC buffer.
 // Also check if we have to reschedule because of a clock period
 // difference.
+// With idle-cycle elision, messages and flits that cannot move until a
+// credit comes back are left alone: the credit link wakes the NI up.
+// Stalled tail flits are retried on every wakeup, so nothing is elided
+// while there are any.
 void
 NetworkInterface::checkReschedule()
 {
-    for (const auto& it : inNode_ptr) {
-        if (it == nullptr) {
+    bool elide = m_net_ptr->isIdleCycleElisionEnabled();
+    for (int vnet = 0; elide && vnet < m_stall_count.size(); ++vnet) {
+        if (m_stall_count[vnet] > 0)
+            elide = false;
+    }
+    const Tick nextCycle = clockEdge(Cycles(1));
+
+    for (int vnet = 0; vnet < inNode_ptr.size(); ++vnet) {
+        MessageBuffer *b = inNode_ptr[vnet];
+        if (b == nullptr) {
             continue;
         }
 
-        while (it->isReady(clockEdge())) { // Is there a message waiting
-            scheduleEvent(Cycles(1));
-            return;
+        if (b->isReady(clockEdge())) { // Is there a message waiting
+            if (!elide || vc_busy_counter[vnet] == 0 ||
+                hasFreeVC(vnet, nextCycle)) {
+                scheduleEvent(Cycles(1));
+                return;
+            }
+            // Still check for a deadlock when the busy counter would
+            // have crossed the threshold
+            scheduleEvent(Cycles(m_deadlock_threshold + 1 -
+                                 vc_busy_counter[vnet]));
         }
     }
 
-    for (auto& ni_out_vc : niOutVcs) {
-        if (ni_out_vc.isReady(clockEdge(Cycles(1)))) {
+    for (int vc = 0; vc < niOutVcs.size(); vc++) {
+        if (niOutVcs[vc].isReady(nextCycle) &&
+            (!elide || outVcState[vc].has_credit())) {
             scheduleEvent(Cycles(1));
             return;
         }
@@ -33,6 +33,7 @@
 #ifndef __MEM_RUBY_NETWORK_GARNET_0_NETWORKINTERFACE_HH__
 #define __MEM_RUBY_NETWORK_GARNET_0_NETWORKINTERFACE_HH__
 
+#include <deque>
 #include <iostream>
 #include <vector>
 
@@ -292,10 +293,14 @@ class NetworkInterface : public ClockedObject, public Consumer
     std::vector<MessageBuffer *> outNode_ptr;
     // When a vc stays busy for a long time, it indicates a deadlock
     std::vector<int> vc_busy_counter;
+    // Cycle of the last failed VC allocation in each vnet, so that cycles
+    // skipped by idle-cycle elision still count towards the threshold
+    std::vector<Cycles> m_vc_busy_cycle;
 
     void checkStallQueue();
     bool flitisizeMessage(MsgPtr msg_ptr, int vnet);
     int calculateVC(int vnet);
+    bool hasFreeVC(int vnet, Tick time);
 
 
     void scheduleOutputPort(OutputPort *oPort);
@@ -48,7 +48,8 @@ namespace garnet
 NetworkLink::NetworkLink(const Params &p)
     : ClockedObject(p), Consumer(this), m_id(p.link_id),
       m_type(NUM_LINK_TYPES_),
-      m_latency(p.link_latency), m_link_utilized(0),
+      m_latency(p.link_latency), m_elide_idle_cycles(p.elide_idle_cycles),
+      m_cross_partition(false), m_link_utilized(0),
       m_virt_nets(p.virt_nets), linkBuffer(),
       link_consumer(nullptr), link_srcQueue(nullptr)
 {
@@ -98,15 +99,54 @@ NetworkLink::wakeup()
                 (mVnets.size() == 0));
         }
         t_flit->set_time(clockEdge(m_latency));
-        linkBuffer.insert(t_flit);
-        link_consumer->scheduleEventAbsolute(clockEdge(m_latency));
+        if (m_cross_partition) {
+            m_staged_flits.push_back(t_flit);
+        } else {
+            linkBuffer.insert(t_flit);
+            link_consumer->scheduleEventAbsolute(clockEdge(m_latency));
+        }
         m_link_utilized++;
         m_vc_load[t_flit->get_vc()]++;
     }
 
     if (!link_srcQueue->isEmpty()) {
-        scheduleEvent(Cycles(1));
+        scheduleNextFlit();
+    }
+}
+
+void
+NetworkLink::scheduleNextFlit()
+{
+    // Without elision, poll the source queue every cycle
+    Cycles delay(1);
+    if (m_elide_idle_cycles) {
+        // The queue is in order, so nothing can leave before the top
+        // flit does; sleep until the first edge at or after its time.
+        Tick ready = link_srcQueue->peekTopFlit()->get_time();
+        if (ready > curTick())
+            delay = std::max(delay, ticksToCycles(ready - curTick()));
     }
+    scheduleEvent(delay);
+}
+
+void
+NetworkLink::exchangeStagedFlits()
+{
+    if (m_staged_flits.empty())
+        return;
+
+    // Every other thread is parked at the barrier, so the consumer's
+    // queue can be borrowed to schedule its wakeups directly. The link
+    // latency is at least one quantum, so none of these flits are due
+    // before now.
+    EventQueue::ScopedMigration migrate(
+        link_consumer->getObject()->eventQueue());
+    for (flit *t_flit : m_staged_flits) {
+        assert(t_flit->get_time() >= curTick());
+        linkBuffer.insert(t_flit);
+        link_consumer->scheduleEventAbsolute(t_flit->get_time());
+    }
+    m_staged_flits.clear();
 }
 
 void
@@ -122,13 +162,23 @@ NetworkLink::resetStats()
 bool
 NetworkLink::functionalRead(Packet *pkt, WriteMask &mask)
 {
-    return linkBuffer.functionalRead(pkt, mask);
+    bool read = linkBuffer.functionalRead(pkt, mask);
+    for (flit *t_flit : m_staged_flits) {
+        if (t_flit->functionalRead(pkt, mask))
+            read = true;
+    }
+    return read;
 }
 
 uint32_t
 NetworkLink::functionalWrite(Packet *pkt)
 {
-    return linkBuffer.functionalWrite(pkt);
+    uint32_t num_functional_writes = linkBuffer.functionalWrite(pkt);
+    for (flit *t_flit : m_staged_flits) {
+        if (t_flit->functionalWrite(pkt))
+            num_functional_writes++;
+    }
+    return num_functional_writes;
 }
 
 } // namespace garnet
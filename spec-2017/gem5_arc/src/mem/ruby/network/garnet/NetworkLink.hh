@@ -67,9 +67,18 @@ class NetworkLink : public ClockedObject, public Consumer
     link_type getType() { return m_type; }
     void print(std::ostream& out) const {}
     int get_id() const { return m_id; }
+    Cycles getLatency() const { return m_latency; }
     flitBuffer *getBuffer() { return &linkBuffer;}
+    ClockedObject *getSourceObject() const { return src_object; }
+    Consumer *getLinkConsumer() const { return link_consumer; }
     virtual void wakeup();
 
+    // Called at init if the consumer runs on another event queue
+    void setCrossPartition() { m_cross_partition = true; }
+    bool isCrossPartition() const { return m_cross_partition; }
+    // Hand flits staged since the last partition barrier to the consumer
+    void exchangeStagedFlits();
+
     unsigned int getLinkUtilization() const { return m_link_utilized; }
     const std::vector<unsigned int> & getVcLoad() const { return m_vc_load; }
 
@@ -92,14 +101,24 @@ class NetworkLink : public ClockedObject, public Consumer
     const int m_id;
     link_type m_type;
     const Cycles m_latency;
+    const bool m_elide_idle_cycles;
 
     ClockedObject *src_object;
 
+    // A cross-partition link may not touch linkBuffer or wake its
+    // consumer from the source's thread, so flits wait here until the
+    // next barrier
+    bool m_cross_partition;
+    std::vector<flit *> m_staged_flits;
+
     // Statistical variables
     unsigned int m_link_utilized;
     std::vector<unsigned int> m_vc_load;
 
   protected:
+    // Wake up to send the next flit waiting in the source queue
+    void scheduleNextFlit();
+
     uint32_t m_virt_nets;
     flitBuffer linkBuffer;
     Consumer *link_consumer;
@@ -94,11 +94,15 @@ OutputUnit::has_credit(int out_vc)
 
 
 // Check if the output port (i.e., input port at next router) has free VCs.
+// A vc_class of 0 or 1 restricts the search to the lower or upper half of
+// the VCs of the vnet, as used by DyXY routing.
 bool
-OutputUnit::has_free_vc(int vnet)
+OutputUnit::has_free_vc(int vnet, int vc_class)
 {
     int vc_base = vnet*m_vc_per_vnet;
-    for (int vc = vc_base; vc < vc_base + m_vc_per_vnet; vc++) {
+    int vc_end = vc_base + m_vc_per_vnet;
+    vc_class_range(vc_class, vc_base, vc_end);
+    for (int vc = vc_base; vc < vc_end; vc++) {
         if (is_vc_idle(vc, curTick()))
             return true;
     }
@@ -108,10 +112,12 @@ OutputUnit::has_free_vc(int vnet)
 
 // Assign a free output VC to the winner of Switch Allocation
 int
-OutputUnit::select_free_vc(int vnet)
+OutputUnit::select_free_vc(int vnet, int vc_class)
 {
     int vc_base = vnet*m_vc_per_vnet;
-    for (int vc = vc_base; vc < vc_base + m_vc_per_vnet; vc++) {
+    int vc_end = vc_base + m_vc_per_vnet;
+    vc_class_range(vc_class, vc_base, vc_end);
+    for (int vc = vc_base; vc < vc_end; vc++) {
         if (is_vc_idle(vc, curTick())) {
             outVcState[vc].setState(ACTIVE_, curTick());
             return vc;
@@ -121,6 +127,32 @@ OutputUnit::select_free_vc(int vnet)
     return -1;
 }
 
+// Free buffer slots at the downstream input port over all VCs of vnet.
+// Used as the congestion estimate by adaptive routing.
+int
+OutputUnit::get_free_credits(int vnet)
+{
+    int credits = 0;
+    int vc_base = vnet*m_vc_per_vnet;
+    for (int vc = vc_base; vc < vc_base + m_vc_per_vnet; vc++) {
+        credits += outVcState[vc].get_credit_count();
+    }
+    return credits;
+}
+
+void
+OutputUnit::vc_class_range(int vc_class, int &vc_base, int &vc_end) const
+{
+    if (vc_class < 0)
+        return;
+    assert(vc_class < 2 && m_vc_per_vnet >= 2);
+    int half = m_vc_per_vnet / 2;
+    if (vc_class == 0)
+        vc_end = vc_base + half;
+    else
+        vc_base += half;
+}
+
 /*
  * The wakeup function of the OutputUnit reads the credit signal from the
  * downstream router for the output VC (i.e., input VC at downstream router).
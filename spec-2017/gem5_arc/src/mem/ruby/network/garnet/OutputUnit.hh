@@ -67,8 +67,9 @@ class OutputUnit : public Consumer
     void decrement_credit(int out_vc);
     void increment_credit(int out_vc);
     bool has_credit(int out_vc);
-    bool has_free_vc(int vnet);
-    int select_free_vc(int vnet);
+    bool has_free_vc(int vnet, int vc_class = -1);
+    int select_free_vc(int vnet, int vc_class = -1);
+    int get_free_credits(int vnet);
 
     inline PortDirection get_direction() { return m_direction; }
 
@@ -108,6 +109,9 @@ class OutputUnit : public Consumer
     uint32_t functionalWrite(Packet *pkt);
 
   private:
+    // Narrow [vc_base, vc_end) to the VCs of vc_class
+    void vc_class_range(int vc_class, int &vc_base, int &vc_end) const;
+
     Router *m_router;
     GEM5_CLASS_VAR_USED int m_id;
     PortDirection m_direction;
@@ -116,7 +116,15 @@ class Router : public BasicRouter, public Consumer
     PortDirection getOutportDirection(int outport);
     PortDirection getInportDirection(int inport);
 
-    int route_compute(RouteInfo route, int inport, PortDirection direction);
+    int route_compute(const RouteInfo &route, int inport,
+                      PortDirection direction);
+    void compileRoutingTable() { routingUnit.compileRoutingTable(); }
+    void seedTieBreaks(uint32_t seed) { routingUnit.seedTieBreaks(seed); }
+    int
+    get_outvc_class(const RouteInfo &route, int outport)
+    {
+        return routingUnit.outvcClass(route, outport);
+    }
     void grant_switch(int inport, flit *t_flit);
     void schedule_wakeup(Cycles time);
 
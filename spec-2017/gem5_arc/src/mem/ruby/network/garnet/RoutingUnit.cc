@@ -34,8 +34,10 @@
 #include "base/compiler.hh"
 #include "debug/RubyNetwork.hh"
 #include "mem/ruby/network/garnet/InputUnit.hh"
+#include "mem/ruby/network/garnet/OutputUnit.hh"
 #include "mem/ruby/network/garnet/Router.hh"
 #include "mem/ruby/slicc_interface/Message.hh"
+#include "mem/ruby/system/RubySystem.hh"
 
 namespace gem5
 {
@@ -51,6 +53,7 @@ RoutingUnit::RoutingUnit(Router *router)
     m_router = router;
     m_routing_table.clear();
     m_weight_table.clear();
+    m_mesh_outports.fill(-1);
 }
 
 void
@@ -94,7 +97,7 @@ RoutingUnit::supportsVnet(int vnet, std::vector<int> sVnets)
  * Correct weight assignments are critical to provide deadlock avoidance.
  */
 int
-RoutingUnit::lookupRoutingTable(int vnet, NetDest msg_destination)
+RoutingUnit::lookupRoutingTable(int vnet, const NetDest &msg_destination)
 {
     // First find all possible output link candidates
     // For ordered vnet, just choose the first
@@ -103,34 +106,52 @@ RoutingUnit::lookupRoutingTable(int vnet, NetDest msg_destination)
     // To have a strict ordering between links, they should be given
     // different weights in the topology file
 
-    int output_link = -1;
     int min_weight = INFINITE_;
-    std::vector<int> output_link_candidates;
-    int num_candidates = 0;
+    m_output_link_candidates.clear();
 
-    // Identify the minimum weight among the candidate output links
-    for (int link = 0; link < m_routing_table[vnet].size(); link++) {
-        if (msg_destination.intersectionIsNotEmpty(
-            m_routing_table[vnet][link])) {
+    // Collect the candidate output links with the minimum weight in a
+    // single pass; a lighter link restarts the candidate list
+    const std::vector<NetDest> &routes = m_routing_table[vnet];
+    for (int link = 0; link < routes.size(); link++) {
+        if (!msg_destination.intersectionIsNotEmpty(routes[link]))
+            continue;
 
-        if (m_weight_table[link] <= min_weight)
+        if (m_weight_table[link] < min_weight) {
             min_weight = m_weight_table[link];
+            m_output_link_candidates.clear();
         }
+        if (m_weight_table[link] == min_weight)
+            m_output_link_candidates.push_back(link);
     }
 
-    // Collect all candidate output links with this minimum weight
-    for (int link = 0; link < m_routing_table[vnet].size(); link++) {
-        if (msg_destination.intersectionIsNotEmpty(
-            m_routing_table[vnet][link])) {
-
-            if (m_weight_table[link] == min_weight) {
-                num_candidates++;
-                output_link_candidates.push_back(link);
-            }
-        }
+    if (m_output_link_candidates.size() == 0) {
+        fatal("Fatal Error:: No Route exists from this Router.");
+        exit(0);
     }
 
-    if (output_link_candidates.size() == 0) {
+    // Randomly select any candidate output link
+    int candidate = 0;
+    if (!(m_router->get_net_ptr())->isVNetOrdered(vnet))
+        candidate = breakTie(m_output_link_candidates.size());
+
+    return m_output_link_candidates.at(candidate);
+}
+
+
+/*
+ * Same lookup as above for a message with a single destination NI, which
+ * is every flit once the NetworkInterface has split multicasts, using the
+ * table built by compileRoutingTable().
+ */
+int
+RoutingUnit::lookupRoutingTable(int vnet, NodeID dest_ni)
+{
+    const CompiledRoutes &routes = m_compiled_routes[vnet];
+    assert(dest_ni + 1 < routes.offset.size());
+    const int first = routes.offset[dest_ni];
+    const int num_candidates = routes.offset[dest_ni + 1] - first;
+
+    if (num_candidates == 0) {
         fatal("Fatal Error:: No Route exists from this Router.");
         exit(0);
     }
@@ -138,12 +159,79 @@ RoutingUnit::lookupRoutingTable(int vnet, NetDest msg_destination)
     // Randomly select any candidate output link
     int candidate = 0;
     if (!(m_router->get_net_ptr())->isVNetOrdered(vnet))
-        candidate = rand() % num_candidates;
+        candidate = breakTie(num_candidates);
+
+    return routes.candidates[first + candidate];
+}
 
-    output_link = output_link_candidates.at(candidate);
-    return output_link;
+void
+RoutingUnit::seedTieBreaks(uint32_t seed)
+{
+    rng = Random::genRandom(seed);
 }
 
+int
+RoutingUnit::breakTie(int num_candidates)
+{
+    assert(rng);
+    return rng->random<int>(0, num_candidates - 1);
+}
+
+void
+RoutingUnit::compileRoutingTable()
+{
+    GarnetNetwork *net_ptr = m_router->get_net_ptr();
+    RubySystem *ruby_system = net_ptr->getRubySystem();
+    const int num_nis = ruby_system->MachineType_base_number(MachineType_NUM);
+
+    m_compiled_routes.clear();
+    m_compiled_routes.resize(m_routing_table.size());
+    for (int vnet = 0; vnet < m_routing_table.size(); vnet++) {
+        // Apply the lookup rule of lookupRoutingTable() to every
+        // destination at once: walk the links in table order and keep
+        // the ones with the minimum weight seen so far
+        std::vector<int> min_weight(num_nis, INFINITE_);
+        std::vector<std::vector<int>> candidates(num_nis);
+        for (int link = 0; link < m_routing_table[vnet].size(); link++) {
+            const int weight = m_weight_table[link];
+            m_routing_table[vnet][link].forEachElement([&](MachineID mach) {
+                NodeID ni = ruby_system->MachineType_base_number(mach.type) +
+                    mach.num;
+                assert(ni < num_nis);
+                if (weight < min_weight[ni]) {
+                    min_weight[ni] = weight;
+                    candidates[ni].clear();
+                }
+                if (weight == min_weight[ni])
+                    candidates[ni].push_back(link);
+            });
+        }
+
+        CompiledRoutes &routes = m_compiled_routes[vnet];
+        routes.offset.reserve(num_nis + 1);
+        routes.offset.push_back(0);
+        for (int ni = 0; ni < num_nis; ni++) {
+            routes.candidates.insert(routes.candidates.end(),
+                candidates[ni].begin(), candidates[ni].end());
+            routes.offset.push_back(routes.candidates.size());
+        }
+        routes.weight = std::move(min_weight);
+    }
+
+    // XY routes only depend on the destination router
+    m_xy_outports.clear();
+    if (net_ptr->getRoutingAlgorithm() == XY_ && net_ptr->getNumRows() > 0) {
+        const int num_routers = net_ptr->getNumRouters();
+        m_xy_outports.resize(num_routers, -1);
+        for (int dest = 0; dest < num_routers; dest++) {
+            if (dest == m_router->get_id())
+                continue;
+            RouteInfo route;
+            route.dest_router = dest;
+            m_xy_outports[dest] = outportComputeXY(route, -1, "Local");
+        }
+    }
+}
 
 void
 RoutingUnit::addInDirection(PortDirection inport_dirn, int inport_idx)
@@ -157,6 +245,15 @@ RoutingUnit::addOutDirection(PortDirection outport_dirn, int outport_idx)
 {
     m_outports_dirn2idx[outport_dirn] = outport_idx;
     m_outports_idx2dirn[outport_idx]  = outport_dirn;
+
+    if (outport_dirn == "East")
+        m_mesh_outports[MESH_EAST_] = outport_idx;
+    else if (outport_dirn == "West")
+        m_mesh_outports[MESH_WEST_] = outport_idx;
+    else if (outport_dirn == "North")
+        m_mesh_outports[MESH_NORTH_] = outport_idx;
+    else if (outport_dirn == "South")
+        m_mesh_outports[MESH_SOUTH_] = outport_idx;
 }
 
 // outportCompute() is called by the InputUnit
@@ -166,17 +263,19 @@ RoutingUnit::addOutDirection(PortDirection outport_dirn, int outport_idx)
 // table is provided here.
 
 int
-RoutingUnit::outportCompute(RouteInfo route, int inport,
+RoutingUnit::outportCompute(const RouteInfo &route, int inport,
                             PortDirection inport_dirn)
 {
     int outport = -1;
+    const bool compiled = !m_compiled_routes.empty();
 
     if (route.dest_router == m_router->get_id()) {
 
         // Multiple NIs may be connected to this router,
         // all with output port direction = "Local"
         // Get exact outport id from table
-        outport = lookupRoutingTable(route.vnet, route.net_dest);
+        outport = compiled ? lookupRoutingTable(route.vnet, route.dest_ni) :
+            lookupRoutingTable(route.vnet, route.net_dest);
         return outport;
     }
 
@@ -186,14 +285,19 @@ RoutingUnit::outportCompute(RouteInfo route, int inport,
         (RoutingAlgorithm) m_router->get_net_ptr()->getRoutingAlgorithm();
 
     switch (routing_algorithm) {
-        case TABLE_:  outport =
-            lookupRoutingTable(route.vnet, route.net_dest); break;
-        case XY_:     outport =
+        case XY_:     outport = !m_xy_outports.empty() ?
+            m_xy_outports[route.dest_router] :
             outportComputeXY(route, inport, inport_dirn); break;
         // any custom algorithm
         case CUSTOM_: outport =
             outportComputeCustom(route, inport, inport_dirn); break;
-        default: outport =
+        case WEST_FIRST_:
+        case ODD_EVEN_:
+        case DYXY_:   outport =
+            outportComputeAdaptive(route, routing_algorithm); break;
+        case TABLE_:
+        default: outport = compiled ?
+            lookupRoutingTable(route.vnet, route.dest_ni) :
             lookupRoutingTable(route.vnet, route.net_dest); break;
     }
 
@@ -205,7 +309,7 @@ RoutingUnit::outportCompute(RouteInfo route, int inport,
 // Only for reference purpose in a Mesh
 // By default Garnet uses the routing table
 int
-RoutingUnit::outportComputeXY(RouteInfo route,
+RoutingUnit::outportComputeXY(const RouteInfo &route,
                               int inport,
                               PortDirection inport_dirn)
 {
@@ -260,10 +364,116 @@ RoutingUnit::outportComputeXY(RouteInfo route,
     return m_outports_dirn2idx[outport_dirn];
 }
 
+/*
+ * Minimal adaptive routing for a Mesh. The routing algorithm gives the
+ * set of minimal directions a packet may take from this router, and the
+ * one whose downstream input port has the most free buffer slots in the
+ * packet's vnet is chosen (ties go to the X direction).
+ *  - West-first: a packet that has to go west does so first; it may
+ *    then adapt among east, north and south.
+ *  - Odd-even (Chiu, TPDS 2000): east-north/east-south turns are not
+ *    taken in even columns and north-west/south-west turns not in odd
+ *    columns.
+ *  - DyXY (Li et al., DAC 2006): fully adaptive between the X and Y
+ *    directions. Vertical links are split into two VC classes by
+ *    outvcClass(), eastbound and westbound packets never share one,
+ *    which keeps the channel dependency graph acyclic.
+ * West-first and odd-even are deadlock-free with any number of VCs;
+ * DyXY needs at least two per vnet. Ordered vnets always take the first
+ * allowed direction, so their routes stay deterministic.
+ */
+int
+RoutingUnit::outportComputeAdaptive(const RouteInfo &route,
+                                    RoutingAlgorithm routing_algorithm)
+{
+    GarnetNetwork *net_ptr = m_router->get_net_ptr();
+    int num_cols = net_ptr->getNumCols();
+    assert(net_ptr->getNumRows() > 0 && num_cols > 0);
+
+    int my_x = m_router->get_id() % num_cols;
+    int my_y = m_router->get_id() / num_cols;
+    int dest_x = route.dest_router % num_cols;
+    int dest_y = route.dest_router / num_cols;
+    int src_x = route.src_router % num_cols;
+
+    int x_hops = dest_x - my_x;
+    int y_hops = dest_y - my_y;
+    assert(!(x_hops == 0 && y_hops == 0));
+
+    MeshDirection x_dirn = x_hops > 0 ? MESH_EAST_ : MESH_WEST_;
+    MeshDirection y_dirn = y_hops > 0 ? MESH_NORTH_ : MESH_SOUTH_;
+
+    // Allowed directions, X before Y
+    MeshDirection candidates[2];
+    int num_candidates = 0;
+
+    switch (routing_algorithm) {
+      case WEST_FIRST_:
+        if (x_hops != 0)
+            candidates[num_candidates++] = x_dirn;
+        if (y_hops != 0 && x_hops >= 0)
+            candidates[num_candidates++] = y_dirn;
+        break;
+      case ODD_EVEN_:
+        if (x_hops == 0) {
+            candidates[num_candidates++] = y_dirn;
+        } else if (x_hops > 0) {
+            if (y_hops == 0 || dest_x % 2 == 1 || x_hops != 1)
+                candidates[num_candidates++] = MESH_EAST_;
+            if (y_hops != 0 && (my_x % 2 == 1 || my_x == src_x))
+                candidates[num_candidates++] = y_dirn;
+        } else {
+            candidates[num_candidates++] = MESH_WEST_;
+            if (y_hops != 0 && my_x % 2 == 0)
+                candidates[num_candidates++] = y_dirn;
+        }
+        break;
+      case DYXY_:
+        if (x_hops != 0)
+            candidates[num_candidates++] = x_dirn;
+        if (y_hops != 0)
+            candidates[num_candidates++] = y_dirn;
+        break;
+      default:
+        panic("%d is not an adaptive routing algorithm", routing_algorithm);
+    }
+    assert(num_candidates > 0);
+
+    int outport = m_mesh_outports[candidates[0]];
+    if (num_candidates > 1 && !net_ptr->isVNetOrdered(route.vnet)) {
+        int other = m_mesh_outports[candidates[1]];
+        if (m_router->getOutputUnit(other)->get_free_credits(route.vnet) >
+            m_router->getOutputUnit(outport)->get_free_credits(route.vnet)) {
+            outport = other;
+        }
+    }
+
+    assert(outport != -1);
+    return outport;
+}
+
+int
+RoutingUnit::outvcClass(const RouteInfo &route, int outport)
+{
+    GarnetNetwork *net_ptr = m_router->get_net_ptr();
+    if (net_ptr->getRoutingAlgorithm() != DYXY_ ||
+        (outport != m_mesh_outports[MESH_NORTH_] &&
+         outport != m_mesh_outports[MESH_SOUTH_])) {
+        return -1;
+    }
+
+    // Westbound packets use the upper half of the VCs on vertical links,
+    // all others the lower half
+    int num_cols = net_ptr->getNumCols();
+    int my_x = m_router->get_id() % num_cols;
+    int dest_x = route.dest_router % num_cols;
+    return dest_x < my_x ? 1 : 0;
+}
+
 // Template for implementing custom routing algorithm
 // using port directions. (Example adaptive)
 int
-RoutingUnit::outportComputeCustom(RouteInfo route,
+RoutingUnit::outportComputeCustom(const RouteInfo &route,
                                  int inport,
                                  PortDirection inport_dirn)
 {
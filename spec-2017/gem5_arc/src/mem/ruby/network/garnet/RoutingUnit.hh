@@ -31,6 +31,9 @@
 #ifndef __MEM_RUBY_NETWORK_GARNET_0_ROUTINGUNIT_HH__
 #define __MEM_RUBY_NETWORK_GARNET_0_ROUTINGUNIT_HH__
 
+#include <array>
+
+#include "base/random.hh"
 #include "mem/ruby/common/Consumer.hh"
 #include "mem/ruby/common/NetDest.hh"
 #include "mem/ruby/network/garnet/CommonTypes.hh"
@@ -53,7 +56,7 @@ class RoutingUnit
 {
   public:
     RoutingUnit(Router *router);
-    int outportCompute(RouteInfo route,
+    int outportCompute(const RouteInfo &route,
                       int inport,
                       PortDirection inport_dirn);
 
@@ -62,39 +65,86 @@ class RoutingUnit
     void addWeight(int link_weight);
 
     // get output port from routing table
-    int  lookupRoutingTable(int vnet, NetDest net_dest);
+    int  lookupRoutingTable(int vnet, const NetDest &net_dest);
+    // get output port for a single destination NI from the compiled table
+    int  lookupRoutingTable(int vnet, NodeID dest_ni);
+
+    // Seed the generator that breaks this router's routing table ties
+    void seedTieBreaks(uint32_t seed);
+
+    // Compile the routing table (and the XY routes on a mesh) into dense
+    // per-destination arrays. Called once all links have been added.
+    void compileRoutingTable();
 
     // Topology-specific direction based routing
     void addInDirection(PortDirection inport_dirn, int inport);
     void addOutDirection(PortDirection outport_dirn, int outport);
 
     // Routing for Mesh
-    int outportComputeXY(RouteInfo route,
+    int outportComputeXY(const RouteInfo &route,
                          int inport,
                          PortDirection inport_dirn);
 
     // Custom Routing Algorithm using Port Directions
-    int outportComputeCustom(RouteInfo route,
+    int outportComputeCustom(const RouteInfo &route,
                              int inport,
                              PortDirection inport_dirn);
 
+    // Minimal adaptive routing for Mesh (west-first, odd-even, DyXY)
+    int outportComputeAdaptive(const RouteInfo &route,
+                               RoutingAlgorithm routing_algorithm);
+
+    // VC class (see OutputUnit::has_free_vc) a head flit of this route
+    // must be allocated at outport, or -1 for any VC
+    int outvcClass(const RouteInfo &route, int outport);
+
     // Returns true if vnet is present in the vector
     // of vnets or if the vector supports all vnets.
     bool supportsVnet(int vnet, std::vector<int> sVnets);
 
 
   private:
+    // Pick one of num_candidates tied outports
+    int breakTie(int num_candidates);
+
     Router *m_router;
 
     // Routing Table
     std::vector<std::vector<NetDest>> m_routing_table;
     std::vector<int> m_weight_table;
+    // Scratch list reused by lookupRoutingTable()
+    std::vector<int> m_output_link_candidates;
+
+    // Generator for breaking route ties. Each router has its own, so
+    // the choices do not depend on the order in which routers run when
+    // they are spread over several event queues.
+    Random::RandomPtr rng;
+
+    // Routing table of one vnet compiled by compileRoutingTable(). The
+    // minimum-weight candidate outports of destination NI d are
+    // candidates[offset[d]] up to candidates[offset[d + 1]], in the
+    // order the table lists them; weight[d] is their weight.
+    struct CompiledRoutes
+    {
+        std::vector<int> offset;
+        std::vector<int> candidates;
+        std::vector<int> weight;
+    };
+    std::vector<CompiledRoutes> m_compiled_routes;
+
+    // XY outport for each destination router, or -1 if not compiled
+    std::vector<int> m_xy_outports;
 
     // Inport and Outport direction to idx maps
     std::map<PortDirection, int> m_inports_dirn2idx;
     std::map<int, PortDirection> m_inports_idx2dirn;
     std::map<int, PortDirection> m_outports_idx2dirn;
     std::map<PortDirection, int> m_outports_dirn2idx;
+
+    // Outports of the four mesh directions, or -1 if absent
+    enum MeshDirection { MESH_EAST_, MESH_WEST_, MESH_NORTH_, MESH_SOUTH_,
+                         NUM_MESH_DIRECTIONS_ };
+    std::array<int, NUM_MESH_DIRECTIONS_> m_mesh_outports;
 };
 
 } // namespace garnet
@@ -296,8 +296,11 @@ SwitchAllocator::send_allowed(int inport, int invc, int outport, int outvc)
 
         // needs outvc
         // this is only true for HEAD and HEAD_TAIL flits.
+        int vc_class = m_router->get_outvc_class(
+            m_router->getInputUnit(inport)->peekTopFlit(invc)->get_route(),
+            outport);
 
-        if (output_unit->has_free_vc(vnet)) {
+        if (output_unit->has_free_vc(vnet, vc_class)) {
 
             has_outvc = true;
 
@@ -342,8 +345,11 @@ int
 SwitchAllocator::vc_allocate(int outport, int inport, int invc)
 {
     // Select a free VC from the output port
-    int outvc =
-        m_router->getOutputUnit(outport)->select_free_vc(get_vnet(invc));
+    int vc_class = m_router->get_outvc_class(
+        m_router->getInputUnit(inport)->peekTopFlit(invc)->get_route(),
+        outport);
+    int outvc = m_router->getOutputUnit(outport)->select_free_vc(
+        get_vnet(invc), vc_class);
 
     // has to get a valid VC since it checked before performing SA
     assert(outvc != -1);
@@ -362,12 +368,25 @@ SwitchAllocator::check_for_wakeup()
         return;
     }
 
+    const bool elide = m_router->get_net_ptr()->isIdleCycleElisionEnabled();
     for (int i = 0; i < m_num_inports; i++) {
+        auto input_unit = m_router->getInputUnit(i);
         for (int j = 0; j < m_num_vcs; j++) {
-            if (m_router->getInputUnit(i)->need_stage(j, SA_, nextCycle)) {
-                m_router->schedule_wakeup(Cycles(1));
-                return;
+            if (!input_unit->need_stage(j, SA_, nextCycle))
+                continue;
+
+            // A flit that already sits in SA but cannot be sent for lack
+            // of a free output VC or a credit changes nothing by retrying:
+            // only an arriving credit can unblock it, and that wakes the
+            // router up anyway.
+            if (elide && input_unit->need_stage(j, SA_, curTick()) &&
+                !send_allowed(i, j, input_unit->get_outport(j),
+                              input_unit->get_outvc(j))) {
+                continue;
             }
+
+            m_router->schedule_wakeup(Cycles(1));
+            return;
         }
     }
 }
@@ -36,6 +36,7 @@
 
 #include "base/types.hh"
 #include "mem/ruby/network/garnet/CommonTypes.hh"
+#include "mem/ruby/network/garnet/FlitPool.hh"
 #include "mem/ruby/slicc_interface/Message.hh"
 
 namespace gem5
@@ -56,6 +57,20 @@ class flit
 
     virtual ~flit(){};
 
+    // Flits are recycled through a free list instead of the heap
+    static void *
+    operator new(size_t size)
+    {
+        assert(size == sizeof(flit));
+        return FlitPool<flit>::allocate();
+    }
+
+    static void
+    operator delete(void *ptr)
+    {
+        FlitPool<flit>::release(ptr);
+    }
+
     int get_outport() {return m_outport; }
     int get_size() { return m_size; }
     Tick get_enqueue_time() { return m_enqueue_time; }
@@ -65,7 +80,7 @@ class flit
     Tick get_time() { return m_time; }
     int get_vnet() { return m_vnet; }
     int get_vc() { return m_vc; }
-    RouteInfo get_route() { return m_route; }
+    const RouteInfo &get_route() const { return m_route; }
     MsgPtr& get_msg_ptr() { return m_msg_ptr; }
     flit_type get_type() { return m_type; }
     std::pair<flit_stage, Tick> get_stage() { return m_stage; }
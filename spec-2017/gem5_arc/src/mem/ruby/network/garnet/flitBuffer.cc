@@ -31,6 +31,8 @@
 
 #include "mem/ruby/network/garnet/flitBuffer.hh"
 
+#include "base/intmath.hh"
+
 namespace gem5
 {
 
@@ -40,26 +42,42 @@ namespace ruby
 namespace garnet
 {
 
+// Enough for the default VC depths without growing
+static const size_t initialCapacity = 8;
+
 flitBuffer::flitBuffer()
+    : m_buffer(initialCapacity), m_head(0), m_count(0)
 {
     max_size = INFINITE_;
 }
 
 flitBuffer::flitBuffer(int maximum_size)
+    : m_buffer(initialCapacity), m_head(0), m_count(0)
+{
+    setMaxSize(maximum_size);
+}
+
+void
+flitBuffer::grow(size_t capacity)
 {
-    max_size = maximum_size;
+    assert(isPowerOf2(capacity) && capacity >= m_count);
+    std::vector<flit *> ring(capacity);
+    for (size_t i = 0; i < m_count; i++)
+        ring[i] = m_buffer[(m_head + i) & (m_buffer.size() - 1)];
+    m_buffer.swap(ring);
+    m_head = 0;
 }
 
 bool
 flitBuffer::isEmpty()
 {
-    return (m_buffer.size() == 0);
+    return (m_count == 0);
 }
 
 bool
 flitBuffer::isReady(Tick curTime)
 {
-    if (m_buffer.size() != 0 ) {
+    if (m_count != 0) {
         flit *t_flit = peekTopFlit();
         if (t_flit->get_time() <= curTime)
             return true;
@@ -70,27 +88,31 @@ flitBuffer::isReady(Tick curTime)
 void
 flitBuffer::print(std::ostream& out) const
 {
-    out << "[flitBuffer: " << m_buffer.size() << "] " << std::endl;
+    out << "[flitBuffer: " << m_count << "] " << std::endl;
 }
 
 bool
 flitBuffer::isFull()
 {
-    return (m_buffer.size() >= max_size);
+    return (m_count >= max_size);
 }
 
 void
 flitBuffer::setMaxSize(int maximum)
 {
     max_size = maximum;
+    // Size the ring for a bounded buffer up front
+    if (maximum != INFINITE_ && maximum > m_buffer.size())
+        grow(size_t(1) << ceilLog2(maximum));
 }
 
 bool
 flitBuffer::functionalRead(Packet *pkt, WriteMask &mask)
 {
     bool read = false;
-    for (unsigned int i = 0; i < m_buffer.size(); ++i) {
-        if (m_buffer[i]->functionalRead(pkt, mask)) {
+    for (size_t i = 0; i < m_count; ++i) {
+        flit *t_flit = m_buffer[(m_head + i) & (m_buffer.size() - 1)];
+        if (t_flit->functionalRead(pkt, mask)) {
             read = true;
         }
     }
@@ -103,8 +125,9 @@ flitBuffer::functionalWrite(Packet *pkt)
 {
     uint32_t num_functional_writes = 0;
 
-    for (unsigned int i = 0; i < m_buffer.size(); ++i) {
-        if (m_buffer[i]->functionalWrite(pkt)) {
+    for (size_t i = 0; i < m_count; ++i) {
+        flit *t_flit = m_buffer[(m_head + i) & (m_buffer.size() - 1)];
+        if (t_flit->functionalWrite(pkt)) {
             num_functional_writes++;
         }
     }
@@ -120,6 +120,10 @@ WeightBased::findRoute(const Message &msg,
             // Next, we update the msg_destination not to include
             // those nodes that were already handled by this link
             msg_dsts.removeNetDest(dst);
+
+            // Every destination has a link; the rest cannot match
+            if (msg_dsts.isEmpty())
+                break;
         }
     }
 
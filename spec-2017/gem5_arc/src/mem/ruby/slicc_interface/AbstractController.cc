@@ -43,6 +43,7 @@
 #include "debug/RubyQueue.hh"
 #include "mem/ruby/network/Network.hh"
 #include "mem/ruby/protocol/MemoryMsg.hh"
+#include "mem/ruby/system/ParallelWakeup.hh"
 #include "mem/ruby/system/RubySystem.hh"
 #include "mem/ruby/system/Sequencer.hh"
 #include "sim/system.hh"
@@ -92,6 +93,9 @@ AbstractController::init()
     downstreamDestinations.setRubySystem(m_ruby_system);
     upstreamDestinations.setRubySystem(m_ruby_system);
 
+    if (params().parallel_wakeup && m_ruby_system->getParallelWakeup())
+        m_ruby_system->getParallelWakeup()->enroll(this);
+
     // Initialize the addr->downstream machine mappings. Multiple machines
     // in downstream_destinations can have the same address range if they have
     // different types. If this is the case, mapAddressToDownstreamMachine
@@ -457,6 +461,10 @@ const
 
 void
 AbstractController::memRespQueueDequeued() {
+    if (ParallelWakeup::deferring()) {
+        ParallelWakeup::defer([this]{ memRespQueueDequeued(); });
+        return;
+    }
     if (m_mem_ctrl_waiting_retry && !mRetryRespEvent.scheduled()) {
         schedule(mRetryRespEvent, clockEdge(Cycles{1}));
     }
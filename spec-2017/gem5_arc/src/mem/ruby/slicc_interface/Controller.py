@@ -72,6 +72,13 @@ class RubyController(ClockedObject):
         "mandatory queue on top-level controllers",
     )
 
+    parallel_wakeup = Param.Bool(
+        False,
+        "Let the wakeups of this controller run on a host thread alongside "
+        "other controllers due in the same tick (see the RubySystem "
+        "parallel_wakeup_threads parameter)",
+    )
+
     memory_out_port = RequestPort("Port for attaching a memory controller")
     memory = DeprecatedParam(
         memory_out_port,
@@ -41,6 +41,10 @@
 
 #include "mem/ruby/structures/CacheMemory.hh"
 
+#include <algorithm>
+#include <climits>
+
+#include "base/bitfield.hh"
 #include "base/compiler.hh"
 #include "base/intmath.hh"
 #include "base/logging.hh"
@@ -49,6 +53,7 @@
 #include "debug/RubyCacheTrace.hh"
 #include "debug/RubyResourceStalls.hh"
 #include "debug/RubyStats.hh"
+#include "mem/cache/compressors/base.hh"
 #include "mem/cache/replacement_policies/weighted_lru_rp.hh"
 #include "mem/ruby/protocol/AccessPermission.hh"
 #include "mem/ruby/system/RubySystem.hh"
@@ -83,6 +88,20 @@ CacheMemory::CacheMemory(const Params &p)
     m_block_size = p.block_size;  // may be 0 at this point. Updated in init()
     m_use_occupancy = dynamic_cast<replacement_policy::WeightedLRU*>(
                                     m_replacementPolicy_ptr) ? true : false;
+
+    m_compressor = p.compressor;
+    m_blocks_per_superblock = m_compressor ? p.max_compression_ratio : 1;
+    fatal_if(!isPowerOf2(m_blocks_per_superblock),
+             "%s: max_compression_ratio must be a power of 2", name());
+    m_superblock_bits = floorLog2(m_blocks_per_superblock);
+    m_cache_num_ways = m_cache_assoc * m_blocks_per_superblock;
+    m_segment_size = p.segment_size;
+    m_segments_per_block = 0;
+
+    fatal_if(!isPowerOf2(p.prefetch_pollution_filter_size),
+             "%s: prefetch_pollution_filter_size must be a power of 2",
+             name());
+    m_pollution_filter.resize(p.prefetch_pollution_filter_size, false);
 }
 
 void
@@ -110,16 +129,32 @@ CacheMemory::init()
     assert(m_cache_num_set_bits > 0);
 
     m_cache.resize(m_cache_num_sets,
-                    std::vector<AbstractCacheEntry*>(m_cache_assoc, nullptr));
+                  std::vector<AbstractCacheEntry*>(m_cache_num_ways, nullptr));
     replacement_data.resize(m_cache_num_sets,
-                               std::vector<ReplData>(m_cache_assoc, nullptr));
+                            std::vector<ReplData>(m_cache_num_ways, nullptr));
     // instantiate all the replacement_data here
     for (int i = 0; i < m_cache_num_sets; i++) {
-        for ( int j = 0; j < m_cache_assoc; j++) {
+        for ( int j = 0; j < m_cache_num_ways; j++) {
             replacement_data[i][j] =
                                 m_replacementPolicy_ptr->instantiateEntry();
         }
     }
+
+    if (m_compressor) {
+        fatal_if(m_segment_size <= 0 || m_block_size % m_segment_size != 0,
+                 "%s: segment_size must divide the block size", name());
+        m_segments_per_block = m_block_size / m_segment_size;
+        m_block_segments.resize(m_cache_num_sets,
+                                std::vector<int>(m_cache_num_ways, 0));
+        m_block_compressed.resize(m_cache_num_sets,
+                                  std::vector<bool>(m_cache_num_ways, false));
+        m_free_segments.resize(m_cache_num_sets,
+                               m_cache_assoc * m_segments_per_block);
+    }
+
+    cacheMemoryStats.m_effective_capacity_ratio =
+        cacheMemoryStats.m_resident_blocks /
+        statistics::constant(m_cache_num_sets * m_cache_assoc);
 }
 
 CacheMemory::~CacheMemory()
@@ -127,7 +162,7 @@ CacheMemory::~CacheMemory()
     if (m_replacementPolicy_ptr)
         delete m_replacementPolicy_ptr;
     for (int i = 0; i < m_cache_num_sets; i++) {
-        for (int j = 0; j < m_cache_assoc; j++) {
+        for (int j = 0; j < m_cache_num_ways; j++) {
             delete m_cache[i][j];
         }
     }
@@ -138,8 +173,66 @@ int64_t
 CacheMemory::addressToCacheSet(Addr address) const
 {
     assert(address == makeLineAddress(address));
-    return bitSelect(address, m_start_index_bit,
-                     m_start_index_bit + m_cache_num_set_bits - 1);
+    // In compressed mode the blocks of a superblock share a set
+    int start_bit = m_start_index_bit + m_superblock_bits;
+    return bitSelect(address, start_bit,
+                     start_bit + m_cache_num_set_bits - 1);
+}
+
+Addr
+CacheMemory::superblockAddress(Addr address) const
+{
+    return address & ~(mask(m_superblock_bits) << m_start_index_bit);
+}
+
+int
+CacheMemory::superblockOffset(Addr address) const
+{
+    return (address >> m_start_index_bit) & mask(m_superblock_bits);
+}
+
+bool
+CacheMemory::isResident(const AbstractCacheEntry* entry) const
+{
+    return entry != nullptr &&
+        entry->m_Permission != AccessPermission_NotPresent;
+}
+
+int
+CacheMemory::numResidentInSuperblock(int64_t cacheSet, int sb_way) const
+{
+    int num_resident = 0;
+    for (int i = 0; i < m_blocks_per_superblock; i++) {
+        if (isResident(m_cache[cacheSet][sb_way * m_blocks_per_superblock +
+                                         i])) {
+            num_resident++;
+        }
+    }
+    return num_resident;
+}
+
+int
+CacheMemory::findSuperblockWay(int64_t cacheSet, Addr address) const
+{
+    const Addr sb_addr = superblockAddress(address);
+    int free_way = -1;
+    for (int w = 0; w < m_cache_assoc; w++) {
+        bool used = false;
+        for (int i = 0; i < m_blocks_per_superblock; i++) {
+            const AbstractCacheEntry* entry =
+                m_cache[cacheSet][w * m_blocks_per_superblock + i];
+            if (isResident(entry)) {
+                if (superblockAddress(entry->m_Address) == sb_addr) {
+                    return w;
+                }
+                used = true;
+            }
+        }
+        if (!used && free_way == -1) {
+            free_way = w;
+        }
+    }
+    return free_way;
 }
 
 // Given a cache index: returns the index of the tag in a set.
@@ -179,11 +272,11 @@ CacheMemory::getAddressAtIdx(int idx) const
 {
     Addr tmp(0);
 
-    int set = idx / m_cache_assoc;
+    int set = idx / m_cache_num_ways;
     assert(set < m_cache_num_sets);
 
-    int way = idx - set * m_cache_assoc;
-    assert (way < m_cache_assoc);
+    int way = idx - set * m_cache_num_ways;
+    assert (way < m_cache_num_ways);
 
     AbstractCacheEntry* entry = m_cache[set][way];
     if (entry == NULL ||
@@ -273,6 +366,16 @@ CacheMemory::cacheAvail(Addr address) const
 
     int64_t cacheSet = addressToCacheSet(address);
 
+    if (m_compressor) {
+        // Needs the superblock tag (or a free one) and room for the
+        // uncompressed block in the data array
+        if (findTagInSetIgnorePermissions(cacheSet, address) != -1) {
+            return true;
+        }
+        return findSuperblockWay(cacheSet, address) != -1 &&
+            m_free_segments[cacheSet] >= m_segments_per_block;
+    }
+
     for (int i = 0; i < m_cache_assoc; i++) {
         AbstractCacheEntry* entry = m_cache[cacheSet][i];
         if (entry != NULL) {
@@ -299,40 +402,66 @@ CacheMemory::allocate(Addr address, AbstractCacheEntry *entry)
     entry->initBlockSize(m_block_size);
     entry->setRubySystem(m_ruby_system);
 
-    // Find the first open slot
     int64_t cacheSet = addressToCacheSet(address);
     std::vector<AbstractCacheEntry*> &set = m_cache[cacheSet];
+    if (m_compressor) {
+        // The block has a fixed position within its superblock
+        int sb_way = findSuperblockWay(cacheSet, address);
+        assert(sb_way != -1);
+        int i = sb_way * m_blocks_per_superblock + superblockOffset(address);
+        assert(!isResident(set[i]));
+        if (!set[i]) {
+            ++cacheMemoryStats.m_resident_blocks;
+        }
+        // Reserve an uncompressed block until compressBlock() sees the data
+        m_free_segments[cacheSet] += m_block_segments[cacheSet][i] -
+            m_segments_per_block;
+        m_block_segments[cacheSet][i] = m_segments_per_block;
+        m_block_compressed[cacheSet][i] = false;
+        assert(m_free_segments[cacheSet] >= 0);
+        return allocateAt(cacheSet, i, address, entry);
+    }
+
+    // Find the first open slot
     for (int i = 0; i < m_cache_assoc; i++) {
         if (!set[i] || set[i]->m_Permission == AccessPermission_NotPresent) {
-            if (set[i] && (set[i] != entry)) {
-                warn_once("This protocol contains a cache entry handling bug: "
-                    "Entries in the cache should never be NotPresent! If\n"
-                    "this entry (%#x) is not tracked elsewhere, it will memory "
-                    "leak here. Fix your protocol to eliminate these!",
-                    address);
-            }
-            set[i] = entry;  // Init entry
-            set[i]->m_Address = address;
-            set[i]->m_Permission = AccessPermission_Invalid;
-            DPRINTF(RubyCache, "Allocate clearing lock for addr: 0x%x\n",
-                    address);
-            set[i]->m_locked = -1;
-            m_tag_index[address] = i;
-	    set[i]->replacementData = replacement_data[cacheSet][i];
-            set[i]->setPosition(cacheSet, i);
-            
-            set[i]->setLastAccess(curTick());
-
-            // Call reset function here to set initial value for different
-            // replacement policies.
-            m_replacementPolicy_ptr->reset(entry->replacementData);
-
-            return entry;
+            return allocateAt(cacheSet, i, address, entry);
         }
     }
     panic("Allocate didn't find an available entry");
 }
 
+AbstractCacheEntry*
+CacheMemory::allocateAt(int64_t cacheSet, int way, Addr address,
+                        AbstractCacheEntry *entry)
+{
+    std::vector<AbstractCacheEntry*> &set = m_cache[cacheSet];
+    if (set[way] && (set[way] != entry)) {
+        warn_once("This protocol contains a cache entry handling bug: "
+            "Entries in the cache should never be NotPresent! If\n"
+            "this entry (%#x) is not tracked elsewhere, it will memory "
+            "leak here. Fix your protocol to eliminate these!",
+            address);
+    }
+    set[way] = entry;  // Init entry
+    set[way]->m_Address = address;
+    set[way]->m_Permission = AccessPermission_Invalid;
+    DPRINTF(RubyCache, "Allocate clearing lock for addr: 0x%x\n",
+            address);
+    set[way]->m_locked = -1;
+    m_tag_index[address] = way;
+    set[way]->replacementData = replacement_data[cacheSet][way];
+    set[way]->setPosition(cacheSet, way);
+
+    set[way]->setLastAccess(curTick());
+
+    // Call reset function here to set initial value for different
+    // replacement policies.
+    m_replacementPolicy_ptr->reset(entry->replacementData);
+
+    return entry;
+}
+
 void
 CacheMemory::deallocate(Addr address)
 {
@@ -342,6 +471,11 @@ CacheMemory::deallocate(Addr address)
     m_replacementPolicy_ptr->invalidate(entry->replacementData);
     uint32_t cache_set = entry->getSet();
     uint32_t way = entry->getWay();
+    if (m_compressor) {
+        m_free_segments[cache_set] += m_block_segments[cache_set][way];
+        m_block_segments[cache_set][way] = 0;
+        --cacheMemoryStats.m_resident_blocks;
+    }
     delete entry;
     m_cache[cache_set][way] = NULL;
     m_tag_index.erase(address);
@@ -356,14 +490,91 @@ CacheMemory::cacheProbe(Addr address) const
 
     int64_t cacheSet = addressToCacheSet(address);
     std::vector<ReplaceableEntry*> candidates;
-    for (int i = 0; i < m_cache_assoc; i++) {
-        candidates.push_back(static_cast<ReplaceableEntry*>(
+    if (m_compressor) {
+        // The replacement policy still picks the victim; the state of the
+        // set decides which blocks it may pick from. The protocol keeps
+        // probing until cacheAvail() holds, so compaction determines how
+        // many blocks are evicted.
+        if (findSuperblockWay(cacheSet, address) == -1) {
+            // Out of superblock tags: only blocks of the least populated
+            // superblocks are candidates, so that repeated replacements
+            // drain a single tag rather than thinning out all of them.
+            int min_resident = m_blocks_per_superblock;
+            for (int w = 0; w < m_cache_assoc; w++) {
+                min_resident = std::min(min_resident,
+                    numResidentInSuperblock(cacheSet, w));
+            }
+            for (int w = 0; w < m_cache_assoc; w++) {
+                if (numResidentInSuperblock(cacheSet, w) != min_resident) {
+                    continue;
+                }
+                for (int i = 0; i < m_blocks_per_superblock; i++) {
+                    AbstractCacheEntry* entry =
+                        m_cache[cacheSet][w * m_blocks_per_superblock + i];
+                    if (isResident(entry)) {
+                        candidates.push_back(entry);
+                    }
+                }
+            }
+        } else {
+            // Out of data segments: any resident block frees some
+            for (int i = 0; i < m_cache_num_ways; i++) {
+                if (isResident(m_cache[cacheSet][i])) {
+                    candidates.push_back(m_cache[cacheSet][i]);
+                }
+            }
+        }
+        assert(!candidates.empty());
+    } else {
+        for (int i = 0; i < m_cache_assoc; i++) {
+            candidates.push_back(static_cast<ReplaceableEntry*>(
                                                        m_cache[cacheSet][i]));
+        }
     }
     return m_cache[cacheSet][m_replacementPolicy_ptr->
                         getVictim(candidates)->getWay()]->m_Address;
 }
 
+void
+CacheMemory::compressBlock(Addr address, const DataBlock& data)
+{
+    if (!m_compressor) {
+        return;
+    }
+
+    int64_t cacheSet = addressToCacheSet(address);
+    int way = findTagInSetIgnorePermissions(cacheSet, address);
+    assert(way != -1);
+
+    Cycles comp_lat, decomp_lat;
+    const std::size_t size_bits = m_compressor->compressSize(
+        reinterpret_cast<const uint64_t*>(data.getData(0, m_block_size)),
+        comp_lat, decomp_lat);
+    const int segments = std::max<int>(1,
+        divCeil(size_bits, CHAR_BIT * m_segment_size));
+    const int old_segments = m_block_segments[cacheSet][way];
+
+    // The first compression only shrinks the initial reservation
+    if (m_block_compressed[cacheSet][way]) {
+        if (segments > old_segments) {
+            cacheMemoryStats.m_data_expansions++;
+        } else if (segments < old_segments) {
+            cacheMemoryStats.m_data_contractions++;
+        }
+    }
+    m_free_segments[cacheSet] += old_segments - segments;
+    if (segments > old_segments && m_free_segments[cacheSet] < 0) {
+        cacheMemoryStats.m_data_overcommits++;
+    }
+    m_block_segments[cacheSet][way] = segments;
+    m_block_compressed[cacheSet][way] = true;
+    cacheMemoryStats.m_compressed_segments.sample(segments);
+
+    DPRINTF(RubyCache, "address %#x compressed to %d segments, "
+            "%d free in set %d\n", address, segments,
+            m_free_segments[cacheSet], cacheSet);
+}
+
 // looks an address up in the cache
 AbstractCacheEntry*
 CacheMemory::lookup(Addr address)
@@ -428,7 +639,7 @@ int
 CacheMemory::getReplacementWeight(int64_t set, int64_t loc)
 {
     assert(set < m_cache_num_sets);
-    assert(loc < m_cache_assoc);
+    assert(loc < m_cache_num_ways);
     int ret = 0;
     if (m_cache[set][loc] != NULL) {
         ret = m_cache[set][loc]->getNumValidBlocks();
@@ -443,10 +654,10 @@ CacheMemory::recordCacheContents(int cntrl, CacheRecorder* tr) const
 {
     uint64_t warmedUpBlocks = 0;
     [[maybe_unused]] uint64_t totalBlocks = (uint64_t)m_cache_num_sets *
-                                         (uint64_t)m_cache_assoc;
+                                         (uint64_t)m_cache_num_ways;
 
     for (int i = 0; i < m_cache_num_sets; i++) {
-        for (int j = 0; j < m_cache_assoc; j++) {
+        for (int j = 0; j < m_cache_num_ways; j++) {
             if (m_cache[i][j] != NULL) {
                 AccessPermission perm = m_cache[i][j]->m_Permission;
                 RubyRequestType request_type = RubyRequestType_NULL;
@@ -482,7 +693,7 @@ CacheMemory::print(std::ostream& out) const
 {
     out << "Cache dump: " << name() << std::endl;
     for (int i = 0; i < m_cache_num_sets; i++) {
-        for (int j = 0; j < m_cache_assoc; j++) {
+        for (int j = 0; j < m_cache_num_ways; j++) {
             if (m_cache[i][j] != NULL) {
                 out << "  Index: " << i
                     << " way: " << j
@@ -573,7 +784,30 @@ CacheMemoryStats::CacheMemoryStats(statistics::Group *parent)
       ADD_STAT(m_prefetch_misses, "Number of cache prefetch misses"),
       ADD_STAT(m_prefetch_accesses, "Number of cache prefetch accesses",
                m_prefetch_hits + m_prefetch_misses),
-      ADD_STAT(m_accessModeType, "")
+      ADD_STAT(m_prefetch_useful, "Number of demand hits on prefetched "
+               "blocks"),
+      ADD_STAT(m_prefetch_late, "Number of demand misses to blocks with a "
+               "prefetch in flight"),
+      ADD_STAT(m_prefetch_unused, "Number of prefetched blocks replaced "
+               "before use"),
+      ADD_STAT(m_prefetch_polluting, "Number of demand misses to blocks "
+               "replaced by a prefetch"),
+      ADD_STAT(m_prefetch_accuracy, "Fraction of prefetch misses that were "
+               "used by a demand access",
+               (m_prefetch_useful + m_prefetch_late) / m_prefetch_misses),
+      ADD_STAT(m_accessModeType, ""),
+      ADD_STAT(m_resident_blocks, "Average number of resident blocks "
+               "(compressed mode)"),
+      ADD_STAT(m_effective_capacity_ratio, "Resident blocks over the number "
+               "of uncompressed blocks the data array holds"),
+      ADD_STAT(m_compressed_segments, "Data segments used per compressed "
+               "block"),
+      ADD_STAT(m_data_expansions, "Number of writes that grew a compressed "
+               "block"),
+      ADD_STAT(m_data_contractions, "Number of writes that shrank a "
+               "compressed block"),
+      ADD_STAT(m_data_overcommits, "Number of expansions that overflowed "
+               "the data array of their set")
 {
     numDataArrayReads
         .flags(statistics::nozero);
@@ -628,6 +862,21 @@ CacheMemoryStats::CacheMemoryStats(statistics::Group *parent)
     m_prefetch_accesses
         .flags(statistics::nozero);
 
+    m_prefetch_useful
+        .flags(statistics::nozero);
+
+    m_prefetch_late
+        .flags(statistics::nozero);
+
+    m_prefetch_unused
+        .flags(statistics::nozero);
+
+    m_prefetch_polluting
+        .flags(statistics::nozero);
+
+    m_prefetch_accuracy
+        .flags(statistics::nozero | statistics::nonan);
+
     m_accessModeType
         .init(RubyRequestType_NUM)
         .flags(statistics::pdf | statistics::total);
@@ -638,6 +887,26 @@ CacheMemoryStats::CacheMemoryStats(statistics::Group *parent)
             .flags(statistics::nozero)
             ;
     }
+
+    m_resident_blocks
+        .flags(statistics::nozero);
+
+    m_effective_capacity_ratio
+        .flags(statistics::nozero | statistics::nonan);
+
+    m_compressed_segments
+        .init(16)
+        .flags(statistics::pdf | statistics::dist | statistics::nozero |
+            statistics::nonan);
+
+    m_data_expansions
+        .flags(statistics::nozero);
+
+    m_data_contractions
+        .flags(statistics::nozero);
+
+    m_data_overcommits
+        .flags(statistics::nozero);
 }
 
 // assumption: SLICC generated files will only call this function
@@ -820,5 +1089,47 @@ CacheMemory::profilePrefetchMiss()
     cacheMemoryStats.m_prefetch_misses++;
 }
 
+void
+CacheMemory::profilePrefetchUseful()
+{
+    cacheMemoryStats.m_prefetch_useful++;
+}
+
+void
+CacheMemory::profilePrefetchLate()
+{
+    cacheMemoryStats.m_prefetch_late++;
+}
+
+void
+CacheMemory::profilePrefetchUnused()
+{
+    cacheMemoryStats.m_prefetch_unused++;
+}
+
+int
+CacheMemory::pollutionFilterIndex(Addr address) const
+{
+    Addr block = makeLineAddress(address) >> floorLog2(m_block_size);
+    return (block ^ (block >> floorLog2(m_pollution_filter.size()))) &
+        (m_pollution_filter.size() - 1);
+}
+
+void
+CacheMemory::profilePrefetchVictim(Addr address)
+{
+    m_pollution_filter[pollutionFilterIndex(address)] = true;
+}
+
+void
+CacheMemory::profilePrefetchPollution(Addr address)
+{
+    int idx = pollutionFilterIndex(address);
+    if (m_pollution_filter[idx]) {
+        cacheMemoryStats.m_prefetch_polluting++;
+        m_pollution_filter[idx] = false;
+    }
+}
+
 } // namespace ruby
 } // namespace gem5
@@ -64,6 +64,11 @@
 namespace gem5
 {
 
+namespace compression
+{
+class Base;
+} // namespace compression
+
 namespace ruby
 {
 
@@ -111,6 +116,11 @@ class CacheMemory : public SimObject
     // Explicitly free up this address
     void deallocate(Addr address);
 
+    // Recompute the compressed size of a block whose data has just been
+    // written (fill or writeback). Does nothing unless compression is on.
+    void compressBlock(Addr address, const DataBlock& data);
+    bool isCompressed() const { return m_compressor != nullptr; }
+
     // Returns with the physical address of the conflicting cache line
     Addr cacheProbe(Addr address) const;
 
@@ -159,7 +169,7 @@ class CacheMemory : public SimObject
   public:
     int getCacheSize() const { return m_cache_size; }
     int getCacheAssoc() const { return m_cache_assoc; }
-    int getNumBlocks() const { return m_cache_num_sets * m_cache_assoc; }
+    int getNumBlocks() const { return m_cache_num_sets * m_cache_num_ways; }
     Addr getAddressAtIdx(int idx) const;
 
   private:
@@ -171,6 +181,21 @@ class CacheMemory : public SimObject
     int findTagInSet(int64_t line, Addr tag) const;
     int findTagInSetIgnorePermissions(int64_t cacheSet, Addr tag) const;
 
+    // Compressed mode helpers. A set holds m_cache_assoc superblock tags,
+    // each owning m_blocks_per_superblock consecutive ways of m_cache.
+    Addr superblockAddress(Addr address) const;
+    int superblockOffset(Addr address) const;
+    bool isResident(const AbstractCacheEntry* entry) const;
+    int numResidentInSuperblock(int64_t cacheSet, int sb_way) const;
+
+    // Returns the superblock way whose tag matches the address, otherwise
+    // an unused superblock way, otherwise -1.
+    int findSuperblockWay(int64_t cacheSet, Addr address) const;
+
+    // Installs the entry in the given way of the set
+    AbstractCacheEntry* allocateAt(int64_t cacheSet, int way, Addr address,
+                                   AbstractCacheEntry* new_entry);
+
     // Private copy constructor and assignment operator
     CacheMemory(const CacheMemory& obj);
     CacheMemory& operator=(const CacheMemory& obj);
@@ -195,6 +220,8 @@ class CacheMemory : public SimObject
     int m_cache_num_sets;
     int m_cache_num_set_bits;
     int m_cache_assoc;
+    // Number of ways in m_cache. Equals m_cache_assoc unless compressed.
+    int m_cache_num_ways;
     int m_start_index_bit;
     bool m_resource_stalls;
     int m_block_size;
@@ -215,6 +242,32 @@ class CacheMemory : public SimObject
      */
     bool m_use_occupancy;
 
+    /**
+     * Compressed mode state. Tags are shared by superblocks of
+     * m_blocks_per_superblock blocks, and each set owns a data budget of
+     * m_cache_assoc uncompressed blocks, allocated in segments. A block
+     * reserves a full uncompressed block on allocation and shrinks to its
+     * compressed size when compressBlock() sees its data. Blocks that grow
+     * on a later write are allowed to overcommit the budget; the set is then
+     * drained by the following replacements.
+     */
+    compression::Base *m_compressor;
+    int m_blocks_per_superblock;
+    int m_superblock_bits;
+    int m_segment_size;
+    int m_segments_per_block;
+    std::vector<std::vector<int> > m_block_segments;
+    std::vector<std::vector<bool> > m_block_compressed;
+    std::vector<int> m_free_segments;
+
+    /**
+     * Pollution filter: one bit per hashed block address, set when the
+     * block is replaced to make room for a prefetch and cleared by the
+     * next demand miss to it.
+     */
+    std::vector<bool> m_pollution_filter;
+    int pollutionFilterIndex(Addr address) const;
+
     RubySystem *m_ruby_system = nullptr;
 
     Addr
@@ -253,7 +306,21 @@ class CacheMemory : public SimObject
           statistics::Scalar m_prefetch_misses;
           statistics::Formula m_prefetch_accesses;
 
+          statistics::Scalar m_prefetch_useful;
+          statistics::Scalar m_prefetch_late;
+          statistics::Scalar m_prefetch_unused;
+          statistics::Scalar m_prefetch_polluting;
+          statistics::Formula m_prefetch_accuracy;
+
           statistics::Vector m_accessModeType;
+
+          // compressed mode
+          statistics::Average m_resident_blocks;
+          statistics::Formula m_effective_capacity_ratio;
+          statistics::Histogram m_compressed_segments;
+          statistics::Scalar m_data_expansions;
+          statistics::Scalar m_data_contractions;
+          statistics::Scalar m_data_overcommits;
       } cacheMemoryStats;
 
     public:
@@ -263,6 +330,16 @@ class CacheMemory : public SimObject
       void profileDemandMiss();
       void profilePrefetchHit();
       void profilePrefetchMiss();
+
+      // Prefetch effectiveness: a demand hit on a prefetched block
+      // (useful), a demand that found the prefetch still in flight (late),
+      // a prefetched block replaced before any demand (unused), and a
+      // demand miss to a block that was replaced for a prefetch (polluting).
+      void profilePrefetchUseful();
+      void profilePrefetchLate();
+      void profilePrefetchUnused();
+      void profilePrefetchVictim(Addr address);
+      void profilePrefetchPollution(Addr address);
 };
 
 std::ostream& operator<<(std::ostream& out, const CacheMemory& obj);
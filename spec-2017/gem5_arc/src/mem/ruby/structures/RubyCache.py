@@ -24,6 +24,7 @@
 # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+from m5.objects.Compressors import BaseCacheCompressor
 from m5.objects.ReplacementPolicies import *
 from m5.params import *
 from m5.proxy import *
@@ -54,3 +55,21 @@ class RubyCache(SimObject):
     dataAccessLatency = Param.Cycles(1, "cycles for a data array access")
     tagAccessLatency = Param.Cycles(1, "cycles for a tag array access")
     resourceStalls = Param.Bool(False, "stall if there is a resource failure")
+    prefetch_pollution_filter_size = Param.Unsigned(
+        4096, "Entries of the filter of blocks evicted by prefetches"
+    )
+
+    # Compressed mode. When a compressor is given, every tag covers a
+    # superblock of max_compression_ratio consecutive blocks and the data
+    # array of each set is shared by its blocks in segment_size units.
+    compressor = Param.BaseCacheCompressor(
+        NULL,
+        "Cache compressor. Enables superblock tags and variable-size data "
+        "allocation",
+    )
+    max_compression_ratio = Param.Int(
+        2, "Maximum number of blocks per superblock tag in compressed mode"
+    )
+    segment_size = Param.MemorySize(
+        "8B", "Data allocation granularity in compressed mode"
+    )
@@ -41,10 +41,13 @@
 #ifndef __MEM_RUBY_STRUCTURES_TBETABLE_HH__
 #define __MEM_RUBY_STRUCTURES_TBETABLE_HH__
 
+#include <deque>
 #include <iostream>
-#include <unordered_map>
+#include <optional>
+#include <vector>
 
 #include "mem/ruby/common/Address.hh"
+#include "mem/ruby/common/SlotMap.hh"
 #include "mem/ruby/system/RubySystem.hh"
 
 namespace gem5
@@ -58,8 +61,9 @@ class TBETable
 {
   public:
     TBETable(int number_of_TBEs)
-        : m_number_of_TBEs(number_of_TBEs)
+        : m_map(number_of_TBEs), m_number_of_TBEs(number_of_TBEs)
     {
+        m_free.reserve(number_of_TBEs);
     }
 
     bool isPresent(Addr address) const;
@@ -85,9 +89,17 @@ class TBETable
     TBETable& operator=(const TBETable& obj);
 
     // Data Members (m_prefix)
-    std::unordered_map<Addr, ENTRY> m_map;
+    // Index from addresses to TBEs, reserved for number_of_TBEs entries
+    SlotMap<ENTRY *> m_map;
 
   private:
+    // TBEs constructed so far. A deallocated TBE stays where it is and is
+    // reset from m_blank when reused, so the storage of its DataBlock and
+    // other members is only allocated the first time.
+    std::deque<ENTRY> m_entries;
+    std::vector<ENTRY *> m_free;
+    std::optional<ENTRY> m_blank;
+
     int m_number_of_TBEs = 0;
     int m_block_size = 0;
     RubySystem* m_ruby_system = nullptr;
@@ -111,6 +123,8 @@ void TBETable<ENTRY>::setRubySystem(RubySystem* rs)
 {
     m_ruby_system = rs;
     m_block_size = rs->getBlockSizeBytes();
+    m_blank.emplace(m_block_size);
+    m_blank->setRubySystem(m_ruby_system);
 }
 
 template<class ENTRY>
@@ -119,7 +133,7 @@ TBETable<ENTRY>::isPresent(Addr address) const
 {
     assert(address == makeLineAddress(address, floorLog2(m_block_size)));
     assert(m_map.size() <= m_number_of_TBEs);
-    return !!m_map.count(address);
+    return m_map.contains(address);
 }
 
 template<class ENTRY>
@@ -129,9 +143,15 @@ TBETable<ENTRY>::allocate(Addr address)
     assert(!isPresent(address));
     assert(m_map.size() < m_number_of_TBEs);
     assert(m_block_size > 0);
-    ENTRY new_entry = ENTRY(m_block_size);
-    new_entry.setRubySystem(m_ruby_system);
-    m_map.emplace(address, new_entry);
+    ENTRY *entry;
+    if (m_free.empty()) {
+        entry = &m_entries.emplace_back(*m_blank);
+    } else {
+        entry = m_free.back();
+        m_free.pop_back();
+        *entry = *m_blank;
+    }
+    m_map.emplace(address, entry);
 }
 
 template<class ENTRY>
@@ -140,6 +160,7 @@ TBETable<ENTRY>::deallocate(Addr address)
 {
     assert(isPresent(address));
     assert(m_map.size() > 0);
+    m_free.push_back(*m_map.find(address));
     m_map.erase(address);
 }
 
@@ -155,8 +176,8 @@ template<class ENTRY>
 inline ENTRY*
 TBETable<ENTRY>::lookup(Addr address)
 {
-  if (m_map.find(address) != m_map.end()) return &(m_map.find(address)->second);
-  return NULL;
+    ENTRY **entry = m_map.find(address);
+    return entry ? *entry : nullptr;
 }
 
 
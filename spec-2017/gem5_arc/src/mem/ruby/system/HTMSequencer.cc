@@ -173,9 +173,9 @@ HTMSequencer::htmCallback(Addr address,
                mode == HtmCallbackMode_ST_FAIL) {
         // transaction failed
         assert(address == makeLineAddress(address));
-        assert(m_RequestTable.find(address) != m_RequestTable.end());
+        assert(m_RequestTable.contains(address));
 
-        auto &seq_req_list = m_RequestTable[address];
+        auto &seq_req_list = *m_RequestTable.find(address);
         while (!seq_req_list.empty()) {
             SequencerRequest &request = seq_req_list.front();
 
@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2025 Boston University
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "mem/ruby/system/ParallelWakeup.hh"
+
+#include <algorithm>
+#include <cassert>
+
+#include "base/debug.hh"
+#include "base/logging.hh"
+#include "mem/ruby/common/Consumer.hh"
+#include "mem/ruby/system/RubySystem.hh"
+#include "sim/eventq.hh"
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+thread_local ParallelWakeup::Member *ParallelWakeup::tl_current = nullptr;
+
+ParallelWakeup::ParallelWakeup(RubySystem *rs, unsigned num_threads)
+    : m_ruby_system(rs)
+{
+    assert(num_threads > 0);
+    for (unsigned i = 1; i < num_threads; ++i)
+        m_workers.emplace_back([this]{ workerMain(); });
+}
+
+ParallelWakeup::~ParallelWakeup()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_exit = true;
+        m_generation.fetch_add(1, std::memory_order_release);
+    }
+    m_start.notify_all();
+    for (auto &worker : m_workers)
+        worker.join();
+}
+
+void
+ParallelWakeup::enroll(Consumer *consumer)
+{
+    assert(!consumer->m_parallel);
+    consumer->m_parallel = this;
+    consumer->m_parallel_id = m_members.size();
+    m_by_event[&consumer->m_wakeup_event] = m_members.size();
+    m_members.push_back(Member{consumer});
+}
+
+bool
+ParallelWakeup::wakeup(Consumer *consumer)
+{
+    Member &member = m_members[consumer->m_parallel_id];
+    if (member.ranAt == MaxTick && !runAhead(consumer))
+        return false;
+    panic_if(member.ranAt != curTick(),
+             "%s: wakeup that ran ahead at tick %d was never replayed",
+             consumer->getObject()->name(), member.ranAt);
+
+    member.ranAt = MaxTick;
+    --m_pending;
+    for (auto &effect : member.effects)
+        effect();
+    member.effects.clear();
+    member.lines.clear();
+    return true;
+}
+
+bool
+ParallelWakeup::pending(const Consumer *consumer) const
+{
+    return m_members[consumer->m_parallel_id].ranAt != MaxTick;
+}
+
+bool
+ParallelWakeup::runAhead(Consumer *trigger)
+{
+    // Members of an earlier batch of this tick are still to be replayed.
+    if (m_pending != 0)
+        return false;
+
+    // Concurrent DPRINTFs would interleave in the trace, and warming up or
+    // cooling down the caches goes through the shared cache recorder.
+    if (debug::SimpleFlag::anyTracing() ||
+        m_ruby_system->getWarmupEnabled() ||
+        m_ruby_system->getCooldownEnabled()) {
+        return false;
+    }
+
+    // Only the wakeups the event queue services right after the trigger
+    // join it. Nothing else, in particular no CPU-side event issuing a
+    // request to one of their sequencers, runs before them in a serial
+    // run, so none of them can miss anything by running ahead.
+    const Event::Priority prio = trigger->m_wakeup_event.priority();
+    m_batch.clear();
+    m_batch.push_back(&m_members[trigger->m_parallel_id]);
+    curEventQueue()->forEachInHeadBin([&](Event *event) {
+        auto it = m_by_event.find(event);
+        if (it == m_by_event.end() || event->when() != curTick() ||
+            event->priority() != prio) {
+            return false;
+        }
+        m_batch.push_back(&m_members[it->second]);
+        return true;
+    });
+    if (m_batch.size() < 2)
+        return false;
+
+    for (auto member : m_batch)
+        member->ranAt = curTick();
+    m_pending = m_batch.size();
+
+    m_eventq = curEventQueue();
+    m_next_task.store(0, std::memory_order_relaxed);
+    m_running.store(m_workers.size(), std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_generation.fetch_add(1, std::memory_order_release);
+    }
+    m_start.notify_all();
+
+    runTasks();
+    while (m_running.load(std::memory_order_acquire) != 0)
+        std::this_thread::yield();
+    return true;
+}
+
+void
+ParallelWakeup::runTasks()
+{
+    size_t i;
+    while ((i = m_next_task.fetch_add(1, std::memory_order_relaxed)) <
+           m_batch.size()) {
+        tl_current = m_batch[i];
+        tl_current->consumer->wakeup();
+        tl_current = nullptr;
+    }
+}
+
+void
+ParallelWakeup::workerMain()
+{
+    // Batches tend to come in consecutive cycles, so spin for a while
+    // before going to sleep.
+    const int spin_limit = 1 << 14;
+    uint64_t seen = 0;
+    while (true) {
+        for (int i = 0; i < spin_limit &&
+                 m_generation.load(std::memory_order_acquire) == seen; ++i) {
+            std::this_thread::yield();
+        }
+        if (m_generation.load(std::memory_order_acquire) == seen) {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_start.wait(lock, [&]{
+                return m_generation.load(std::memory_order_acquire) != seen;
+            });
+        }
+        seen = m_generation.load(std::memory_order_acquire);
+        if (m_exit)
+            return;
+
+        curEventQueue(m_eventq);
+        runTasks();
+        m_running.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+void
+ParallelWakeup::defer(std::function<void()> effect)
+{
+    assert(tl_current);
+    tl_current->effects.push_back(std::move(effect));
+}
+
+void
+ParallelWakeup::noteLine(Addr line)
+{
+    assert(tl_current);
+    tl_current->lines.push_back(line);
+}
+
+void
+ParallelWakeup::checkEnqueue(Consumer *dst, Tick arrival)
+{
+    if (tl_current) {
+        panic_if(tl_current->consumer != dst,
+                 "%s and %s ran ahead in the same tick but share a "
+                 "message buffer",
+                 tl_current->consumer->getObject()->name(),
+                 dst->getObject()->name());
+    } else {
+        panic_if(arrival <= curTick(),
+                 "%s: message ready at tick %d arrived after its wakeup "
+                 "for that tick ran ahead", dst->getObject()->name(),
+                 arrival);
+    }
+}
+
+void
+ParallelWakeup::checkFunctional(Addr line) const
+{
+    if (m_pending == 0)
+        return;
+    for (auto member : m_batch) {
+        panic_if(member->ranAt != MaxTick &&
+                 std::find(member->lines.begin(), member->lines.end(),
+                           line) != member->lines.end(),
+                 "Functional access to %#x after the wakeup of %s that "
+                 "accessed it ran ahead", line,
+                 member->consumer->getObject()->name());
+    }
+}
+
+} // namespace ruby
+} // namespace gem5
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2025 Boston University
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef __MEM_RUBY_SYSTEM_PARALLELWAKEUP_HH__
+#define __MEM_RUBY_SYSTEM_PARALLELWAKEUP_HH__
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "base/types.hh"
+#include "mem/ruby/common/Address.hh"
+
+namespace gem5
+{
+
+class Event;
+class EventQueue;
+
+namespace ruby
+{
+
+class Consumer;
+class RubySystem;
+
+/**
+ * Runs the wakeups that enrolled consumers, normally the per-core L1
+ * controllers, have due in the same tick on a pool of host threads.
+ *
+ * When the wakeup event of an enrolled consumer fires, it runs ahead
+ * concurrently with the wakeups of the enrolled consumers whose events
+ * the queue services right after it, with no other event in between. While a wakeup runs ahead, the side
+ * effects that reach beyond its controller and sequencer -- scheduling
+ * consumers, dequeue callbacks, responses to the CPU side -- are logged
+ * with defer() instead of performed. Each consumer replays its log when
+ * its own wakeup event comes up, so every event is created in the same
+ * order as in a serial run.
+ *
+ * The run is bit-identical to a serial one as long as a wakeup that ran
+ * ahead could not have observed what the replays of the batch do before
+ * its own: enrolled consumers share no buffers, their inputs have at
+ * least one cycle of latency, and the CPU side neither issues requests
+ * to them nor functionally touches the lines they handed back in that
+ * window. The checks below panic when this does not hold.
+ */
+class ParallelWakeup
+{
+  public:
+    /** Use num_threads host threads, including the simulation thread. */
+    ParallelWakeup(RubySystem *rs, unsigned num_threads);
+    ~ParallelWakeup();
+
+    ParallelWakeup(const ParallelWakeup &) = delete;
+    ParallelWakeup &operator=(const ParallelWakeup &) = delete;
+
+    /** Let the wakeups of the consumer run ahead. */
+    void enroll(Consumer *consumer);
+
+    /**
+     * Called by the wakeup event of an enrolled consumer. Returns true if
+     * its wakeup ran ahead and the deferred effects have been replayed,
+     * false if the caller still has to run the wakeup itself.
+     */
+    bool wakeup(Consumer *consumer);
+
+    /** True while the consumer's run-ahead wakeup awaits replay. */
+    bool pending(const Consumer *consumer) const;
+
+    /** True on a thread that is running a wakeup ahead. */
+    static bool deferring() { return tl_current != nullptr; }
+
+    /** Log an effect of the wakeup running ahead on this thread. */
+    static void defer(std::function<void()> effect);
+
+    /** Record a line handed to the CPU side by the wakeup running ahead. */
+    static void noteLine(Addr line);
+
+    /** Check an enqueue into a buffer of a consumer that ran ahead. */
+    static void checkEnqueue(Consumer *dst, Tick arrival);
+
+    /** Check a functional access to the line against pending wakeups. */
+    void checkFunctional(Addr line) const;
+
+  private:
+    struct Member
+    {
+        Consumer *consumer;
+        /** Tick of the run-ahead wakeup awaiting replay, or MaxTick. */
+        Tick ranAt = MaxTick;
+        std::vector<std::function<void()>> effects;
+        std::vector<Addr> lines;
+    };
+
+    bool runAhead(Consumer *trigger);
+    void runTasks();
+    void workerMain();
+
+    RubySystem *m_ruby_system;
+    std::vector<Member> m_members;
+    /** Members running ahead in the current batch. */
+    std::vector<Member *> m_batch;
+    /** Index in m_members of the consumer with the wakeup event. */
+    std::unordered_map<const Event *, int> m_by_event;
+    int m_pending = 0;
+
+    std::vector<std::thread> m_workers;
+    std::mutex m_mutex;
+    std::condition_variable m_start;
+    std::atomic<uint64_t> m_generation{0};
+    std::atomic<unsigned> m_running{0};
+    std::atomic<size_t> m_next_task{0};
+    EventQueue *m_eventq = nullptr;
+    bool m_exit = false;
+
+    static thread_local Member *tl_current;
+};
+
+} // namespace ruby
+} // namespace gem5
+
+#endif // __MEM_RUBY_SYSTEM_PARALLELWAKEUP_HH__
@@ -48,6 +48,7 @@
 #include "debug/Ruby.hh"
 #include "mem/ruby/protocol/AccessPermission.hh"
 #include "mem/ruby/slicc_interface/AbstractController.hh"
+#include "mem/ruby/system/ParallelWakeup.hh"
 #include "mem/simple_mem.hh"
 #include "sim/full_system.hh"
 #include "sim/system.hh"
@@ -461,6 +462,14 @@ RubyPort::MemResponsePort::recvFunctional(PacketPtr pkt)
 void
 RubyPort::ruby_hit_callback(PacketPtr pkt)
 {
+    if (ParallelWakeup::deferring()) {
+        ParallelWakeup::noteLine(
+            makeLineAddress(pkt->getAddr(),
+                            m_ruby_system->getBlockSizeBits()));
+        ParallelWakeup::defer([this, pkt]{ ruby_hit_callback(pkt); });
+        return;
+    }
+
     DPRINTF(RubyPort, "Hit callback for %s 0x%x\n", pkt->cmdString(),
             pkt->getAddr());
 
@@ -486,6 +495,11 @@ RubyPort::ruby_hit_callback(PacketPtr pkt)
 void
 RubyPort::ruby_unaddressed_callback(PacketPtr pkt)
 {
+    if (ParallelWakeup::deferring()) {
+        ParallelWakeup::defer([this, pkt]{ ruby_unaddressed_callback(pkt); });
+        return;
+    }
+
     DPRINTF(RubyPort, "Unaddressed callback for %s\n", pkt->cmdString());
 
     assert(pkt->isRequest());
@@ -505,6 +519,12 @@ RubyPort::ruby_unaddressed_callback(PacketPtr pkt)
 void
 RubyPort::ruby_stale_translation_callback(Addr txnId)
 {
+    if (ParallelWakeup::deferring()) {
+        ParallelWakeup::defer([this, txnId]{
+            ruby_stale_translation_callback(txnId); });
+        return;
+    }
+
     DPRINTF(RubyPort, "Stale Translation Callback\n");
 
     // Allocate the invalidate request and packet on the stack, as it is
@@ -566,7 +586,14 @@ RubyPort::testDrainComplete()
         DPRINTF(Drain, "Drain count: %u\n", drainCount);
         if (drainCount == 0) {
             DPRINTF(Drain, "RubyPort done draining, signaling drain done\n");
-            signalDrainDone();
+            if (ParallelWakeup::deferring()) {
+                ParallelWakeup::defer([this]{
+                    if (drainState() == DrainState::Draining)
+                        signalDrainDone();
+                });
+            } else {
+                signalDrainDone();
+            }
         }
     }
 }
@@ -706,6 +733,12 @@ RubyPort::MemResponsePort::isPhysMemAddress(PacketPtr pkt) const
 void
 RubyPort::ruby_eviction_callback(Addr address)
 {
+    if (ParallelWakeup::deferring()) {
+        ParallelWakeup::defer([this, address]{
+            ruby_eviction_callback(address); });
+        return;
+    }
+
     DPRINTF(RubyPort, "Sending invalidations.\n");
     // Allocate the invalidate request and packet on the stack, as it is
     // assumed they will not be modified or deleted by receivers.
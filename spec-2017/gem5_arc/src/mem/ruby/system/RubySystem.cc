@@ -88,6 +88,13 @@ RubySystem::RubySystem(const Params &p)
     // Create the profiler
     m_profiler = new Profiler(p, this);
     m_phys_mem = p.phys_mem;
+
+    if (p.parallel_wakeup_threads > 0) {
+        fatal_if(m_randomization, "Controller wakeups cannot run in "
+                 "parallel with randomized message delays");
+        m_parallel_wakeup = std::make_unique<ParallelWakeup>(
+            this, p.parallel_wakeup_threads);
+    }
 }
 
 void
@@ -103,6 +110,11 @@ RubySystem::registerAbstractController(
     m_abs_cntrl_vec.push_back(cntrl);
 
     MachineID id = cntrl->getMachineID();
+    // NetDest reserves NUMBER_BITS_PER_SET bits for each machine type
+    fatal_if(id.getNum() >= NUMBER_BITS_PER_SET,
+             "Number of bits(%d) < size specified(%d). "
+             "Increase the number of bits and recompile.\n",
+             NUMBER_BITS_PER_SET, id.getNum() + 1);
     m_abstract_controls[id.getType()][id.getNum()] = cntrl;
 
     if (!protocolInfo) {
@@ -506,6 +518,10 @@ RubySystem::resetStats()
 
 bool
 RubySystem::functionalRead(PacketPtr pkt) {
+    if (m_parallel_wakeup) {
+        m_parallel_wakeup->checkFunctional(
+            makeLineAddress(pkt->getAddr(), m_block_size_bits));
+    }
     if (protocolInfo->getPartialFuncReads()) {
         return partialFunctionalRead(pkt);
     } else {
@@ -764,6 +780,9 @@ RubySystem::functionalWrite(PacketPtr pkt)
 
     DPRINTF(RubySystem, "Functional Write request for %#x\n", addr);
 
+    if (m_parallel_wakeup)
+        m_parallel_wakeup->checkFunctional(line_addr);
+
     [[maybe_unused]] uint32_t num_functional_writes = 0;
 
     // Only send functional requests within the same network.
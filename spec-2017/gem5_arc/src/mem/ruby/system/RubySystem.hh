@@ -44,6 +44,7 @@
 #include "mem/ruby/slicc_interface/AbstractController.hh"
 #include "mem/ruby/slicc_interface/ProtocolInfo.hh"
 #include "mem/ruby/system/CacheRecorder.hh"
+#include "mem/ruby/system/ParallelWakeup.hh"
 #include "params/RubySystem.hh"
 #include "sim/clocked_object.hh"
 
@@ -76,6 +77,8 @@ class RubySystem : public ClockedObject
     bool getWarmupEnabled() { return m_warmup_enabled; }
     bool getCooldownEnabled() { return m_cooldown_enabled; }
 
+    ParallelWakeup *getParallelWakeup() { return m_parallel_wakeup.get(); }
+
     memory::SimpleMemory *getPhysMem() { return m_phys_mem; }
     Cycles getStartCycle() { return m_start_cycle; }
     bool getAccessBackingStore() { return m_access_backing_store; }
@@ -166,6 +169,8 @@ class RubySystem : public ClockedObject
 
     std::unique_ptr<ProtocolInfo> protocolInfo;
 
+    std::unique_ptr<ParallelWakeup> m_parallel_wakeup;
+
   public:
     Profiler* m_profiler;
     CacheRecorder* m_cache_recorder;
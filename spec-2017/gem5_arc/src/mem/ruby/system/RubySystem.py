@@ -48,6 +48,12 @@ class RubySystem(ClockedObject):
         64, "number of bits that a memory address requires"
     )
 
+    parallel_wakeup_threads = Param.Unsigned(
+        0,
+        "Host threads that run the same-tick wakeups of controllers with "
+        "parallel_wakeup set; the results match a serial run. 0 disables",
+    )
+
     phys_mem = Param.SimpleMemory(NULL, "")
     system = Param.System(Parent.any, "system object")
 
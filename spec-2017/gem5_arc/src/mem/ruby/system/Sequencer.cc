@@ -69,6 +69,9 @@ namespace ruby
 
 Sequencer::Sequencer(const Params &p)
     : RubyPort(p), m_IncompleteTimes(MachineType_NUM),
+      ADD_STAT(m_requestTableOverflows, statistics::units::Count::get(),
+               "Number of times the request table grew past "
+               "max_outstanding_requests"),
       deadlockCheckEvent([this]{ wakeup(); }, "Sequencer deadlock check")
 {
     m_outstanding_count = 0;
@@ -83,6 +86,9 @@ Sequencer::Sequencer(const Params &p)
     assert(m_max_outstanding_requests > 0);
     assert(m_deadlock_threshold > 0);
 
+    m_requestPool.reserve(m_max_outstanding_requests);
+    m_RequestTable.reserve(m_max_outstanding_requests);
+
     m_unaddressedTransactionCnt = 0;
 
     m_runningGarnetStandalone = p.garnet_standalone;
@@ -365,12 +371,18 @@ Sequencer::insertRequest(PacketPtr pkt, RubyRequestType primary_type,
     }
 
     Addr line_addr = makeLineAddress(pkt->getAddr());
+    // The table and its pool only grow past their reservation when HTM
+    // aborts exceed max_outstanding_requests
+    const uint64_t overflows =
+        m_RequestTable.overflows() + m_requestPool.overflows();
     // Check if there is any outstanding request for the same cache line.
-    auto &seq_req_list = m_RequestTable[line_addr];
+    auto &seq_req_list = m_RequestTable.tryEmplace(line_addr, m_requestPool);
     // Create a default entry
     seq_req_list.emplace_back(pkt, primary_type,
         secondary_type, curCycle());
     m_outstanding_count++;
+    m_requestTableOverflows +=
+        m_RequestTable.overflows() + m_requestPool.overflows() - overflows;
 
     if (seq_req_list.size() > 1) {
         return RequestStatus_Aliased;
@@ -473,8 +485,8 @@ Sequencer::writeCallback(Addr address, DataBlock& data,
     // to this cache line when response for the write comes back
     //
     assert(address == makeLineAddress(address));
-    assert(m_RequestTable.find(address) != m_RequestTable.end());
-    auto &seq_req_list = m_RequestTable[address];
+    assert(m_RequestTable.contains(address));
+    auto &seq_req_list = *m_RequestTable.find(address);
 
     // Perform hitCallback on every cpu request made to this cache block while
     // ruby request was outstanding. Since only 1 ruby request was made,
@@ -603,8 +615,8 @@ Sequencer::readCallback(Addr address, DataBlock& data,
     // or end of the corresponding list.
     //
     assert(address == makeLineAddress(address));
-    assert(m_RequestTable.find(address) != m_RequestTable.end());
-    auto &seq_req_list = m_RequestTable[address];
+    assert(m_RequestTable.contains(address));
+    auto &seq_req_list = *m_RequestTable.find(address);
 
     // Perform hitCallback on every cpu request made to this cache block while
     // ruby request was outstanding. Since only 1 ruby request was made,
@@ -650,8 +662,8 @@ Sequencer::atomicCallback(Addr address, DataBlock& data,
     // (the opperation could be performed remotly)
     //
     assert(address == makeLineAddress(address));
-    assert(m_RequestTable.find(address) != m_RequestTable.end());
-    auto &seq_req_list = m_RequestTable[address];
+    assert(m_RequestTable.contains(address));
+    auto &seq_req_list = *m_RequestTable.find(address);
 
     // Perform hitCallback only on the first cpu request that
     // issued the ruby request
@@ -939,6 +951,12 @@ Sequencer::empty() const
 RequestStatus
 Sequencer::makeRequest(PacketPtr pkt)
 {
+    // The controller wakeup for this tick already ran ahead without
+    // seeing this request, which it would have in a serial run.
+    panic_if(m_controller->ranAhead(),
+             "%s: request issued after the wakeup of %s ran ahead",
+             name(), m_controller->name());
+
     // HTM abort signals must be allowed to reach the Sequencer
     // the same cycle they are issued. They cannot be retried.
     if ((m_outstanding_count >= m_max_outstanding_requests) &&
@@ -1167,9 +1185,8 @@ Sequencer::issueRequest(PacketPtr pkt, RubyRequestType secondary_type)
                                m_ruby_system->getWarmupEnabled());
 }
 
-template <class KEY, class VALUE>
 std::ostream &
-operator<<(std::ostream &out, const std::unordered_map<KEY, VALUE> &map)
+operator<<(std::ostream &out, const SlotMap<SequencerRequestQueue> &map)
 {
     for (const auto &table_entry : map) {
         out << "[ " << table_entry.first << " =";
@@ -42,11 +42,12 @@
 #define __MEM_RUBY_SYSTEM_SEQUENCER_HH__
 
 #include <iostream>
-#include <list>
 #include <unordered_map>
+#include <utility>
 
 #include "cpu/testers/rubytest/RubyTester.hh"
 #include "mem/ruby/common/Address.hh"
+#include "mem/ruby/common/SlotMap.hh"
 #include "mem/ruby/protocol/MachineType.hh"
 #include "mem/ruby/protocol/RubyRequestType.hh"
 #include "mem/ruby/protocol/SequencerRequestType.hh"
@@ -84,6 +85,105 @@ struct SequencerRequest
 
 std::ostream& operator<<(std::ostream& out, const SequencerRequest& obj);
 
+/**
+ * The requests outstanding for one line, oldest first. The requests of
+ * all the lines live in one SlotPool, linked through their slots, so
+ * queueing a request does not allocate memory once the pool has been
+ * reserved.
+ */
+class SequencerRequestQueue
+{
+  public:
+    struct Node
+    {
+        template <class... Args>
+        Node(Args&&... args) : request(std::forward<Args>(args)...) {}
+
+        SequencerRequest request;
+        int next = -1;
+    };
+    typedef SlotPool<Node> Pool;
+
+  private:
+    template <class Queue, class Value>
+    class Iterator
+    {
+      public:
+        Iterator(Queue *queue, int id) : m_queue(queue), m_id(id) {}
+
+        Value &
+        operator*() const
+        {
+            return m_queue->m_pool[m_id].request;
+        }
+
+        Iterator &
+        operator++()
+        {
+            m_id = m_queue->m_pool[m_id].next;
+            return *this;
+        }
+
+        bool operator!=(const Iterator &o) const { return m_id != o.m_id; }
+
+      private:
+        Queue *m_queue;
+        int m_id;
+    };
+
+  public:
+    typedef Iterator<SequencerRequestQueue, SequencerRequest> iterator;
+    typedef Iterator<const SequencerRequestQueue, const SequencerRequest>
+        const_iterator;
+
+    explicit SequencerRequestQueue(Pool &pool) : m_pool(pool) {}
+    ~SequencerRequestQueue() { while (!empty()) pop_front(); }
+
+    SequencerRequestQueue(const SequencerRequestQueue &) = delete;
+    SequencerRequestQueue &operator=(const SequencerRequestQueue &) = delete;
+
+    bool empty() const { return m_head < 0; }
+    int size() const { return m_size; }
+
+    SequencerRequest &front() { return m_pool[m_head].request; }
+
+    template <class... Args>
+    void
+    emplace_back(Args&&... args)
+    {
+        const int id = m_pool.allocate(std::forward<Args>(args)...);
+        if (m_tail < 0)
+            m_head = id;
+        else
+            m_pool[m_tail].next = id;
+        m_tail = id;
+        m_size++;
+    }
+
+    void
+    pop_front()
+    {
+        assert(!empty());
+        const int id = m_head;
+        m_head = m_pool[id].next;
+        if (m_head < 0)
+            m_tail = -1;
+        m_pool.release(id);
+        m_size--;
+    }
+
+    iterator begin() { return iterator(this, m_head); }
+    iterator end() { return iterator(this, -1); }
+    const_iterator begin() const { return const_iterator(this, m_head); }
+    const_iterator end() const { return const_iterator(this, -1); }
+
+  private:
+    Pool &m_pool;
+    int m_head = -1;
+    int m_tail = -1;
+    int m_size = 0;
+};
+
 class Sequencer : public RubyPort
 {
   public:
@@ -242,8 +342,13 @@ class Sequencer : public RubyPort
     Sequencer& operator=(const Sequencer& obj);
 
   protected:
-    // RequestTable contains both read and write requests, handles aliasing
-    std::unordered_map<Addr, std::list<SequencerRequest>> m_RequestTable;
+    // Storage for the requests queued in m_RequestTable. Declared first
+    // so it outlives the queues.
+    SequencerRequestQueue::Pool m_requestPool;
+    // RequestTable contains both read and write requests, handles aliasing.
+    // Both are reserved for max_outstanding_requests, so the steady state
+    // does not allocate.
+    SlotMap<SequencerRequestQueue> m_RequestTable;
     // UnadressedRequestTable contains "unaddressed" requests,
     // guaranteed not to alias each other
     std::unordered_map<uint64_t, SequencerRequest> m_UnaddressedRequestTable;
@@ -317,6 +422,10 @@ class Sequencer : public RubyPort
     std::vector<statistics::Histogram *> m_FirstResponseToCompletionDelayHist;
     std::vector<statistics::Counter> m_IncompleteTimes;
 
+    //! Number of requests that found the request table full, which
+    //! then grew past max_outstanding_requests.
+    statistics::Scalar m_requestTableOverflows;
+
     EventFunctionWrapper deadlockCheckEvent;
 
     // support for LL/SC
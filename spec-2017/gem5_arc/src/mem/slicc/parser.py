@@ -60,15 +60,19 @@ class SLICC(Grammar):
         base_dir,
         verbose=False,
         traceback=False,
+        table_dispatch=False,
         **kwargs,
     ):
         """Entrypoint for SLICC parsing
         protocol: The protocol `.slicc` file to parse
         includes: list of `.slicc` files that are shared between all protocols
+        table_dispatch: generate doTransitionWorker as a lookup in constant
+            transition tables instead of a switch
         """
         self.protocol = None
         self.traceback = traceback
         self.verbose = verbose
+        self.table_dispatch = table_dispatch
         self.symtab = SymbolTable(self)
         self.base_dir = base_dir
 
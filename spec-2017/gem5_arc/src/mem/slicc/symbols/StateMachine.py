@@ -1810,10 +1810,30 @@ ${ident}_Controller::doTransitionWorker(${ident}_Event event,
 {
     m_curTransitionEvent = event;
     m_curTransitionNextState = next_state;
-    switch(HASH_FUN(state, event)) {
 """
         )
 
+        if self.symtab.slicc.table_dispatch:
+            self.printCTransitionTable(code)
+        else:
+            self.printCTransitionSwitch(code)
+
+        code(
+            """
+
+} // namespace ${protocol}
+} // namespace ruby
+} // namespace gem5
+"""
+        )
+        code.write(path, f"{gen_filename}_Transitions.cc")
+
+    def printCTransitionSwitch(self, code):
+        """Body of doTransitionWorker as a switch over (state, event)"""
+        ident = self.ident
+
+        code("    switch(HASH_FUN(state, event)) {")
+
         # This map will allow suppress generating duplicate code
         cases = OrderedDict()
 
@@ -1936,13 +1956,240 @@ if (!checkResourceAvailable({}_RequestType_{}, addr)) {{
 
     return TransitionResult_Valid;
 }
+"""
+        )
 
-} // namespace ${protocol}
-} // namespace ruby
-} // namespace gem5
+    def printCTransitionTable(self, code):
+        """Body of doTransitionWorker as a lookup in constant tables
+
+        Each (state, event) pair indexes a row giving the next state, a
+        mask of resource checks and the ranges of request types to record
+        and actions to run. Identical transitions share a row. The checks
+        are numbered in the order the switch version tests them, so both
+        stall on the same resource first.
+        """
+        ident = self.ident
+        c_ident = f"{ident}_Controller"
+
+        # The switch version emits its checks sorted by their code; number
+        # them globally in that order
+        checks = {}
+        for trans in self.transitions:
+            for key, val in trans.resources.items():
+                check = f"{key.code}.areNSlotsAvailable({val}, clockEdge())"
+                checks[f"\nif (!{check})\n"] = check
+            for request_type in trans.request_types:
+                check = (
+                    f"checkResourceAvailable({ident}_RequestType_"
+                    f"{request_type.ident}, addr)"
+                )
+                checks[f"\nif (!{check}) {{\n"] = check
+        check_bits = {}
+        for bit, key in enumerate(sorted(checks)):
+            check_bits[checks[key]] = bit
+        if len(check_bits) > 64:
+            self.error(
+                f"{ident} has {len(check_bits)} distinct resource checks; "
+                "table dispatch supports at most 64"
+            )
+
+        if self.TBEType != None and self.EntryType != None:
+            action_args = "m_tbe_ptr, m_cache_entry_ptr, addr"
+            action_params = (
+                f"{self.TBEType.c_ident}*&, {self.EntryType.c_ident}*&, Addr"
+            )
+        elif self.TBEType != None:
+            action_args = "m_tbe_ptr, addr"
+            action_params = f"{self.TBEType.c_ident}*&, Addr"
+        elif self.EntryType != None:
+            action_args = "m_cache_entry_ptr, addr"
+            action_params = f"{self.EntryType.c_ident}*&, Addr"
+        else:
+            action_args = "addr"
+            action_params = "Addr"
+
+        # Row 0 marks (state, event) pairs without a transition
+        rows = OrderedDict()
+        rows[None] = 0
+        request_seq = []
+        action_seq = []
+        index = []
+        has_wildcard = False
+        for trans in self.transitions:
+            if trans.state == trans.nextState:
+                next_state = "NextStateUnchanged"
+            elif trans.nextState.isWildcard():
+                next_state = "NextStateComputed"
+                has_wildcard = True
+            else:
+                next_state = f"int({ident}_State_{trans.nextState.ident})"
+
+            mask = 0
+            for key, val in trans.resources.items():
+                check = f"{key.code}.areNSlotsAvailable({val}, clockEdge())"
+                mask |= 1 << check_bits[check]
+            for request_type in trans.request_types:
+                check = (
+                    f"checkResourceAvailable({ident}_RequestType_"
+                    f"{request_type.ident}, addr)"
+                )
+                mask |= 1 << check_bits[check]
+
+            requests = tuple(rt.ident for rt in trans.request_types)
+            stall = any(a.ident == "z_stall" for a in trans.actions)
+            actions = () if stall else tuple(a.ident for a in trans.actions)
+
+            row = (next_state, mask, requests, stall, actions)
+            if row not in rows:
+                rows[row] = len(rows)
+            index.append((trans, rows[row]))
+
+        code(
+            """
+
+    // One row per distinct transition; row 0 is an invalid pair
+    typedef void (${c_ident}::*Action)(${action_params});
+    struct TransitionRow
+    {
+        int nextState;
+        uint64_t resources;
+        bool stall;
+        uint16_t firstRequest;
+        uint16_t numRequests;
+        uint16_t firstAction;
+        uint16_t numActions;
+    };
+    static constexpr int NextStateUnchanged = -1;
+"""
+        )
+        if has_wildcard:
+            code("    static constexpr int NextStateComputed = -2;")
+        code(
+            """
+
+    static constexpr TransitionRow rows[] = {
+        {NextStateUnchanged, 0, false, 0, 0, 0, 0},
+"""
+        )
+        for row in list(rows)[1:]:
+            next_state, mask, requests, stall, actions = row
+            code(
+                f"        {{{next_state}, {mask:#x}ULL, "
+                f"{'true' if stall else 'false'}, "
+                f"{len(request_seq)}, {len(requests)}, "
+                f"{len(action_seq)}, {len(actions)}}},"
+            )
+            request_seq += requests
+            action_seq += actions
+        code("    };")
+
+        if request_seq:
+            code(
+                f"    static constexpr {ident}_RequestType requestTypes[] = {{"
+            )
+            for request in request_seq:
+                code(f"        {ident}_RequestType_{request},")
+            code("    };")
+        if action_seq:
+            code("    static constexpr Action actions[] = {")
+            for action in action_seq:
+                code(f"        &{c_ident}::{action},")
+            code("    };")
+
+        code(
+            """
+
+    struct TransitionIndex
+    {
+        uint16_t row[${ident}_State_NUM][${ident}_Event_NUM];
+    };
+    static constexpr TransitionIndex index = [] {
+        TransitionIndex t{};
+"""
+        )
+        for trans, row in index:
+            code(
+                f"        t.row[{ident}_State_{trans.state.ident}]"
+                f"[{ident}_Event_{trans.event.ident}] = {row};"
+            )
+        code(
+            """
+        return t;
+    }();
+    static_assert(sizeof(rows) / sizeof(rows[0]) <= UINT16_MAX + 1,
+                  "too many transition rows");
+
+    const uint16_t row_id = index.row[state][event];
+    if (row_id == 0) {
+        panic("Invalid transition\\n"
+              "%s time: %d addr: %#x event: %s state: %s\\n",
+              name(), curCycle(), addr, event, state);
+    }
+    const TransitionRow &row = rows[row_id];
+"""
+        )
+
+        if has_wildcard:
+            code(
+                """
+    if (row.nextState == NextStateComputed) {
+        next_state = getNextState(addr);
+        m_curTransitionNextState = next_state;
+    } else if (row.nextState != NextStateUnchanged) {
+"""
+            )
+        else:
+            code(
+                """
+    if (row.nextState != NextStateUnchanged) {
+"""
+            )
+        code(
+            """
+        next_state = ${ident}_State(row.nextState);
+        m_curTransitionNextState = next_state;
+    }
+"""
+        )
+
+        if check_bits:
+            code("")
+            for check, bit in check_bits.items():
+                code(
+                    f"    if ((row.resources & (1ULL << {bit})) &&\n"
+                    f"        !{check})\n"
+                    f"        return TransitionResult_ResourceStall;"
+                )
+
+        if request_seq:
+            code(
+                """
+
+    for (int i = 0; i < row.numRequests; i++)
+        recordRequestType(requestTypes[row.firstRequest + i], addr);
+"""
+            )
+
+        code(
+            """
+
+    if (row.stall)
+        return TransitionResult_ProtocolStall;
+"""
+        )
+        if action_seq:
+            code(
+                """
+    for (int i = 0; i < row.numActions; i++)
+        (this->*actions[row.firstAction + i])(${action_args});
+"""
+            )
+        code(
+            """
+    return TransitionResult_Valid;
+}
 """
         )
-        code.write(path, f"{gen_filename}_Transitions.cc")
 
     # **************************
     # ******* HTML Files *******
@@ -42,6 +42,7 @@
 
 #include "mem/snoop_filter.hh"
 
+#include "base/intmath.hh"
 #include "base/logging.hh"
 #include "base/trace.hh"
 #include "debug/SnoopFilter.hh"
@@ -52,17 +53,174 @@ namespace gem5
 
 const int SnoopFilter::SNOOP_MASK_SIZE;
 
+SnoopFilter::SnoopFilter(const SnoopFilterParams &p) :
+    SimObject(p),
+    assoc(p.assoc), numSets(p.sets),
+    setShift(floorLog2(p.system->cacheLineSize())),
+    replacementPolicy(p.replacement_policy), numEntries(0),
+    requestorId(p.system->getRequestorId(this)), system(p.system),
+    linesize(p.system->cacheLineSize()), lookupLatency(p.lookup_latency),
+    maxEntryCount(p.max_capacity / p.system->cacheLineSize()),
+    stats(this)
+{
+    if (!assoc)
+        return;
+
+    fatal_if(!isPowerOf2(numSets),
+             "%s: the number of sets must be a power of 2, got %d\n",
+             name(), numSets);
+    fatal_if(!replacementPolicy,
+             "%s: a set-associative snoop filter needs a replacement "
+             "policy\n", name());
+
+    const unsigned num_ways = numSets * assoc;
+    tags.resize(num_ways, InvalidTag);
+    items.resize(num_ways);
+    evictedTags.resize(num_ways, InvalidTag);
+    replEntries.resize(num_ways);
+    for (unsigned idx = 0; idx < num_ways; idx++) {
+        replEntries[idx].replacementData =
+            replacementPolicy->instantiateEntry();
+        replEntries[idx].setPosition(idx / assoc, idx % assoc);
+    }
+}
+
+unsigned
+SnoopFilter::extractSet(Addr line_addr) const
+{
+    // Fold the bits above the index onto it, so that strided footprints
+    // spread over the sets
+    const Addr line = line_addr >> setShift;
+    return (line ^ (line >> floorLog2(numSets))) & (numSets - 1);
+}
+
+SnoopFilter::SnoopItem *
+SnoopFilter::findItem(Addr line_addr)
+{
+    if (assoc) {
+        const unsigned base = extractSet(line_addr) * assoc;
+        for (unsigned way = 0; way < assoc; way++) {
+            if (tags[base + way] == line_addr)
+                return &items[base + way];
+        }
+        if (cachedLocations.empty())
+            return nullptr;
+    }
+    auto sf_it = cachedLocations.find(line_addr);
+    return sf_it == cachedLocations.end() ? nullptr : &sf_it->second;
+}
+
+SnoopFilter::SnoopItem *
+SnoopFilter::allocateItem(Addr line_addr)
+{
+    if (!assoc)
+        return &cachedLocations.emplace(line_addr, SnoopItem()).first->second;
+
+    const unsigned base = extractSet(line_addr) * assoc;
+    for (unsigned way = 0; way < assoc; way++) {
+        if (evictedTags[base + way] == line_addr) {
+            // The line was re-requested after an eviction took it away
+            stats.backInvalidationMisses++;
+            evictedTags[base + way] = InvalidTag;
+            break;
+        }
+    }
+
+    int free_way = -1;
+    ReplacementCandidates candidates;
+    for (unsigned way = 0; way < assoc; way++) {
+        if (tags[base + way] == InvalidTag) {
+            free_way = way;
+            break;
+        }
+        // Evicting lines with requests in flight would lose track of
+        // the responses
+        if (items[base + way].requested.none())
+            candidates.push_back(&replEntries[base + way]);
+    }
+
+    if (free_way < 0) {
+        if (candidates.empty()) {
+            DPRINTF(SnoopFilter, "%s:   set of %#x is busy, overflowing\n",
+                    __func__, line_addr);
+            stats.overflows++;
+            return &cachedLocations.emplace(line_addr,
+                                            SnoopItem()).first->second;
+        }
+        free_way = replacementPolicy->getVictim(candidates)->getWay();
+        backInvalidate(base + free_way);
+    }
+
+    const unsigned idx = base + free_way;
+    tags[idx] = line_addr;
+    items[idx] = SnoopItem();
+    replacementPolicy->reset(replEntries[idx].replacementData);
+    stats.occupancy = ++numEntries;
+    return &items[idx];
+}
+
+void
+SnoopFilter::touchItem(SnoopItem *item)
+{
+    if (inArray(item)) {
+        replacementPolicy->touch(
+            replEntries[item - items.data()].replacementData);
+    }
+}
+
 void
-SnoopFilter::eraseIfNullEntry(SnoopFilterCache::iterator& sf_it)
+SnoopFilter::eraseIfNullEntry(SnoopItem *item, Addr line_addr)
 {
-    SnoopItem& sf_item = sf_it->second;
-    if ((sf_item.requested | sf_item.holder).none()) {
-        cachedLocations.erase(sf_it);
+    if ((item->requested | item->holder).none()) {
+        if (inArray(item)) {
+            const unsigned idx = item - items.data();
+            tags[idx] = InvalidTag;
+            replacementPolicy->invalidate(replEntries[idx].replacementData);
+            stats.occupancy = --numEntries;
+        } else {
+            cachedLocations.erase(line_addr);
+        }
         DPRINTF(SnoopFilter, "%s:   Removed SF entry.\n",
                 __func__);
     }
 }
 
+void
+SnoopFilter::backInvalidate(unsigned way_idx)
+{
+    const Addr line_addr = tags[way_idx];
+    const SnoopMask holders = items[way_idx].holder;
+    assert(items[way_idx].requested.none());
+
+    DPRINTF(SnoopFilter, "%s: evicting %#x SF value %x.%x\n", __func__,
+            line_addr, items[way_idx].requested, holders);
+
+    tags[way_idx] = InvalidTag;
+    evictedTags[way_idx] = line_addr;
+    replacementPolicy->invalidate(replEntries[way_idx].replacementData);
+    stats.occupancy = --numEntries;
+    stats.capacityEvictions++;
+
+    // The holders, and the caches above them, drop the line. Dirty
+    // copies are written back below us with a WriteClean.
+    Request::Flags flags = Request::CLEAN | Request::INVALIDATE;
+    if (line_addr & LineSecure)
+        flags.set(Request::SECURE);
+    RequestPtr req = std::make_shared<Request>(
+        line_addr & ~Addr(linesize - 1), linesize, flags, requestorId);
+    for (const auto& p : maskToPortList(holders)) {
+        Packet pkt(req, MemCmd::CleanInvalidReq);
+        pkt.setBackInvalidation();
+        stats.backInvalidations++;
+        if (system->isTimingMode()) {
+            pkt.setExpressSnoop();
+            p->sendTimingSnoopReq(&pkt);
+        } else {
+            p->sendAtomicSnoop(&pkt);
+        }
+    }
+}
+
 std::pair<SnoopFilter::SnoopList, Cycles>
 SnoopFilter::lookupRequest(const Packet* cpkt, const ResponsePort&
                            cpu_side_port)
@@ -78,21 +236,24 @@ SnoopFilter::lookupRequest(const Packet* cpkt, const ResponsePort&
         line_addr |= LineSecure;
     }
     SnoopMask req_port = portToMask(cpu_side_port);
-    reqLookupResult.it = cachedLocations.find(line_addr);
-    bool is_hit = (reqLookupResult.it != cachedLocations.end());
+    reqLookupResult.item = findItem(line_addr);
+    reqLookupResult.lineAddr = line_addr;
+    bool is_hit = reqLookupResult.item;
 
     // If the snoop filter has no entry, and we should not allocate,
     // do not create a new snoop filter entry, simply return a NULL
-    // portlist.
-    if (!is_hit && !allocate)
+    // portlist. The same goes for evictions of lines that a bounded
+    // filter back-invalidated while they were on their way.
+    if (!is_hit && (!allocate || (assoc && cpkt->isEviction())))
         return snoopDown(lookupLatency);
 
-    // If no hit in snoop filter create a new element and update iterator
+    // If no hit in snoop filter create a new element
     if (!is_hit) {
-        reqLookupResult.it =
-            cachedLocations.emplace(line_addr, SnoopItem()).first;
+        reqLookupResult.item = allocateItem(line_addr);
+    } else {
+        touchItem(reqLookupResult.item);
     }
-    SnoopItem& sf_item = reqLookupResult.it->second;
+    SnoopItem& sf_item = *reqLookupResult.item;
     SnoopMask interested = sf_item.holder | sf_item.requested;
 
     // Store unmodified value of snoop filter item in temp storage in
@@ -159,10 +320,10 @@ SnoopFilter::lookupRequest(const Packet* cpkt, const ResponsePort&
 void
 SnoopFilter::finishRequest(bool will_retry, Addr addr, bool is_secure)
 {
-    if (reqLookupResult.it != cachedLocations.end()) {
+    if (reqLookupResult.item) {
         // since we rely on the caller, do a basic check to ensure
         // that finishRequest is being called following lookupRequest
-        assert(reqLookupResult.it->first == \
+        assert(reqLookupResult.lineAddr == \
                 (is_secure ? ((addr & ~(Addr(linesize - 1))) | LineSecure) : \
                  (addr & ~(Addr(linesize - 1)))));
         if (will_retry) {
@@ -170,13 +331,14 @@ SnoopFilter::finishRequest(bool will_retry, Addr addr, bool is_secure)
             // Undo any changes made in lookupRequest to the snoop filter
             // entry if the request will come again. retryItem holds
             // the previous value of the snoopfilter entry.
-            reqLookupResult.it->second = retry_item;
+            *reqLookupResult.item = retry_item;
 
             DPRINTF(SnoopFilter, "%s:   restored SF value %x.%x\n",
                     __func__,  retry_item.requested, retry_item.holder);
         }
 
-        eraseIfNullEntry(reqLookupResult.it);
+        eraseIfNullEntry(reqLookupResult.item, reqLookupResult.lineAddr);
+        reqLookupResult.item = nullptr;
     }
 }
 
@@ -191,10 +353,10 @@ SnoopFilter::lookupSnoop(const Packet* cpkt)
     if (cpkt->isSecure()) {
         line_addr |= LineSecure;
     }
-    auto sf_it = cachedLocations.find(line_addr);
-    bool is_hit = (sf_it != cachedLocations.end());
+    SnoopItem *sf_it = findItem(line_addr);
+    bool is_hit = sf_it;
 
-    panic_if(!is_hit && (cachedLocations.size() >= maxEntryCount),
+    panic_if(!is_hit && !assoc && (cachedLocations.size() >= maxEntryCount),
              "snoop filter exceeded capacity of %d cache blocks\n",
              maxEntryCount);
 
@@ -204,7 +366,7 @@ SnoopFilter::lookupSnoop(const Packet* cpkt)
     if (!is_hit)
         return snoopDown(lookupLatency);
 
-    SnoopItem& sf_item = sf_it->second;
+    SnoopItem& sf_item = *sf_it;
 
     SnoopMask interested = (sf_item.holder | sf_item.requested);
 
@@ -234,7 +396,7 @@ SnoopFilter::lookupSnoop(const Packet* cpkt)
         sf_item.holder = 0;
         DPRINTF(SnoopFilter, "%s:   new SF value %x.%x\n",
                 __func__, sf_item.requested, sf_item.holder);
-        eraseIfNullEntry(sf_it);
+        eraseIfNullEntry(sf_it, line_addr);
     }
 
     return snoopSelected(maskToPortList(interested), lookupLatency);
@@ -264,7 +426,10 @@ SnoopFilter::updateSnoopResponse(const Packet* cpkt,
     }
     SnoopMask rsp_mask = portToMask(rsp_port);
     SnoopMask req_mask = portToMask(req_port);
-    SnoopItem& sf_item = cachedLocations[line_addr];
+    // The original request is in flight, so the line is tracked
+    SnoopItem *sf_it = findItem(line_addr);
+    panic_if(!sf_it, "SF has no entry for %#x\n", line_addr);
+    SnoopItem& sf_item = *sf_it;
 
     DPRINTF(SnoopFilter, "%s:   old SF value %x.%x\n",
             __func__,  sf_item.requested, sf_item.holder);
@@ -311,18 +476,17 @@ SnoopFilter::updateSnoopForward(const Packet* cpkt,
     if (cpkt->isSecure()) {
         line_addr |= LineSecure;
     }
-    auto sf_it = cachedLocations.find(line_addr);
-    bool is_hit = sf_it != cachedLocations.end();
+    SnoopItem *sf_it = findItem(line_addr);
 
     // Nothing to do if it is not a hit
-    if (!is_hit)
+    if (!sf_it)
         return;
 
     // If the snoop response has no sharers the line is passed in
     // Modified state, and we know that there are no other copies, or
     // they will all be invalidated imminently
     if (!cpkt->hasSharers()) {
-        SnoopItem& sf_item = sf_it->second;
+        SnoopItem& sf_item = *sf_it;
 
         DPRINTF(SnoopFilter, "%s:   old SF value %x.%x\n",
                 __func__, sf_item.requested, sf_item.holder);
@@ -330,7 +494,7 @@ SnoopFilter::updateSnoopForward(const Packet* cpkt,
         DPRINTF(SnoopFilter, "%s:   new SF value %x.%x\n",
                 __func__, sf_item.requested, sf_item.holder);
 
-        eraseIfNullEntry(sf_it);
+        eraseIfNullEntry(sf_it, line_addr);
     }
 }
 
@@ -353,12 +517,12 @@ SnoopFilter::updateResponse(const Packet* cpkt, const ResponsePort&
     if (cpkt->isSecure()) {
         line_addr |= LineSecure;
     }
-    auto sf_it = cachedLocations.find(line_addr);
-    if (sf_it == cachedLocations.end())
+    SnoopItem *sf_it = findItem(line_addr);
+    if (!sf_it)
         return;
 
     SnoopMask response_mask = portToMask(cpu_side_port);
-    SnoopItem& sf_item = sf_it->second;
+    SnoopItem& sf_item = *sf_it;
 
     DPRINTF(SnoopFilter, "%s:   old SF value %x.%x\n",
             __func__,  sf_item.requested, sf_item.holder);
@@ -377,7 +541,7 @@ SnoopFilter::updateResponse(const Packet* cpkt, const ResponsePort&
         if (cpkt->isInvalidate()) {
             sf_item.holder &= ~response_mask;
         }
-        eraseIfNullEntry(sf_it);
+        eraseIfNullEntry(sf_it, line_addr);
     } else {
         // Any other response implies that a cache above will have the
         // block.
@@ -405,7 +569,21 @@ SnoopFilter::SnoopFilterStats::SnoopFilterStats(statistics::Group *parent)
                "holder of the requested data."),
       ADD_STAT(hitMultiSnoops, statistics::units::Count::get(),
                "Number of snoops hitting in the snoop filter with multiple "
-               "(>1) holders of the requested data.")
+               "(>1) holders of the requested data."),
+      ADD_STAT(occupancy, statistics::units::Count::get(),
+               "Average number of lines tracked by the set-associative "
+               "snoop filter."),
+      ADD_STAT(capacityEvictions, statistics::units::Count::get(),
+               "Number of lines the snoop filter evicted to track others."),
+      ADD_STAT(backInvalidations, statistics::units::Count::get(),
+               "Number of invalidation snoops sent to the holders of "
+               "evicted lines."),
+      ADD_STAT(backInvalidationMisses, statistics::units::Count::get(),
+               "Number of requests to a line last evicted by the snoop "
+               "filter, i.e. the misses its invalidations caused."),
+      ADD_STAT(overflows, statistics::units::Count::get(),
+               "Number of lines tracked outside of the set-associative "
+               "array, as all requests to their set were in flight.")
 {}
 
 void
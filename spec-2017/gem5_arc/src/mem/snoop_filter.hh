@@ -46,7 +46,10 @@
 #include <bitset>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
+#include "mem/cache/replacement_policies/base.hh"
+#include "mem/cache/replacement_policies/replaceable_entry.hh"
 #include "mem/packet.hh"
 #include "mem/port.hh"
 #include "mem/qport.hh"
@@ -85,6 +88,14 @@ namespace gem5
  *     upper cache dropped a line, making the snoop filter pessimistic for now
  * (4) ordering: there is no single point of order in the system.  Instead,
  *     requesting MSHRs track order between local requests and remote snoops
+ *
+ * By default the tracking is unbounded. When given an associativity,
+ * the filter instead keeps its items in a set-associative array, and a
+ * line that loses its way to a new one is back-invalidated: the caches
+ * holding it are sent a cache clean and invalidate snoop, which writes
+ * dirty copies back below the filter. Lines with requests in flight are
+ * never evicted; if a whole set is in flight, the new line overflows
+ * into an unbounded map, which only ever holds a handful of lines.
  */
 class SnoopFilter : public SimObject
 {
@@ -95,13 +106,7 @@ class SnoopFilter : public SimObject
 
     typedef std::vector<QueuedResponsePort*> SnoopList;
 
-    SnoopFilter (const SnoopFilterParams &p) :
-        SimObject(p), reqLookupResult(cachedLocations.end()),
-        linesize(p.system->cacheLineSize()), lookupLatency(p.lookup_latency),
-        maxEntryCount(p.max_capacity / p.system->cacheLineSize()),
-        stats(this)
-    {
-    }
+    SnoopFilter(const SnoopFilterParams &p);
 
     /**
      * Init a new snoop filter and tell it about all the cpu_sideports
@@ -225,6 +230,9 @@ class SnoopFilter : public SimObject
      */
     typedef std::unordered_map<Addr, SnoopItem> SnoopFilterCache;
 
+    /** Tag of the ways that track no line */
+    static constexpr Addr InvalidTag = MaxAddr;
+
     /**
      * Simple factory methods for standard return values.
      */
@@ -258,14 +266,80 @@ class SnoopFilter : public SimObject
 
   private:
 
+    /**
+     * Find the item tracking a line.
+     *
+     * @param line_addr Line address, with the line status bits.
+     * @return The item, or nullptr if the line is not tracked.
+     */
+    SnoopItem *findItem(Addr line_addr);
+
+    /**
+     * Start tracking a line, possibly evicting another one to make room.
+     *
+     * @param line_addr Line address, with the line status bits.
+     * @return The new, empty item.
+     */
+    SnoopItem *allocateItem(Addr line_addr);
+
+    /** Let the replacement policy know of an access to an item */
+    void touchItem(SnoopItem *item);
+
     /**
      * Removes snoop filter items which have no requestors and no holders.
      */
-    void eraseIfNullEntry(SnoopFilterCache::iterator& sf_it);
+    void eraseIfNullEntry(SnoopItem *item, Addr line_addr);
+
+    /** Set of the set-associative array a line maps to */
+    unsigned extractSet(Addr line_addr) const;
+
+    /**
+     * Evict the line tracked by a way of the set-associative array, and
+     * invalidate it in the caches holding it.
+     */
+    void backInvalidate(unsigned way_idx);
 
-    /** Simple hash set of cached addresses. */
+    /** Is the item one of the ways of the set-associative array? */
+    bool
+    inArray(const SnoopItem *item) const
+    {
+        return item >= items.data() && item < items.data() + items.size();
+    }
+
+    /**
+     * Simple hash set of cached addresses. With a set-associative array,
+     * it only holds the lines that overflowed their set.
+     */
     SnoopFilterCache cachedLocations;
 
+    /** Ways of the set-associative array, 0 for unbounded tracking */
+    const unsigned assoc;
+    /** Number of sets of the set-associative array */
+    const unsigned numSets;
+    /** Number of bits of a line address below the set index */
+    const unsigned setShift;
+
+    /**
+     * The set-associative array, as flat vectors indexed by
+     * set * assoc + way. The tags are kept apart from the items so that
+     * a lookup only touches a few bytes per way.
+     */
+    std::vector<Addr> tags;
+    std::vector<SnoopItem> items;
+    std::vector<ReplaceableEntry> replEntries;
+    /** Line last evicted from each way, to spot the misses it causes */
+    std::vector<Addr> evictedTags;
+
+    replacement_policy::Base *const replacementPolicy;
+
+    /** Number of lines tracked */
+    unsigned numEntries;
+
+    /** Requestor id of the back-invalidation snoops */
+    const RequestorID requestorId;
+
+    System *const system;
+
     /**
      * A request lookup must be followed by a call to finishRequest to inform
      * the operation's success. If a retry is needed, however, all changes
@@ -274,8 +348,11 @@ class SnoopFilter : public SimObject
      */
     struct ReqLookupResult
     {
-        /** Iterator used to store the result from lookupRequest. */
-        SnoopFilterCache::iterator it;
+        /** Item found or allocated by lookupRequest, if any. */
+        SnoopItem *item;
+
+        /** Line address of the item, for sanity checking */
+        Addr lineAddr;
 
         /**
          * Variable to temporarily store value of snoopfilter entry
@@ -284,17 +361,10 @@ class SnoopFilter : public SimObject
          */
         SnoopItem retryItem;
 
-        /**
-         * The constructor must be informed of the internal cache's end
-         * iterator, so do not allow the compiler to implictly define it.
-         *
-         * @param end_it Iterator to the end of the internal cache.
-         */
-        ReqLookupResult(SnoopFilterCache::iterator end_it)
-            : it(end_it), retryItem{0, 0}
+        ReqLookupResult()
+            : item(nullptr), lineAddr(0), retryItem{0, 0}
         {
         }
-        ReqLookupResult() = delete;
     } reqLookupResult;
 
     /** List of all attached snooping CPU-side ports. */
@@ -329,6 +399,12 @@ class SnoopFilter : public SimObject
         statistics::Scalar totSnoops;
         statistics::Scalar hitSingleSnoops;
         statistics::Scalar hitMultiSnoops;
+
+        statistics::Average occupancy;
+        statistics::Scalar capacityEvictions;
+        statistics::Scalar backInvalidations;
+        statistics::Scalar backInvalidationMisses;
+        statistics::Scalar overflows;
     } stats;
 };
 
@@ -61,23 +61,30 @@ class L1Cache(MESI_Three_Level_L0Cache_Controller):
         cache_line_size,
         target_isa: ISA,
         clk_domain: ClockDomain,
+        l1i_replacement_policy=None,
+        l1d_replacement_policy=None,
     ):
         super().__init__()
 
+        if l1i_replacement_policy is None:
+            l1i_replacement_policy = LRURP()
+        if l1d_replacement_policy is None:
+            l1d_replacement_policy = LRURP()
+
         # This is the cache memory object that stores the cache data and tags
         self.Icache = RubyCache(
             size=l1i_size,
             assoc=l1i_assoc,
             start_index_bit=self.getBlockSizeBits(cache_line_size),
             is_icache=True,
-            replacement_policy=LRURP(),
+            replacement_policy=l1i_replacement_policy,
         )
         self.Dcache = RubyCache(
             size=l1d_size,
             assoc=l1d_assoc,
             start_index_bit=self.getBlockSizeBits(cache_line_size),
             is_icache=False,
-            replacement_policy=LRURP(),
+            replacement_policy=l1d_replacement_policy,
         )
         self.clk_domain = clk_domain
         self.prefetcher = RubyPrefetcher(block_size=cache_line_size)
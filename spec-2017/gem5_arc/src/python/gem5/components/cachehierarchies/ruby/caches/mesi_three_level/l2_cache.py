@@ -60,6 +60,7 @@ class L2Cache(MESI_Three_Level_L1Cache_Controller):
         cluster_id,
         target_isa: ISA,
         clk_domain: ClockDomain,
+        replacement_policy=None,
     ):
         super().__init__()
 
@@ -70,6 +71,8 @@ class L2Cache(MESI_Three_Level_L1Cache_Controller):
             start_index_bit=self.getBlockSizeBits(cache_line_size),
             is_icache=False,
         )
+        if replacement_policy is not None:
+            self.cache.replacement_policy = replacement_policy
         # l2_select_num_bits is ruby backend terminology.
         # In stdlib terms, it is number of bits for selecting L3 cache.
         self.l2_select_num_bits = int(math.log(num_l3Caches, 2))
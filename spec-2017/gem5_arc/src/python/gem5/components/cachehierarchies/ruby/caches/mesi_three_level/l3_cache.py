@@ -51,6 +51,7 @@ class L3Cache(MESI_Three_Level_L2Cache_Controller):
         num_l3Caches,
         cache_line_size,
         cluster_id,
+        replacement_policy=None,
     ):
         super().__init__()
 
@@ -60,6 +61,8 @@ class L3Cache(MESI_Three_Level_L2Cache_Controller):
             assoc=l3_assoc,
             start_index_bit=self.getIndexBit(num_l3Caches, cache_line_size),
         )
+        if replacement_policy is not None:
+            self.L2cache.replacement_policy = replacement_policy
 
         self.transitions_per_cycle = 4
         self.cluster_id = cluster_id
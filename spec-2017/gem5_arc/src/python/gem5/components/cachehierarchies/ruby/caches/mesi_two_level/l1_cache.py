@@ -28,6 +28,7 @@ import math
 
 from m5.objects import (
     ClockDomain,
+    NULL,
     MESI_Two_Level_L1Cache_Controller,
     MessageBuffer,
     RubyCache,
@@ -59,9 +60,19 @@ class L1Cache(MESI_Two_Level_L1Cache_Controller):
         cache_line_size,
         target_isa: ISA,
         clk_domain: ClockDomain,
+        prefetcher=None,
+        l1i_replacement_policy=None,
+        l1d_replacement_policy=None,
     ):
         """Creating L1 cache controller. Consist of both instruction
         and data cache.
+
+        :param prefetcher: An optional classic prefetcher (``BasePrefetcher``)
+                           instance trained on the L1 demand accesses.
+        :param l1i_replacement_policy: An optional replacement policy
+                                       instance for the instruction cache.
+        :param l1d_replacement_policy: An optional replacement policy
+                                       instance for the data cache.
         """
         super().__init__()
 
@@ -82,12 +93,21 @@ class L1Cache(MESI_Two_Level_L1Cache_Controller):
             start_index_bit=self._cache_line_size,
             is_icache=False,
         )
+        if l1i_replacement_policy is not None:
+            self.L1Icache.replacement_policy = l1i_replacement_policy
+        if l1d_replacement_policy is not None:
+            self.L1Dcache.replacement_policy = l1d_replacement_policy
         self.l2_select_num_bits = int(math.log(num_l2Caches, 2))
         self.clk_domain = clk_domain
         self.prefetcher = RubyPrefetcher(block_size=self._cache_line_size)
         self.send_evictions = core.requires_send_evicts()
         self.transitions_per_cycle = 4
         self.enable_prefetch = False
+        if prefetcher is not None:
+            self.classic_prefetcher = prefetcher
+            self.use_classic_prefetcher = True
+        else:
+            self.classic_prefetcher = NULL
 
     def connectQueues(self, network):
         self.mandatoryQueue = MessageBuffer()
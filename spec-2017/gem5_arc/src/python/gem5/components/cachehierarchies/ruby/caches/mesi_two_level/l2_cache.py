@@ -27,6 +27,7 @@
 import math
 
 from m5.objects import (
+    NULL,
     MESI_Two_Level_L2Cache_Controller,
     MessageBuffer,
     RubyCache,
@@ -43,7 +44,16 @@ class L2Cache(MESI_Two_Level_L2Cache_Controller):
         return cls._version - 1
 
     def __init__(
-        self, l2_size, l2_assoc, network, num_l2Caches, cache_line_size
+        self,
+        l2_size,
+        l2_assoc,
+        network,
+        num_l2Caches,
+        cache_line_size,
+        compressor=None,
+        max_compression_ratio=2,
+        prefetcher=None,
+        replacement_policy=None,
     ):
         super().__init__()
 
@@ -57,6 +67,17 @@ class L2Cache(MESI_Two_Level_L2Cache_Controller):
             assoc=l2_assoc,
             start_index_bit=self.getIndexBit(num_l2Caches),
         )
+        if compressor is not None:
+            self.L2cache.compressor = compressor()
+            self.L2cache.max_compression_ratio = max_compression_ratio
+        if replacement_policy is not None:
+            self.L2cache.replacement_policy = replacement_policy
+
+        if prefetcher is not None:
+            self.prefetcher = prefetcher
+            self.use_prefetcher = True
+        else:
+            self.prefetcher = NULL
 
         self.transitions_per_cycle = 4
 
@@ -78,3 +99,4 @@ class L2Cache(MESI_Two_Level_L2Cache_Controller):
         self.L1RequestToL2Cache.in_port = network.out_port
         self.responseToL2Cache = MessageBuffer()
         self.responseToL2Cache.in_port = network.out_port
+        self.prefetchQueue = MessageBuffer()
@@ -54,6 +54,7 @@ class L1Cache(MI_example_L1Cache_Controller):
         cache_line_size,
         target_isa: ISA,
         clk_domain: ClockDomain,
+        replacement_policy=None,
     ):
         super().__init__()
         self.version = self.versionCount()
@@ -63,6 +64,8 @@ class L1Cache(MI_example_L1Cache_Controller):
         self.cacheMemory = RubyCache(
             size=size, assoc=assoc, start_index_bit=self._cache_line_size
         )
+        if replacement_policy is not None:
+            self.cacheMemory.replacement_policy = replacement_policy
 
         self.clk_domain = clk_domain
         self.send_evictions = core.requires_send_evicts()
@@ -25,7 +25,13 @@
 # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 
+from typing import (
+    Optional,
+    Type,
+)
+
 from m5.objects import (
+    BaseReplacementPolicy,
     DMASequencer,
     RubyPortProxy,
     RubySequencer,
@@ -59,6 +65,11 @@ class MESIThreeLevelCacheHierarchy(
     """A three-level private-L1-private-L2-shared-L3 MESI hierarchy.
 
     The on-chip network is a point-to-point all-to-all simple network.
+
+    The ``*_replacement_policy`` parameters take a replacement policy class
+    (e.g., ``LRURP``) instantiated for every cache of that level. The L1
+    caches default to ``LRURP`` and the others to the ``RubyCache``
+    default.
     """
 
     def __init__(
@@ -72,6 +83,10 @@ class MESIThreeLevelCacheHierarchy(
         l3_size: str,
         l3_assoc: str,
         num_l3_banks: int,
+        l1i_replacement_policy: Optional[Type[BaseReplacementPolicy]] = None,
+        l1d_replacement_policy: Optional[Type[BaseReplacementPolicy]] = None,
+        l2_replacement_policy: Optional[Type[BaseReplacementPolicy]] = None,
+        l3_replacement_policy: Optional[Type[BaseReplacementPolicy]] = None,
     ):
         AbstractRubyCacheHierarchy.__init__(self=self)
         AbstractThreeLevelCacheHierarchy.__init__(
@@ -87,6 +102,10 @@ class MESIThreeLevelCacheHierarchy(
         )
 
         self._num_l3_banks = num_l3_banks
+        self._l1i_replacement_policy = l1i_replacement_policy
+        self._l1d_replacement_policy = l1d_replacement_policy
+        self._l2_replacement_policy = l2_replacement_policy
+        self._l3_replacement_policy = l3_replacement_policy
 
     @overrides(AbstractCacheHierarchy)
     def get_coherence_protocol(self):
@@ -119,6 +138,16 @@ class MESIThreeLevelCacheHierarchy(
                 cache_line_size=cache_line_size,
                 target_isa=board.processor.get_isa(),
                 clk_domain=board.get_clock_domain(),
+                l1i_replacement_policy=(
+                    self._l1i_replacement_policy()
+                    if self._l1i_replacement_policy is not None
+                    else None
+                ),
+                l1d_replacement_policy=(
+                    self._l1d_replacement_policy()
+                    if self._l1d_replacement_policy is not None
+                    else None
+                ),
             )
 
             l1_cache.sequencer = RubySequencer(
@@ -163,6 +192,11 @@ class MESIThreeLevelCacheHierarchy(
                 cluster_id=0,
                 target_isa=board.processor.get_isa(),
                 clk_domain=board.get_clock_domain(),
+                replacement_policy=(
+                    self._l2_replacement_policy()
+                    if self._l2_replacement_policy is not None
+                    else None
+                ),
             )
 
             l2_cache.ruby_system = self.ruby_system
@@ -181,6 +215,11 @@ class MESIThreeLevelCacheHierarchy(
                 num_l3Caches=self._num_l3_banks,
                 cache_line_size=cache_line_size,
                 cluster_id=0,  # cluster_id is ignored in point-to-point topology
+                replacement_policy=(
+                    self._l3_replacement_policy()
+                    if self._l3_replacement_policy is not None
+                    else None
+                ),
             )
             l3_cache.ruby_system = self.ruby_system
             self._l3_controllers.append(l3_cache)
@@ -25,7 +25,15 @@
 # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 
+from typing import (
+    Optional,
+    Type,
+)
+
 from m5.objects import (
+    BaseCacheCompressor,
+    BasePrefetcher,
+    BaseReplacementPolicy,
     DMASequencer,
     RubyPortProxy,
     RubySequencer,
@@ -59,6 +67,19 @@ class MESITwoLevelCacheHierarchy(
     number of L2 banks in this protocol.
 
     The on-chip network is a point-to-point all-to-all simple network.
+
+    Passing an ``l2_compressor`` class turns every L2 bank into a compressed
+    cache: each tag covers ``l2_max_compression_ratio`` consecutive blocks
+    and the data array is allocated by compressed size.
+
+    ``l1d_prefetcher`` and ``l2_prefetcher`` take a classic prefetcher class
+    (e.g., ``StridePrefetcher``); one instance is created per L1 controller
+    or L2 bank. The L2 prefetcher is trained on the L1 demand requests.
+
+    ``l1i_replacement_policy``, ``l1d_replacement_policy`` and
+    ``l2_replacement_policy`` likewise take a replacement policy class
+    (e.g., ``LRURP``) instantiated for every cache of that level. When not
+    given, the caches use the ``RubyCache`` default.
     """
 
     def __init__(
@@ -70,6 +91,13 @@ class MESITwoLevelCacheHierarchy(
         l2_size: str,
         l2_assoc: str,
         num_l2_banks: int,
+        l2_compressor: Optional[Type[BaseCacheCompressor]] = None,
+        l2_max_compression_ratio: int = 2,
+        l1d_prefetcher: Optional[Type[BasePrefetcher]] = None,
+        l2_prefetcher: Optional[Type[BasePrefetcher]] = None,
+        l1i_replacement_policy: Optional[Type[BaseReplacementPolicy]] = None,
+        l1d_replacement_policy: Optional[Type[BaseReplacementPolicy]] = None,
+        l2_replacement_policy: Optional[Type[BaseReplacementPolicy]] = None,
     ):
         AbstractRubyCacheHierarchy.__init__(self=self)
         AbstractTwoLevelCacheHierarchy.__init__(
@@ -83,6 +111,13 @@ class MESITwoLevelCacheHierarchy(
         )
 
         self._num_l2_banks = num_l2_banks
+        self._l2_compressor = l2_compressor
+        self._l2_max_compression_ratio = l2_max_compression_ratio
+        self._l1d_prefetcher = l1d_prefetcher
+        self._l2_prefetcher = l2_prefetcher
+        self._l1i_replacement_policy = l1i_replacement_policy
+        self._l1d_replacement_policy = l1d_replacement_policy
+        self._l2_replacement_policy = l2_replacement_policy
 
     @overrides(AbstractCacheHierarchy)
     def get_coherence_protocol(self):
@@ -113,6 +148,21 @@ class MESITwoLevelCacheHierarchy(
                 cache_line_size,
                 board.processor.get_isa(),
                 board.get_clock_domain(),
+                prefetcher=(
+                    self._l1d_prefetcher()
+                    if self._l1d_prefetcher is not None
+                    else None
+                ),
+                l1i_replacement_policy=(
+                    self._l1i_replacement_policy()
+                    if self._l1i_replacement_policy is not None
+                    else None
+                ),
+                l1d_replacement_policy=(
+                    self._l1d_replacement_policy()
+                    if self._l1d_replacement_policy is not None
+                    else None
+                ),
             )
 
             cache.sequencer = RubySequencer(
@@ -151,6 +201,18 @@ class MESITwoLevelCacheHierarchy(
                 self.ruby_system.network,
                 self._num_l2_banks,
                 cache_line_size,
+                compressor=self._l2_compressor,
+                max_compression_ratio=self._l2_max_compression_ratio,
+                prefetcher=(
+                    self._l2_prefetcher()
+                    if self._l2_prefetcher is not None
+                    else None
+                ),
+                replacement_policy=(
+                    self._l2_replacement_policy()
+                    if self._l2_replacement_policy is not None
+                    else None
+                ),
             )
             for _ in range(self._num_l2_banks)
         ]
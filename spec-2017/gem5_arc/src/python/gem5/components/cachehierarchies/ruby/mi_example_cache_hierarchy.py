@@ -24,7 +24,13 @@
 # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+from typing import (
+    Optional,
+    Type,
+)
+
 from m5.objects import (
+    BaseReplacementPolicy,
     DMASequencer,
     RubyPortProxy,
     RubySequencer,
@@ -54,15 +60,24 @@ class MIExampleCacheHierarchy(AbstractRubyCacheHierarchy):
     simple point-to-point topology.
     """
 
-    def __init__(self, size: str, assoc: str):
+    def __init__(
+        self,
+        size: str,
+        assoc: str,
+        replacement_policy: Optional[Type[BaseReplacementPolicy]] = None,
+    ):
         """
         :param size: The size of each cache in the heirarchy.
         :param assoc: The associativity of each cache.
+        :param replacement_policy: The replacement policy class of each
+                                   cache. Uses the ``RubyCache`` default if
+                                   not given.
         """
         super().__init__()
 
         self._size = size
         self._assoc = assoc
+        self._replacement_policy = replacement_policy
 
     @overrides(AbstractCacheHierarchy)
     def get_coherence_protocol(self):
@@ -95,6 +110,11 @@ class MIExampleCacheHierarchy(AbstractRubyCacheHierarchy):
                 cache_line_size=board.get_cache_line_size(),
                 target_isa=board.get_processor().get_isa(),
                 clk_domain=board.get_clock_domain(),
+                replacement_policy=(
+                    self._replacement_policy()
+                    if self._replacement_policy is not None
+                    else None
+                ),
             )
 
             cache.sequencer = RubySequencer(
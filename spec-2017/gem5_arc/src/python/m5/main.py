@@ -301,6 +301,22 @@ def parse_options():
         help="Sets the output file for debug. Append '.gz' to the name for it"
         " to be compressed automatically [Default: %default]",
     )
+    option(
+        "--debug-ring",
+        metavar="N",
+        type="int",
+        default=0,
+        help="Only keep the last N debug messages, unformatted, and write "
+        "them to the debug file at exit",
+    )
+    option(
+        "--debug-binary",
+        action="store_true",
+        default=False,
+        help="Write the debug file, which has to be set with --debug-file, "
+        "in binary form, which is much faster. Decode it with "
+        "util/decode_debug_trace.py",
+    )
     option(
         "--debug-activate",
         metavar="EXPR[,EXPR]",
@@ -616,7 +632,18 @@ def main():
         e = event.create(trace.disable, event.Event.Debug_Enable_Pri)
         event.mainq.schedule(e, options.debug_end)
 
-    trace.output(options.debug_file)
+    if options.debug_ring and options.debug_binary:
+        print(
+            "--debug-ring and --debug-binary can't be used together",
+            file=sys.stderr,
+        )
+        sys.exit(1)
+    if options.debug_ring:
+        trace.ring(options.debug_file, options.debug_ring)
+    elif options.debug_binary:
+        trace.binary(options.debug_file)
+    else:
+        trace.output(options.debug_file)
 
     for activate in options.debug_activate:
         _check_tracing()
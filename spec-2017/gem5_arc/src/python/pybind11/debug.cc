@@ -43,12 +43,15 @@
 #include "pybind11/stl.h"
 
 #include <map>
+#include <string>
 #include <vector>
 
 #include "base/compiler.hh"
 #include "base/debug.hh"
+#include "base/logging.hh"
 #include "base/output.hh"
 #include "base/trace.hh"
+#include "sim/core.hh"
 #include "sim/debug.hh"
 
 namespace py = pybind11;
@@ -67,6 +70,40 @@ output(const char *filename)
     trace::setDebugLogger(new trace::OstreamLogger(*file_stream->stream()));
 }
 
+static void
+ring(const char *filename, size_t capacity)
+{
+    OutputStream *file_stream = simout.find(filename);
+
+    if (!file_stream)
+        file_stream = simout.create(filename);
+
+    auto *logger = new trace::RingLogger(*file_stream->stream(), capacity);
+    trace::setDebugLogger(logger);
+    registerExitCallback([logger]() { logger->flush(); });
+}
+
+static void
+binary(const char *filename)
+{
+    // The records are written by a thread of their own, which mustn't share
+    // the terminal with the rest of gem5.
+    const std::string name = filename;
+    fatal_if(name == "cout" || name == "stdout" || name == "cerr" ||
+             name == "stderr",
+             "A binary debug trace can't be written to %s, pick a file with "
+             "--debug-file.", name);
+
+    OutputStream *file_stream = simout.find(filename);
+
+    if (!file_stream)
+        file_stream = simout.create(filename, true);
+
+    auto *logger = new trace::BinaryLogger(*file_stream->stream());
+    trace::setDebugLogger(logger);
+    registerExitCallback([logger]() { logger->close(); });
+}
+
 static void
 activate(const char *expr)
 {
@@ -118,9 +155,13 @@ pybind_init_debug(py::module_ &m_native)
             })
         ;
 
-    py::class_<debug::SimpleFlag>(m_debug, "SimpleFlag", c_flag)
+    py::class_<debug::SimpleFlag> c_simple_flag(m_debug, "SimpleFlag",
+                                                c_flag);
+    c_simple_flag
         .def_property_readonly("isFormat", &debug::SimpleFlag::isFormat)
         ;
+    py::class_<debug::CompiledOutFlag>(m_debug, "CompiledOutFlag",
+                                       c_simple_flag);
     py::class_<debug::CompoundFlag>(m_debug, "CompoundFlag", c_flag)
         .def("kids", &debug::CompoundFlag::kids)
         ;
@@ -129,6 +170,8 @@ pybind_init_debug(py::module_ &m_native)
     py::module_ m_trace = m_native.def_submodule("trace");
     m_trace
         .def("output", &output)
+        .def("ring", &ring)
+        .def("binary", &binary)
         .def("activate", &activate)
         .def("ignore", &ignore)
         .def("enable", &trace::enable)
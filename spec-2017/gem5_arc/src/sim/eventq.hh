@@ -850,6 +850,19 @@ class EventQueue
     Tick getCurTick() const { return _curTick; }
     Event *getHead() const { return head; }
 
+    /**
+     * Call f on the events that share the bin of the head, in the order
+     * they will be serviced, until f returns false.
+     */
+    template <typename F>
+    void
+    forEachInHeadBin(F f) const
+    {
+        for (Event *event = head; event && f(event);
+             event = event->nextInBin) {
+        }
+    }
+
     Event *serviceOne();
 
     /**
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2025 Boston University
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/*
+ * Measure the throughput of the compression kernels over the 64-byte
+ * blocks of a memory dump, with every instruction set the host has, and
+ * check that they all agree on every block.
+ *
+ * Any raw memory image works as a dump, e.g. the uncompressed physical
+ * memory file of a checkpoint. Without one, 4 MiB of synthetic blocks
+ * with a mix of zeros, small values and repeated values are used.
+ *
+ *   make -C util/compression_kernels_bench
+ *   util/compression_kernels_bench/kernels_bench [dump] [repeat]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "mem/cache/compressors/kernels.hh"
+
+using namespace gem5;
+using namespace gem5::compression;
+
+namespace
+{
+
+/** Words with a mix of the properties the compressors look for. */
+std::vector<uint64_t>
+syntheticData(std::size_t bytes)
+{
+    std::mt19937_64 rng(513);
+    std::vector<uint64_t> data(bytes / sizeof(uint64_t));
+    for (std::size_t blk = 0; blk < data.size(); blk += 8) {
+        const uint64_t base = rng();
+        for (std::size_t i = blk; i < blk + 8; i++) {
+            switch (rng() % 6) {
+              case 0: data[i] = 0; break;
+              case 1: data[i] = rng() % 256; break;
+              case 2: data[i] = -uint64_t(rng() % 256); break;
+              case 3: data[i] = base + (rng() % 1024) - 512; break;
+              case 4: data[i] = 0x0101010101010101ULL * (rng() % 256); break;
+              default: data[i] = rng(); break;
+            }
+        }
+    }
+    return data;
+}
+
+std::vector<uint64_t>
+readDump(const char *path)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        std::cerr << "cannot open " << path << "\n";
+        std::exit(1);
+    }
+    std::vector<uint64_t> data(file.tellg() / sizeof(uint64_t));
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(data.data()),
+        data.size() * sizeof(uint64_t));
+    return data;
+}
+
+/** Run the FPC, CPack and BDI kernels over every block of the data. */
+uint64_t
+run(const std::vector<uint64_t> &data, kernels::Isa isa)
+{
+    uint64_t checksum = 0;
+    for (std::size_t blk = 0; blk < data.size(); blk += 8) {
+        const uint64_t *block = &data[blk];
+
+        uint32_t words[16];
+        for (int i = 0; i < 16; i++)
+            words[i] = block[i / 2] >> (32 * (i % 2));
+
+        // FPC
+        uint8_t classes[16];
+        kernels::classifyFPC(words, 16, classes, isa);
+        for (int i = 0; i < 16; i++)
+            checksum += classes[i];
+
+        // CPack, assuming all non-zero words are allocated
+        for (int i = 0; i < 16; i++)
+            checksum += kernels::matchingBytes(words[i], words, i, isa);
+
+        // BDI
+        checksum += kernels::selectBases<uint64_t>(block, 8, 0x7F, isa);
+        checksum += kernels::selectBases<uint32_t>(words, 16, 0x7FFF, isa);
+    }
+    return checksum;
+}
+
+} // anonymous namespace
+
+int
+main(int argc, char **argv)
+{
+    std::vector<uint64_t> data = argc > 1 ? readDump(argv[1]) :
+                                            syntheticData(4 << 20);
+    const int repeat = argc > 2 ? std::atoi(argv[2]) : 5;
+    if (repeat < 1) {
+        std::cerr << "repeat must be at least 1\n";
+        return 2;
+    }
+    data.resize(data.size() - data.size() % 8);
+    if (data.empty()) {
+        std::cerr << "the dump is smaller than a block\n";
+        return 2;
+    }
+    const double gigabytes = data.size() * sizeof(uint64_t) / 1e9;
+    std::printf("%zu blocks\n", data.size() / 8);
+
+    bool agree = true;
+    uint64_t scalar_checksum = 0;
+    for (auto isa : {kernels::Isa::Scalar, kernels::Isa::AVX2}) {
+        if (!kernels::isSupported(isa))
+            continue;
+
+        double best = 0;
+        uint64_t checksum = 0;
+        for (int i = 0; i < repeat; i++) {
+            auto start = std::chrono::steady_clock::now();
+            checksum = run(data, isa);
+            std::chrono::duration<double> t =
+                std::chrono::steady_clock::now() - start;
+            if (i == 0 || t.count() < best)
+                best = t.count();
+        }
+
+        std::printf("%-7s %.2f GB/s\n",
+                    isa == kernels::Isa::AVX2 ? "avx2:" : "scalar:",
+                    gigabytes / best);
+        if (isa == kernels::Isa::Scalar)
+            scalar_checksum = checksum;
+        else if (checksum != scalar_checksum)
+            agree = false;
+    }
+
+    if (!agree) {
+        std::printf("error: the instruction sets disagree on some blocks\n");
+        return 1;
+    }
+    return 0;
+}
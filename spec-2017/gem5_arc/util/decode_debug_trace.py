@@ -0,0 +1,465 @@
+#! /usr/bin/env python3
+# Copyright (c) 2025 Boston University
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Decode a binary debug trace written with --debug-binary back into the
+# text gem5 would have printed, e.g.
+#
+#   build/X86/gem5.opt --debug-flags=RubyCache,ProtocolTrace \
+#       --debug-binary --debug-file=trace.bin configs/...
+#   util/decode_debug_trace.py m5out/trace.bin > trace.out
+#
+# Messages are formatted the way base/cprintf.cc formats them, which this
+# script follows closely, including its quirks. The trace is in the byte
+# order of the host which wrote it, which is assumed to be little endian.
+
+import argparse
+import gzip
+import struct
+import sys
+
+MAGIC = b"gem5dbg\0"
+VERSION = 1
+MAX_TICK = (1 << 64) - 1
+
+# Entry format flags
+TICKS_OFF = 0x1
+SHOW_FLAG = 0x2
+
+# Argument kinds, as in trace::Record::Kind
+(
+    INT,
+    LONG,
+    UINT,
+    ULONG,
+    FLOAT,
+    CHAR,
+    POINTER,
+    STRING,
+    OBJECT,
+    ELIDED,
+) = range(10)
+
+
+class Format:
+    def __init__(self):
+        self.alternate = False
+        self.left = False
+        self.sign = False
+        self.zero = False
+        self.upper = False
+        self.base = 10
+        self.format = None  # "s", "c", "i" or "f"
+        self.float_format = "best"
+        self.precision = -1
+        self.width = 0
+        self.get_precision = False
+        self.get_width = False
+
+
+def parse_flag(fmt, pos):
+    """Parse the conversion at fmt[pos] == "%" like Print::processFlag."""
+    f = Format()
+    done = False
+    end_number = False
+    have_precision = False
+    number = 0
+
+    while not done:
+        pos += 1
+        c = fmt[pos] if pos < len(fmt) else ""
+        if c.isdigit():
+            if end_number:
+                continue
+        elif number > 0:
+            end_number = True
+
+        if c == "s":
+            f.format = "s"
+            done = True
+        elif c == "c":
+            f.format = "c"
+            done = True
+        elif c == "l":
+            continue
+        elif c == "p":
+            f.format = "i"
+            f.base = 16
+            f.alternate = True
+            done = True
+        elif c in ("x", "X"):
+            f.upper = c == "X"
+            f.base = 16
+            f.format = "i"
+            done = True
+        elif c == "o":
+            f.base = 8
+            f.format = "i"
+            done = True
+        elif c in ("d", "i", "u"):
+            f.format = "i"
+            done = True
+        elif c in ("g", "G", "e", "E", "f"):
+            f.upper = c in ("G", "E")
+            f.format = "f"
+            f.float_format = {"g": "best", "e": "sci", "f": "fixed"}[
+                c.lower()
+            ]
+            done = True
+        elif c == "#":
+            f.alternate = True
+        elif c == "-":
+            f.left = True
+        elif c == "+":
+            f.sign = True
+        elif c == " ":
+            pass
+        elif c == ".":
+            f.width = number
+            f.precision = 0
+            have_precision = True
+            number = 0
+            end_number = False
+        elif c == "0" and number == 0:
+            f.zero = True
+        elif c.isdigit():
+            number = number * 10 + int(c)
+        elif c == "*":
+            if have_precision:
+                f.get_precision = True
+            else:
+                f.get_width = True
+        else:
+            done = True
+
+        if end_number:
+            if have_precision:
+                f.precision = number
+            else:
+                f.width = number
+            end_number = False
+            number = 0
+
+        if done:
+            if f.format == "i" and have_precision:
+                f.width = f.precision
+                f.zero = True
+            elif f.format == "f" and not have_precision and f.zero:
+                f.precision = f.width
+
+    return f, min(pos + 1, len(fmt))
+
+
+def pad(text, width, fill, left):
+    if width <= len(text):
+        return text
+    padding = fill * (width - len(text))
+    return text + padding if left else padding + text
+
+
+def float_text(value, precision, mode="g"):
+    return f"%.{precision}{mode}" % value
+
+
+def pointer_text(value):
+    return f"0x{value:x}" if value else "0"
+
+
+def plain_text(kind, value, precision):
+    """The argument as operator<< prints it on a stream with no flags."""
+    if kind == CHAR:
+        return chr(value & 0xFF)
+    if kind == FLOAT:
+        return float_text(value, precision)
+    if kind == POINTER:
+        return pointer_text(value)
+    if kind in (STRING, OBJECT):
+        return value
+    if kind == ELIDED:
+        return "<?>"
+    return str(value)
+
+
+def format_integer(f, kind, value, precision):
+    out = ""
+    width = f.width
+    if f.alternate and f.zero:
+        if f.base == 16:
+            out = "0x"
+            width -= 2
+        elif f.base == 8:
+            out = "0"
+            width -= 1
+
+    if kind == CHAR:
+        kind = INT
+    if kind in (INT, LONG, UINT, ULONG):
+        if f.base == 10:
+            text = str(value)
+            if f.sign and kind in (INT, LONG) and value >= 0:
+                text = "+" + text
+        else:
+            if value < 0:
+                value += 1 << (32 if kind == INT else 64)
+            text = format(value, "x" if f.base == 16 else "o")
+            if f.alternate and not f.zero and value:
+                text = ("0x" if f.base == 16 else "0") + text
+            if f.upper:
+                text = text.upper()
+    elif kind == FLOAT:
+        text = float_text(value, precision)
+        if f.sign and not text.startswith("-"):
+            text = "+" + text
+        if f.upper:
+            text = text.upper()
+    else:
+        text = plain_text(kind, value, precision)
+
+    fill = "0" if f.zero else " "
+    return out + pad(text, width, fill, f.left and not f.zero)
+
+
+def format_float(f, kind, value, precision):
+    """Returns the text and the stream precision, which carries over."""
+    if kind != FLOAT:
+        return "<bad arg type for float format>", precision
+
+    mode = "g"
+    if f.float_format == "sci":
+        if f.precision == 0:
+            precision = 1
+        elif f.precision != -1:
+            precision, mode = f.precision, "e"
+    elif f.float_format == "fixed":
+        if f.precision != -1:
+            precision, mode = f.precision, "f"
+    elif f.precision != -1:
+        precision = f.precision
+
+    text = float_text(value, precision, mode)
+    if f.upper and f.float_format == "sci":
+        text = text.upper()
+    return pad(text, f.width, "0" if f.zero else " ", False), precision
+
+
+class Printer:
+    """Follows cp::Print, one instance per message."""
+
+    def __init__(self, fmt):
+        self.fmt = fmt
+        self.pos = 0
+        self.out = []
+        self.cont = False
+        self.f = Format()
+        # Like the stream's, only floating point formats change this
+        self.precision = 6
+
+    def process(self):
+        fmt = self.fmt
+        self.f = Format()
+        while self.pos < len(fmt):
+            c = fmt[self.pos]
+            if c == "%":
+                if fmt[self.pos + 1 : self.pos + 2] != "%":
+                    self.f, self.pos = parse_flag(fmt, self.pos)
+                    return
+                self.out.append("%")
+                self.pos += 2
+            elif c == "\r":
+                self.pos += 1
+                if fmt[self.pos : self.pos + 1] != "\n":
+                    self.out.append("\n")
+            elif c == "\n":
+                self.out.append("\n")
+                self.pos += 1
+            else:
+                end = self.pos
+                while end < len(fmt) and fmt[end] not in "%\n\r":
+                    end += 1
+                self.out.append(fmt[self.pos : end])
+                self.pos = end
+
+    def add_arg(self, kind, value):
+        if not self.cont:
+            self.process()
+
+        f = self.f
+        if f.get_width or f.get_precision:
+            number = value if kind == INT else 0
+            if f.get_width:
+                f.get_width = False
+                f.width = number
+            else:
+                f.get_precision = False
+                f.precision = number
+            self.cont = True
+            return
+
+        if f.format == "c":
+            if kind in (INT, LONG, UINT, ULONG, CHAR):
+                text = chr(value & 0xFF)
+            else:
+                text = "<bad arg type for char format>"
+        elif f.format == "i":
+            text = format_integer(f, kind, value, self.precision)
+        elif f.format == "f":
+            text, self.precision = format_float(
+                f, kind, value, self.precision
+            )
+        elif f.format == "s":
+            text = pad(
+                plain_text(kind, value, self.precision), f.width, " ", f.left
+            )
+        else:
+            text = "<bad format>"
+        self.out.append(text)
+
+    def end_args(self):
+        fmt = self.fmt
+        while self.pos < len(fmt):
+            c = fmt[self.pos]
+            if c == "%":
+                if fmt[self.pos + 1 : self.pos + 2] != "%":
+                    self.out.append("<extra arg>")
+                self.out.append("%")
+                self.pos += 2
+            elif c == "\r":
+                self.pos += 1
+                if fmt[self.pos : self.pos + 1] != "\n":
+                    self.out.append("\n")
+            elif c == "\n":
+                self.out.append("\n")
+                self.pos += 1
+            else:
+                end = self.pos
+                while end < len(fmt) and fmt[end] not in "%\n\r":
+                    end += 1
+                self.out.append(fmt[self.pos : end])
+                self.pos = end
+        return "".join(self.out)
+
+
+class Reader:
+    def __init__(self, f):
+        self.f = f
+
+    def unpack(self, fmt):
+        size = struct.calcsize(fmt)
+        data = self.f.read(size)
+        if len(data) != size:
+            raise EOFError
+        return struct.unpack(fmt, data)
+
+    def string(self):
+        (length,) = self.unpack("<I")
+        data = self.f.read(length)
+        if len(data) != length:
+            raise EOFError
+        return data.decode("latin-1")
+
+
+def prefix(flags, when, name, flag):
+    out = ""
+    if not flags & TICKS_OFF and when != MAX_TICK:
+        out += "%7d: " % when
+    if flags & SHOW_FLAG and flag:
+        out += flag + ": "
+    if name:
+        out += name + ": "
+    return out
+
+
+def decode(reader, out):
+    magic, version = reader.unpack("<8sI")
+    if magic != MAGIC:
+        sys.exit("Not a gem5 binary debug trace")
+    if version != VERSION:
+        sys.exit(f"Unsupported trace version {version}")
+
+    strings = {}
+    while True:
+        tag = reader.f.read(1)
+        if not tag:
+            break
+        try:
+            if tag == b"S":
+                (string_id,) = reader.unpack("<I")
+                strings[string_id] = reader.string()
+            elif tag == b"R":
+                flags, when, fmt, name, flag, num_args = reader.unpack(
+                    "<BQIIIB"
+                )
+                printer = Printer(strings[fmt])
+                for _ in range(num_args):
+                    (kind,) = reader.unpack("<B")
+                    if kind in (INT, LONG, CHAR):
+                        (value,) = reader.unpack("<q")
+                    elif kind in (UINT, ULONG, POINTER):
+                        (value,) = reader.unpack("<Q")
+                    elif kind == FLOAT:
+                        (value,) = reader.unpack("<d")
+                    elif kind in (STRING, OBJECT):
+                        value = reader.string()
+                    else:
+                        value = None
+                    printer.add_arg(kind, value)
+                out.write(
+                    prefix(flags, when, strings[name], strings[flag])
+                    + printer.end_args()
+                )
+            elif tag == b"M":
+                flags, when, name, flag = reader.unpack("<BQII")
+                message = reader.string()
+                out.write(
+                    prefix(flags, when, strings[name], strings[flag])
+                    + message
+                )
+            else:
+                sys.exit(f"Corrupt trace, unknown entry {tag!r}")
+        except EOFError:
+            print("Trace ends in the middle of an entry", file=sys.stderr)
+            break
+
+
+parser = argparse.ArgumentParser()
+parser.add_argument("trace", help="binary trace, optionally gzipped")
+parser.add_argument("-o", "--output", help="text output [default: stdout]")
+args = parser.parse_args()
+
+opener = gzip.open if args.trace.endswith(".gz") else open
+with opener(args.trace, "rb") as f:
+    if args.output:
+        out = open(args.output, "w", encoding="latin-1", newline="")
+    else:
+        out = open(
+            sys.stdout.fileno(),
+            "w",
+            encoding="latin-1",
+            newline="",
+            closefd=False,
+        )
+    with out:
+        decode(Reader(f), out)
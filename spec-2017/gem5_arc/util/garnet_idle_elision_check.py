@@ -0,0 +1,117 @@
+#! /usr/bin/env python3
+# Copyright (c) 2025 Boston University
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Check that Garnet's idle-cycle elision is cycle-accurate and measure
+# what it saves.
+#
+# Runs configs/example/garnet_synth_traffic.py on a mesh at several
+# injection rates, with and without --garnet-elide-idle-cycles. All
+# simulated statistics must match exactly; only the host statistics may
+# differ. Run it from the gem5 root with a binary that has the
+# Garnet_standalone protocol, e.g.
+#
+#   util/garnet_idle_elision_check.py build/NULL/gem5.opt --rows 8
+
+import argparse
+import os
+import subprocess
+import sys
+import tempfile
+
+parser = argparse.ArgumentParser()
+parser.add_argument("binary")
+parser.add_argument("--rows", type=int, default=8, help="mesh rows")
+parser.add_argument("--sim-cycles", type=int, default=100000)
+parser.add_argument(
+    "--rates",
+    type=float,
+    nargs="+",
+    default=[0.005, 0.02, 0.1, 0.3],
+    help="injection rates to check",
+)
+parser.add_argument("--synthetic", default="uniform_random")
+parser.add_argument("--routing-algorithm", type=int, default=0)
+
+args = parser.parse_args()
+nodes = args.rows * args.rows
+
+
+def is_host_stat(name):
+    # Pool misses count host allocations, not simulated behaviour
+    return name.startswith("host") or name.endswith("_pool_misses")
+
+
+def read_stats(path):
+    stats = {}
+    with open(path) as f:
+        for line in f:
+            fields = line.split()
+            if len(fields) >= 2 and not line.startswith("-"):
+                stats[fields[0]] = fields[1]
+    return stats
+
+
+def run(rate, elide):
+    outdir = tempfile.mkdtemp(prefix="garnet-elision-")
+    cmd = [
+        args.binary,
+        "-d",
+        outdir,
+        "configs/example/garnet_synth_traffic.py",
+        "--network=garnet",
+        "--topology=Mesh_XY",
+        f"--num-cpus={nodes}",
+        f"--num-dirs={nodes}",
+        f"--mesh-rows={args.rows}",
+        f"--synthetic={args.synthetic}",
+        f"--injectionrate={rate}",
+        f"--sim-cycles={args.sim_cycles}",
+        f"--routing-algorithm={args.routing_algorithm}",
+    ]
+    if elide:
+        cmd.append("--garnet-elide-idle-cycles")
+    subprocess.run(cmd, check=True, stdout=subprocess.DEVNULL)
+    return read_stats(os.path.join(outdir, "stats.txt"))
+
+
+failed = False
+for rate in args.rates:
+    base = run(rate, False)
+    elided = run(rate, True)
+    diffs = [
+        name
+        for name in sorted(set(base) | set(elided))
+        if not is_host_stat(name) and base.get(name) != elided.get(name)
+    ]
+    speedup = float(base["hostSeconds"]) / float(elided["hostSeconds"])
+    status = "ok" if not diffs else f"{len(diffs)} stats differ"
+    print(f"rate {rate:>6}: {status}, host speedup {speedup:.2f}x")
+    for name in diffs[:10]:
+        print(f"    {name}: {base.get(name)} != {elided.get(name)}")
+    failed |= bool(diffs)
+
+sys.exit(1 if failed else 0)
@@ -0,0 +1,115 @@
+#! /usr/bin/env python3
+# Copyright (c) 2025 Boston University
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Measure what pooled flit/credit allocation saves at saturation.
+#
+# Runs configs/example/garnet_synth_traffic.py on a mesh with uniform
+# random traffic, above the saturation rate by default, with two gem5
+# binaries: one built before flits and credits were pooled and one
+# built after. Reports host nanoseconds per injected flit for each, and
+# the pool misses of the pooled binary. Run it from the gem5 root, e.g.
+#
+#   util/garnet_pool_bench.py build-old/NULL/gem5.opt build/NULL/gem5.opt
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+import tempfile
+
+parser = argparse.ArgumentParser()
+parser.add_argument("baseline", help="gem5 binary without pooling")
+parser.add_argument("pooled", help="gem5 binary with pooling")
+parser.add_argument("--rows", type=int, default=8, help="mesh rows")
+parser.add_argument("--sim-cycles", type=int, default=100000)
+parser.add_argument("--injectionrate", type=float, default=0.5)
+parser.add_argument("--repeat", type=int, default=3)
+
+args = parser.parse_args()
+nodes = args.rows * args.rows
+
+
+def read_stats(path):
+    stats = {}
+    with open(path) as f:
+        for line in f:
+            m = re.match(r"(\S+)\s+([-0-9.e+]+)", line)
+            if m:
+                stats[m.group(1)] = float(m.group(2))
+    return stats
+
+
+def run(binary):
+    outdir = tempfile.mkdtemp(prefix="garnet-pool-")
+    cmd = [
+        binary,
+        "-d",
+        outdir,
+        "configs/example/garnet_synth_traffic.py",
+        "--network=garnet",
+        "--topology=Mesh_XY",
+        f"--num-cpus={nodes}",
+        f"--num-dirs={nodes}",
+        f"--mesh-rows={args.rows}",
+        "--synthetic=uniform_random",
+        f"--injectionrate={args.injectionrate}",
+        f"--sim-cycles={args.sim_cycles}",
+    ]
+    subprocess.run(cmd, check=True, stdout=subprocess.DEVNULL)
+    return read_stats(os.path.join(outdir, "stats.txt"))
+
+
+results = {}
+for name in ("baseline", "pooled"):
+    # Keep the fastest run to filter out noise from the host
+    best = None
+    for _ in range(args.repeat):
+        stats = run(getattr(args, name))
+        if best is None or stats["hostSeconds"] < best["hostSeconds"]:
+            best = stats
+    results[name] = best
+    flits = best["system.ruby.network.flits_injected::total"]
+    print(
+        f"{name:>8}: {flits:.0f} flits in {best['hostSeconds']:.3f} s, "
+        f"{best['hostSeconds'] * 1e9 / flits:.1f} ns/flit"
+    )
+
+pooled = results["pooled"]
+print(
+    "pool misses: "
+    f"{pooled.get('system.ruby.network.flit_pool_misses', 0):.0f} flits, "
+    f"{pooled.get('system.ruby.network.credit_pool_misses', 0):.0f} credits"
+)
+
+injected = "system.ruby.network.flits_injected::total"
+if results["baseline"][injected] != pooled[injected]:
+    print("warning: the two runs injected a different number of flits")
+    sys.exit(1)
+
+speedup = results["baseline"]["hostSeconds"] / pooled["hostSeconds"]
+print(f"speedup: {speedup:.2f}x")
@@ -0,0 +1,128 @@
+#! /usr/bin/env python3
+# Copyright (c) 2025 Boston University
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Throughput/latency curves for Garnet's routing algorithms.
+#
+# Runs configs/example/garnet_synth_traffic.py on a mesh for every
+# routing algorithm and injection rate given, and prints (or writes as
+# CSV) the reception rate in packets/node/cycle and the average packet
+# latency in ticks. Run it from the gem5 root with a binary that has the
+# Garnet_standalone protocol, e.g.
+#
+#   util/garnet_routing_curves.py build/NULL/gem5.opt \
+#       --synthetic transpose --csv transpose.csv
+
+import argparse
+import csv
+import os
+import subprocess
+import sys
+import tempfile
+
+ALGORITHMS = {
+    0: "table",
+    1: "xy",
+    3: "west-first",
+    4: "odd-even",
+    5: "dyxy",
+}
+
+parser = argparse.ArgumentParser()
+parser.add_argument("binary")
+parser.add_argument("--rows", type=int, default=8, help="mesh rows")
+parser.add_argument("--sim-cycles", type=int, default=20000)
+parser.add_argument("--vcs-per-vnet", type=int, default=4)
+parser.add_argument("--synthetic", default="uniform_random")
+parser.add_argument(
+    "--algorithms",
+    type=int,
+    nargs="+",
+    default=[1, 3, 4, 5],
+    help="routing algorithms to compare (see --routing-algorithm)",
+)
+parser.add_argument(
+    "--rates",
+    type=float,
+    nargs="+",
+    default=[0.02, 0.05, 0.1, 0.15, 0.2, 0.25, 0.3, 0.35, 0.4, 0.45, 0.5],
+    help="injection rates in packets/node/cycle",
+)
+parser.add_argument("--csv", help="also write the results to this file")
+
+args = parser.parse_args()
+nodes = args.rows * args.rows
+
+
+def read_stats(path):
+    stats = {}
+    with open(path) as f:
+        for line in f:
+            fields = line.split()
+            if len(fields) >= 2 and not line.startswith("-"):
+                stats[fields[0]] = fields[1]
+    return stats
+
+
+def run(algorithm, rate):
+    outdir = tempfile.mkdtemp(prefix="garnet-curves-")
+    cmd = [
+        args.binary,
+        "-d",
+        outdir,
+        "configs/example/garnet_synth_traffic.py",
+        "--network=garnet",
+        "--topology=Mesh_XY",
+        f"--num-cpus={nodes}",
+        f"--num-dirs={nodes}",
+        f"--mesh-rows={args.rows}",
+        f"--vcs-per-vnet={args.vcs_per_vnet}",
+        f"--synthetic={args.synthetic}",
+        f"--injectionrate={rate}",
+        f"--sim-cycles={args.sim_cycles}",
+        f"--routing-algorithm={algorithm}",
+    ]
+    subprocess.run(cmd, check=True, stdout=subprocess.DEVNULL)
+    stats = read_stats(os.path.join(outdir, "stats.txt"))
+    received = float(stats["system.ruby.network.packets_received::total"])
+    latency = float(stats["system.ruby.network.average_packet_latency"])
+    return received / nodes / args.sim_cycles, latency
+
+
+rows = []
+print(f"{'algorithm':>10} {'offered':>8} {'accepted':>9} {'latency':>10}")
+for algorithm in args.algorithms:
+    name = ALGORITHMS.get(algorithm, str(algorithm))
+    for rate in args.rates:
+        accepted, latency = run(algorithm, rate)
+        rows.append((name, rate, accepted, latency))
+        print(f"{name:>10} {rate:>8.3f} {accepted:>9.4f} {latency:>10.1f}")
+
+if args.csv:
+    with open(args.csv, "w", newline="") as f:
+        writer = csv.writer(f)
+        writer.writerow(["algorithm", "offered", "accepted", "latency"])
+        writer.writerows(rows)
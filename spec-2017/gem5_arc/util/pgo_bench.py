@@ -0,0 +1,128 @@
+#! /usr/bin/env python3
+# Copyright (c) 2025 Boston University
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Compare the host speed of gem5 binaries built as opt, fast and pgo.
+#
+# Runs the same gem5 arguments with each binary a few times and reports
+# the median host instruction rate of the last stats dump, e.g. the region
+# of interest of the SPEC scripts, and the speedup over the first binary.
+# The simulated instruction counts must match between the binaries. Build
+# the binaries from the same tree first, e.g.
+#
+#   scons build/X86/gem5.opt build/X86/gem5.fast build/X86/gem5.pgo \
+#       --pgo-train="configs/example/gem5_library/x86-spec-cpu2017-benchmarks-1MB.py \
+#       --image ../disk-image/spec-2017/spec-2017-image/spec-2017 --partition 1 \
+#       --benchmark 505.mcf_r --size test"
+#   util/pgo_bench.py build/X86/gem5.opt build/X86/gem5.fast \
+#       build/X86/gem5.pgo -- \
+#       configs/example/gem5_library/x86-spec-cpu2017-benchmarks-1MB.py \
+#       --image ../disk-image/spec-2017/spec-2017-image/spec-2017 \
+#       --partition 1 --benchmark 505.mcf_r --size test
+#
+# Train and measure on different benchmarks to avoid overfitting the
+# profile to the one being measured.
+
+import argparse
+import os
+import platform
+import statistics
+import subprocess
+import sys
+import tempfile
+
+parser = argparse.ArgumentParser(
+    usage="%(prog)s [-h] [--repeats N] binary [binary ...] -- gem5_args ..."
+)
+parser.add_argument("binaries", nargs="+")
+parser.add_argument("--repeats", type=int, default=3)
+
+# The gem5 arguments are options of their own, so they never go through
+# argparse, which can't tell where the binaries end.
+argv = sys.argv[1:]
+split = argv.index("--") if "--" in argv else len(argv)
+args = parser.parse_args(argv[:split])
+args.gem5_args = argv[split + 1 :]
+if not args.gem5_args:
+    parser.error("give the gem5 arguments to measure after --")
+
+
+def read_stats(path):
+    # Keep the last value of each stat, i.e. the last dump.
+    stats = {}
+    with open(path) as f:
+        for line in f:
+            fields = line.split()
+            if len(fields) >= 2 and not line.startswith("-"):
+                stats[fields[0]] = fields[1]
+    return stats
+
+
+def run(binary):
+    outdir = tempfile.mkdtemp(prefix="pgo-bench-")
+    cmd = [binary, "-d", outdir] + args.gem5_args
+    subprocess.run(cmd, check=True, stdout=subprocess.DEVNULL)
+    stats = read_stats(os.path.join(outdir, "stats.txt"))
+    return float(stats["hostInstRate"]), stats["simInsts"]
+
+
+def cpu_model():
+    try:
+        with open("/proc/cpuinfo") as f:
+            for line in f:
+                if line.startswith("model name"):
+                    return line.split(":", 1)[1].strip()
+    except OSError:
+        pass
+    return platform.processor()
+
+
+print(f"host: {cpu_model()}, {platform.platform()}")
+print(f"gem5 arguments: {' '.join(args.gem5_args)}")
+
+baseline = None
+sim_insts = None
+failed = False
+for binary in args.binaries:
+    rates = []
+    for _ in range(args.repeats):
+        rate, insts = run(binary)
+        rates.append(rate)
+        if sim_insts is None:
+            sim_insts = insts
+        elif insts != sim_insts:
+            print(f"{binary}: simulated {insts} instructions, not {sim_insts}")
+            failed = True
+    median = statistics.median(rates)
+    if baseline is None:
+        baseline = median
+    print(
+        f"{binary}: median {median:.0f} inst/s "
+        f"(min {min(rates):.0f}, max {max(rates):.0f}), "
+        f"speedup {median / baseline:.2f}x"
+    )
+
+sys.exit(1 if failed else 0)
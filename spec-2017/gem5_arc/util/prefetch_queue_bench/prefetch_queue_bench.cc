@@ -0,0 +1,278 @@
+/*
+ * Copyright (c) 2025 Boston University
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/*
+ * Compare the cost of the operations of a queued prefetcher -- filtering
+ * duplicates, squashing on demand accesses and issuing -- with the sorted
+ * list it used to walk and with PrefetchQueue, for queue sizes from 32 to
+ * 1024 entries, and check that both issue the same prefetches.
+ *
+ * PrefetchQueue reports errors through gem5's logging, so the generated
+ * headers of a gem5 build are needed:
+ *
+ *   make -C util/prefetch_queue_bench BUILD=../../build/X86
+ *   util/prefetch_queue_bench/prefetch_queue_bench [accesses] [repeat]
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <list>
+#include <random>
+#include <vector>
+
+#include "mem/cache/prefetch/prefetch_queue.hh"
+
+using namespace gem5;
+using namespace gem5::prefetch;
+
+namespace
+{
+
+constexpr int degree = 8;
+
+struct Entry
+{
+    Entry(Addr _addr, int32_t _priority) : addr(_addr), priority(_priority)
+    {}
+
+    Addr addr;
+    int32_t priority;
+};
+
+/** A sorted list, walked on every operation. */
+class ListQueue
+{
+  public:
+    explicit ListQueue(std::size_t _capacity) : capacity(_capacity) {}
+
+    Entry *
+    find(Addr addr)
+    {
+        for (auto &e : entries) {
+            if (e.addr == addr)
+                return &e;
+        }
+        return nullptr;
+    }
+
+    void
+    insert(const Entry &e)
+    {
+        if (entries.size() == capacity) {
+            // Oldest entry of the lowest priority
+            auto victim = std::prev(entries.end());
+            while (victim != entries.begin() &&
+                   std::prev(victim)->priority == victim->priority) {
+                victim--;
+            }
+            entries.erase(victim);
+        }
+        place(e);
+    }
+
+    void
+    reprioritize(Addr addr, int32_t priority)
+    {
+        for (auto it = entries.begin(); it != entries.end(); it++) {
+            if (it->addr == addr) {
+                Entry e = *it;
+                e.priority = priority;
+                entries.erase(it);
+                place(e);
+                return;
+            }
+        }
+    }
+
+    void
+    erase(Addr addr)
+    {
+        entries.remove_if([addr](const Entry &e) { return e.addr == addr; });
+    }
+
+    bool empty() const { return entries.empty(); }
+
+    Addr
+    popFront()
+    {
+        const Addr addr = entries.front().addr;
+        entries.pop_front();
+        return addr;
+    }
+
+  private:
+    /** Place an entry behind the ones with the same or higher priority */
+    void
+    place(const Entry &e)
+    {
+        auto it = entries.begin();
+        while (it != entries.end() && it->priority >= e.priority)
+            it++;
+        entries.insert(it, e);
+    }
+
+    std::list<Entry> entries;
+    const std::size_t capacity;
+};
+
+/** PrefetchQueue behind the interface of ListQueue */
+class IndexedQueue
+{
+  public:
+    explicit IndexedQueue(std::size_t capacity) : queue(capacity) {}
+
+    Entry *find(Addr addr) { return queue.find(addr, any); }
+
+    void
+    insert(const Entry &e)
+    {
+        if (queue.full())
+            queue.erase(queue.lowest());
+        queue.emplace(e.addr, e);
+    }
+
+    void
+    reprioritize(Addr addr, int32_t priority)
+    {
+        Entry *e = queue.find(addr, any);
+        e->priority = priority;
+        queue.reprioritize(*e);
+    }
+
+    void erase(Addr addr) { queue.eraseIf(addr, any); }
+
+    bool empty() const { return queue.empty(); }
+
+    Addr
+    popFront()
+    {
+        const Addr addr = queue.front().addr;
+        queue.popFront();
+        return addr;
+    }
+
+  private:
+    static bool any(const Entry &) { return true; }
+
+    PrefetchQueue<Entry> queue;
+};
+
+/**
+ * Run a stride prefetcher of the given degree over the stream and return
+ * a checksum of the prefetches it issued, one every other access.
+ */
+template <class Queue>
+uint64_t
+run(const std::vector<Addr> &stream, std::size_t capacity)
+{
+    Queue queue(capacity);
+    uint64_t checksum = 0;
+    for (std::size_t i = 0; i < stream.size(); i++) {
+        queue.erase(stream[i]);
+        for (int d = 1; d <= degree; d++) {
+            const Addr addr = stream[i] + 64 * d;
+            if (Entry *e = queue.find(addr)) {
+                if (e->priority < degree - d)
+                    queue.reprioritize(addr, degree - d);
+            } else {
+                queue.insert(Entry(addr, degree - d));
+            }
+        }
+        if (i % 2 == 0 && !queue.empty())
+            checksum = checksum * 31 + queue.popFront();
+    }
+    return checksum;
+}
+
+template <class Queue>
+double
+time(const std::vector<Addr> &stream, std::size_t capacity, int repeat,
+     uint64_t &checksum)
+{
+    double best = 0;
+    for (int i = 0; i < repeat; i++) {
+        auto start = std::chrono::steady_clock::now();
+        checksum = run<Queue>(stream, capacity);
+        std::chrono::duration<double> t =
+            std::chrono::steady_clock::now() - start;
+        if (i == 0 || t.count() < best)
+            best = t.count();
+    }
+    return best;
+}
+
+} // anonymous namespace
+
+int
+main(int argc, char **argv)
+{
+    const int num_accesses = argc > 1 ? std::atoi(argv[1]) : 50000;
+    const int repeat = argc > 2 ? std::atoi(argv[2]) : 3;
+    if (num_accesses < 1 || repeat < 1) {
+        std::cerr << "usage: " << argv[0] << " [accesses] [repeat]\n";
+        return 2;
+    }
+
+    // Each access erases one entry and looks up or inserts degree
+    // entries; every other access issues one
+    const double ops = num_accesses * (degree + 1.5);
+
+    std::printf("%8s %12s %13s %8s\n", "entries", "list ns/op",
+                "indexed ns/op", "speedup");
+    bool agree = true;
+    for (std::size_t capacity = 32; capacity <= 1024; capacity *= 2) {
+        std::mt19937 gen(capacity);
+        std::vector<Addr> stream(num_accesses);
+        for (auto &addr : stream) {
+            // Streams over a footprint twice the queue size
+            addr = 64 * (gen() % (2 * capacity));
+        }
+
+        uint64_t list_checksum, indexed_checksum;
+        const double list_time =
+            time<ListQueue>(stream, capacity, repeat, list_checksum);
+        const double indexed_time =
+            time<IndexedQueue>(stream, capacity, repeat, indexed_checksum);
+
+        std::printf("%8zu %12.2f %13.2f %7.2fx\n", capacity,
+                    list_time * 1e9 / ops, indexed_time * 1e9 / ops,
+                    list_time / indexed_time);
+        agree = agree && list_checksum == indexed_checksum;
+    }
+
+    if (!agree) {
+        std::printf("error: the queues issued different prefetches\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2025 Boston University
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/*
+ * Measure the throughput of the masked merges and compares of 64-byte
+ * blocks with the masks of 1 to 8 byte stores, as done when writes are
+ * merged into the blocks of a store-heavy workload, against byte by byte
+ * loops, and check that every instruction set gives the same results.
+ *
+ *   make -C util/ruby_block_kernels_bench
+ *   util/ruby_block_kernels_bench/block_kernels_bench [rounds]
+ *
+ * util/ruby_store_bench.py measures the effect on whole MESI_Two_Level
+ * runs.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "mem/ruby/common/DataBlockKernels.hh"
+
+using namespace gem5;
+using namespace gem5::ruby;
+
+namespace
+{
+
+constexpr std::size_t block_size = 64;
+constexpr std::size_t num_blocks = 1024;
+
+/** Blocks, the data of a store to each of them and its mask. */
+struct Stores
+{
+    std::vector<uint8_t> blocks;
+    std::vector<uint8_t> data;
+    std::vector<uint64_t> masks;
+};
+
+Stores
+makeStores()
+{
+    std::mt19937_64 rng(3);
+    Stores stores;
+    stores.blocks.resize(block_size * num_blocks);
+    stores.data.resize(block_size * num_blocks);
+    for (auto &byte : stores.blocks)
+        byte = rng();
+    // Half of the stores write what the block already holds
+    for (std::size_t i = 0; i < stores.data.size(); i++)
+        stores.data[i] = (i / block_size) % 2 ? rng() : stores.blocks[i];
+    stores.masks.resize(num_blocks);
+    for (auto &mask : stores.masks) {
+        const unsigned len = 1 << (rng() % 4);
+        mask = ((uint64_t(1) << len) - 1) << (len * (rng() % (64 / len)));
+    }
+    return stores;
+}
+
+/**
+ * Apply every store to its block rounds times, first comparing the
+ * store with the block, and return the number of stores that changed
+ * their block along with the final blocks.
+ */
+template <class Equal, class Copy>
+uint64_t
+run(const Stores &stores, int rounds, Equal equal, Copy copy,
+    std::vector<uint8_t> &blocks, double &seconds)
+{
+    blocks = stores.blocks;
+    uint64_t changed = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds; round++) {
+        for (std::size_t blk = 0; blk < num_blocks; blk++) {
+            uint8_t *block = &blocks[blk * block_size];
+            const uint8_t *data = &stores.data[blk * block_size];
+            if (!equal(block, data, &stores.masks[blk])) {
+                copy(block, data, &stores.masks[blk]);
+                changed++;
+            }
+        }
+    }
+    std::chrono::duration<double> t =
+        std::chrono::steady_clock::now() - start;
+    seconds = t.count();
+    return changed;
+}
+
+} // anonymous namespace
+
+int
+main(int argc, char **argv)
+{
+    const int rounds = argc > 1 ? std::atoi(argv[1]) : 2000;
+    if (rounds < 1) {
+        std::cerr << "usage: " << argv[0] << " [rounds]\n";
+        return 2;
+    }
+
+    const Stores stores = makeStores();
+    const double stores_run = double(rounds) * num_blocks;
+
+    std::vector<uint8_t> expected_blocks;
+    double seconds;
+    const uint64_t expected = run(stores, rounds,
+        [](const uint8_t *a, const uint8_t *b, const uint64_t *mask) {
+            for (std::size_t i = 0; i < block_size; i++) {
+                if (((*mask >> i) & 1) && a[i] != b[i])
+                    return false;
+            }
+            return true;
+        },
+        [](uint8_t *dst, const uint8_t *src, const uint64_t *mask) {
+            for (std::size_t i = 0; i < block_size; i++) {
+                if ((*mask >> i) & 1)
+                    dst[i] = src[i];
+            }
+        }, expected_blocks, seconds);
+    std::printf("%-13s %.1f M stores/s\n", "byte by byte:",
+                stores_run / seconds / 1e6);
+
+    bool agree = true;
+    for (auto isa : {block_kernels::Isa::Scalar, block_kernels::Isa::AVX2}) {
+        if (!block_kernels::isSupported(isa))
+            continue;
+
+        std::vector<uint8_t> blocks;
+        const uint64_t changed = run(stores, rounds,
+            [isa](const uint8_t *a, const uint8_t *b, const uint64_t *mask) {
+                return block_kernels::maskedEqual(a, b, mask, block_size,
+                                                  isa);
+            },
+            [isa](uint8_t *dst, const uint8_t *src, const uint64_t *mask) {
+                block_kernels::maskedCopy(dst, src, mask, block_size, isa);
+            }, blocks, seconds);
+        std::printf("%-13s %.1f M stores/s\n",
+                    isa == block_kernels::Isa::AVX2 ? "avx2:" : "scalar:",
+                    stores_run / seconds / 1e6);
+        agree = agree && changed == expected && blocks == expected_blocks;
+    }
+
+    if (!agree) {
+        std::printf("error: the kernels and the byte loops disagree\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,114 @@
+#! /usr/bin/env python3
+# Copyright (c) 2025 Boston University
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+# Check that running L1 controller wakeups in parallel matches the serial
+# run and measure the host speedup.
+#
+# Runs configs/deprecated/example/se.py with Ruby, one copy of the
+# workload per CPU, once serially and then with --ruby-parallel-wakeup
+# at each thread count. All simulated statistics must match the serial
+# run exactly; only the host statistics may differ. Run it from the gem5
+# root with a binary that has the MESI_Two_Level protocol, e.g.
+#
+#   util/ruby_parallel_wakeup_check.py build/X86/gem5.opt \
+#       --cmd tests/test-progs/hello/bin/x86/linux/hello --num-cpus 8
+
+import argparse
+import os
+import subprocess
+import sys
+import tempfile
+
+parser = argparse.ArgumentParser()
+parser.add_argument("binary")
+parser.add_argument("--cmd", required=True, help="workload run on each CPU")
+parser.add_argument("--options", default="", help="workload arguments")
+parser.add_argument("--num-cpus", type=int, default=8)
+parser.add_argument("--cpu-type", default="TimingSimpleCPU")
+parser.add_argument(
+    "--threads",
+    type=int,
+    nargs="+",
+    default=[1, 2, 4],
+    help="host thread counts to check",
+)
+parser.add_argument("--maxinsts", type=int, default=0)
+
+args = parser.parse_args()
+
+
+def read_stats(path):
+    stats = {}
+    with open(path) as f:
+        for line in f:
+            fields = line.split()
+            if len(fields) >= 2 and not line.startswith("-"):
+                stats[fields[0]] = fields[1]
+    return stats
+
+
+def run(threads):
+    outdir = tempfile.mkdtemp(prefix="ruby-parallel-wakeup-")
+    cmd = [
+        args.binary,
+        "-d",
+        outdir,
+        "configs/deprecated/example/se.py",
+        "--ruby",
+        f"--cpu-type={args.cpu_type}",
+        f"--num-cpus={args.num_cpus}",
+        "--cmd=" + ";".join([args.cmd] * args.num_cpus),
+        f"--ruby-parallel-wakeup={threads}",
+    ]
+    if args.options:
+        cmd.append("--options=" + ";".join([args.options] * args.num_cpus))
+    if args.maxinsts:
+        cmd.append(f"--maxinsts={args.maxinsts}")
+    subprocess.run(cmd, check=True, stdout=subprocess.DEVNULL)
+    return read_stats(os.path.join(outdir, "stats.txt"))
+
+
+def differences(a, b):
+    return [
+        name
+        for name in sorted(set(a) | set(b))
+        if not name.startswith("host") and a.get(name) != b.get(name)
+    ]
+
+
+serial = run(0)
+failed = False
+for threads in args.threads:
+    parallel = run(threads)
+    diffs = differences(serial, parallel)
+    speedup = float(serial["hostSeconds"]) / float(parallel["hostSeconds"])
+    status = "ok" if not diffs else f"{len(diffs)} stats differ"
+    print(f"{threads} threads: {status}, host speedup {speedup:.2f}x")
+    for name in diffs[:10]:
+        print(f"    {name}: {serial.get(name)} != {parallel.get(name)}")
+    failed |= bool(diffs)
+
+sys.exit(1 if failed else 0)
@@ -0,0 +1,80 @@
+#! /usr/bin/env python3
+# Copyright (c) 2025 Boston University
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Convert a RubyQueue debug trace into a stream for queue_bench.
+#
+# Reads the output of a gem5 run with --debug-flags=RubyQueue and prints
+# one line per message buffer operation, "<buffer> <op> [tick]", with
+# buffers numbered in order of appearance. See queue_bench.cc.
+
+import argparse
+import re
+import sys
+
+parser = argparse.ArgumentParser()
+parser.add_argument("trace", help="RubyQueue debug trace")
+parser.add_argument(
+    "--buffers",
+    default="",
+    help="only keep buffers whose name contains this string",
+)
+args = parser.parse_args()
+
+line_re = re.compile(r"\s*(\d+): (\S+): (.*)")
+arrival_re = re.compile(r"arrival_time: (\d+)")
+
+buffers = {}
+stalling = set()
+out = sys.stdout
+
+with open(args.trace) as f:
+    for line in f:
+        m = line_re.match(line)
+        if not m or args.buffers not in m.group(2):
+            continue
+        name, text = m.group(2), m.group(3)
+        buf = buffers.setdefault(name, len(buffers))
+
+        if text.startswith("Enqueue arrival_time"):
+            tick = arrival_re.search(text).group(1)
+            out.write(f"{buf} E {tick}\n")
+        elif text.startswith("Stalling due to"):
+            # The stalled message is then dequeued
+            stalling.add(buf)
+        elif text.startswith("Popping"):
+            if buf in stalling:
+                stalling.discard(buf)
+                out.write(f"{buf} S\n")
+            else:
+                out.write(f"{buf} D\n")
+        elif text.startswith("Requeue arrival_time"):
+            out.write(f"{buf} U\n")
+        elif text.startswith("Recycling, arrival_time"):
+            tick = arrival_re.search(text).group(1)
+            out.write(f"{buf} R {tick}\n")
+
+print(f"{len(buffers)} buffers", file=sys.stderr)
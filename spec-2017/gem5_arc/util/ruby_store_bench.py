@@ -0,0 +1,125 @@
+#! /usr/bin/env python3
+# Copyright (c) 2025 Boston University
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+# Compare the host time of store-heavy MESI_Two_Level runs.
+#
+# Runs configs/example/ruby_mem_test.py with testers that mostly store,
+# so that most Ruby data messages carry partial writes. Each run is done
+# with a gem5 binary built before DataBlock and WriteMask used word masks
+# and the masked block kernels, and one built after. The simulated
+# statistics of the two must match; the script reports the host time of
+# each. Both binaries must be built with the MESI_Two_Level protocol. Run
+# it from the gem5 root, e.g.
+#
+#   util/ruby_store_bench.py build-old/NULL_MESI_Two_Level/gem5.opt \
+#       build/NULL_MESI_Two_Level/gem5.opt
+#
+# util/ruby_block_kernels_bench measures the kernels on their own.
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+import tempfile
+
+parser = argparse.ArgumentParser()
+parser.add_argument("baseline", help="gem5 binary with the byte loops")
+parser.add_argument("masked", help="gem5 binary with the masked kernels")
+parser.add_argument(
+    "--num-cpus",
+    type=int,
+    nargs="+",
+    default=[4, 16],
+    help="numbers of testers to run with",
+)
+parser.add_argument(
+    "--percent-reads",
+    type=int,
+    default=10,
+    help="percentage of tester accesses that are reads",
+)
+parser.add_argument("--maxloads", type=int, default=20000)
+parser.add_argument("--repeat", type=int, default=3)
+
+args = parser.parse_args()
+
+
+def read_stats(path):
+    stats = {}
+    with open(path) as f:
+        for line in f:
+            m = re.match(r"(\S+)\s+([-0-9.e+]+)", line)
+            if m:
+                stats[m.group(1)] = float(m.group(2))
+    return stats
+
+
+def run(binary, num_cpus):
+    outdir = tempfile.mkdtemp(prefix="ruby-store-")
+    cmd = [
+        binary,
+        "-d",
+        outdir,
+        "configs/example/ruby_mem_test.py",
+        f"--num-cpus={num_cpus}",
+        f"--percent-reads={args.percent_reads}",
+        f"--maxloads={args.maxloads}",
+        "--progress=0",
+    ]
+    subprocess.run(cmd, check=True, stdout=subprocess.DEVNULL)
+    return read_stats(os.path.join(outdir, "stats.txt"))
+
+
+def simulated(stats):
+    return {k: v for k, v in stats.items() if not k.startswith("host")}
+
+
+failed = False
+for num_cpus in args.num_cpus:
+    results = {}
+    for name in ("baseline", "masked"):
+        # Keep the fastest run to filter out noise from the host
+        best = None
+        for _ in range(args.repeat):
+            stats = run(getattr(args, name), num_cpus)
+            if best is None or stats["hostSeconds"] < best["hostSeconds"]:
+                best = stats
+        results[name] = best
+
+    base = results["baseline"]
+    masked = results["masked"]
+    print(
+        f"{num_cpus:3d} testers: "
+        f"baseline {base['hostSeconds']:.3f} s, "
+        f"masked {masked['hostSeconds']:.3f} s, "
+        f"speedup {base['hostSeconds'] / masked['hostSeconds']:.2f}x"
+    )
+    if simulated(base) != simulated(masked):
+        print("  warning: simulated stats differ")
+        failed = True
+
+sys.exit(1 if failed else 0)
@@ -0,0 +1,122 @@
+#! /usr/bin/env python3
+# Copyright (c) 2025 Boston University
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Compare switch and table SLICC transition dispatch in host time.
+#
+# Runs configs/example/ruby_mem_test.py with two gem5 binaries per
+# protocol: one built with SLICC_TABLE_DISPATCH unset and one with it
+# set. The simulated statistics of each pair must match exactly, since
+# both backends implement the same transitions; the script reports the
+# host time of each and the speedup of the table backend. Run it from
+# the gem5 root with one --pair per protocol, e.g.
+#
+#   util/slicc_dispatch_bench.py \
+#       --pair MESI_Two_Level build-sw/MESI/gem5.opt build-tab/MESI/gem5.opt \
+#       --pair CHI build-sw/CHI/gem5.opt build-tab/CHI/gem5.opt
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+import tempfile
+
+parser = argparse.ArgumentParser()
+parser.add_argument(
+    "--pair",
+    nargs=3,
+    action="append",
+    required=True,
+    metavar=("PROTOCOL", "SWITCH", "TABLE"),
+    help="protocol name and its switch and table dispatch binaries",
+)
+parser.add_argument("--num-cpus", type=int, default=8)
+parser.add_argument("--maxloads", type=int, default=200000)
+parser.add_argument("--repeat", type=int, default=3)
+
+args = parser.parse_args()
+
+
+def read_stats(path):
+    stats = {}
+    with open(path) as f:
+        for line in f:
+            m = re.match(r"(\S+)\s+([-0-9.e+]+)", line)
+            if m:
+                stats[m.group(1)] = float(m.group(2))
+    return stats
+
+
+def run(binary):
+    outdir = tempfile.mkdtemp(prefix="slicc-dispatch-")
+    cmd = [
+        binary,
+        "-d",
+        outdir,
+        "configs/example/ruby_mem_test.py",
+        f"--num-cpus={args.num_cpus}",
+        f"--maxloads={args.maxloads}",
+        "--progress=0",
+    ]
+    subprocess.run(cmd, check=True, stdout=subprocess.DEVNULL)
+    return read_stats(os.path.join(outdir, "stats.txt"))
+
+
+def simulated(stats):
+    return {k: v for k, v in stats.items() if not k.startswith("host")}
+
+
+failed = False
+for protocol, switch, table in args.pair:
+    results = {}
+    for name, binary in (("switch", switch), ("table", table)):
+        # Keep the fastest run to filter out noise from the host
+        best = None
+        for _ in range(args.repeat):
+            stats = run(binary)
+            if best is None or stats["hostSeconds"] < best["hostSeconds"]:
+                best = stats
+        results[name] = best
+
+    sw = results["switch"]
+    tab = results["table"]
+    speedup = sw["hostSeconds"] / tab["hostSeconds"]
+    print(
+        f"{protocol}: switch {sw['hostSeconds']:.3f} s, "
+        f"table {tab['hostSeconds']:.3f} s, speedup {speedup:.2f}x"
+    )
+
+    if simulated(sw) != simulated(tab):
+        diff = sorted(
+            k
+            for k in set(simulated(sw)) | set(simulated(tab))
+            if sw.get(k) != tab.get(k)
+        )
+        print(f"  simulated stats differ, e.g. {', '.join(diff[:5])}")
+        failed = True
+
+sys.exit(1 if failed else 0)
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2025 Boston University
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/*
+ * Compare the lookup throughput of the trie the X86 TLB used to search
+ * with that of the set-associative FlatTlb, on working sets that fit in
+ * TLBs of 64, 256 and 2048 entries, and check that both find the same
+ * entries.
+ *
+ * FlatTlb includes the replacement policy headers, so the generated
+ * headers of a gem5 build are needed:
+ *
+ *   make -C util/x86_tlb_bench BUILD=../../build/X86
+ *   util/x86_tlb_bench/tlb_bench [lookups] [repeat]
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "arch/x86/flat_tlb.hh"
+#include "base/trie.hh"
+
+using namespace gem5;
+using namespace gem5::X86ISA;
+
+namespace
+{
+
+struct Entry
+{
+    Addr vaddr = 0;
+    unsigned logBytes = PageShift;
+    bool global = false;
+    int id = 0;
+};
+
+using EntryTrie = Trie<Addr, Entry>;
+
+/** Time the lookups of all probes, returning a checksum of the hits. */
+template <class Lookup>
+double
+time(const std::vector<Addr> &probes, int repeat, Lookup lookup,
+     uint64_t &checksum)
+{
+    double best = 0;
+    for (int i = 0; i < repeat; i++) {
+        auto start = std::chrono::steady_clock::now();
+        checksum = 0;
+        for (Addr probe : probes) {
+            if (const Entry *entry = lookup(probe))
+                checksum += entry->id;
+        }
+        std::chrono::duration<double> t =
+            std::chrono::steady_clock::now() - start;
+        if (i == 0 || t.count() < best)
+            best = t.count();
+    }
+    return best;
+}
+
+} // anonymous namespace
+
+int
+main(int argc, char **argv)
+{
+    const int num_lookups = argc > 1 ? std::atoi(argv[1]) : 2000000;
+    const int repeat = argc > 2 ? std::atoi(argv[2]) : 3;
+    if (num_lookups < 1 || repeat < 1) {
+        std::cerr << "usage: " << argv[0] << " [lookups] [repeat]\n";
+        return 2;
+    }
+
+    std::printf("%8s %6s %12s %12s %8s\n", "entries", "pages", "trie M/s",
+                "flat M/s", "speedup");
+    bool agree = true;
+    for (unsigned size : {64, 256, 2048}) {
+        std::mt19937_64 gen(size);
+        std::vector<Entry> entries;
+        FlatTlb<Entry> tlb(size, 8, 32, false);
+        for (int i = 0; entries.size() < size / 2; i++) {
+            // Scattered pages, so that the sets are not evenly filled
+            Entry entry;
+            entry.vaddr = (gen() & mask(47)) & ~mask(PageShift);
+            entry.id = i;
+            if (!tlb.lookup(entry.vaddr, false)) {
+                entries.push_back(entry);
+                tlb.insert(entry.vaddr, entry);
+            }
+        }
+        // Only keep the pages that did not conflict in their set
+        std::vector<Entry> resident;
+        for (const auto &entry : entries) {
+            const Entry *found = tlb.lookup(entry.vaddr, false);
+            if (found && found->id == entry.id)
+                resident.push_back(entry);
+        }
+        entries = resident;
+        EntryTrie trie;
+        for (auto &entry : entries) {
+            trie.insert(entry.vaddr, EntryTrie::MaxBits - entry.logBytes,
+                        &entry);
+        }
+
+        std::vector<Addr> probes(num_lookups);
+        for (auto &probe : probes) {
+            // Mostly hits, with PCIDs in the low bits
+            probe = (gen() % 8) ? entries[gen() % entries.size()].vaddr :
+                (gen() & mask(47)) & ~mask(PageShift);
+            probe |= gen() & mask(PageShift);
+        }
+
+        uint64_t trie_checksum, flat_checksum;
+        const double trie_time = time(probes, repeat,
+            [&](Addr probe) { return trie.lookup(probe); }, trie_checksum);
+        const double flat_time = time(probes, repeat,
+            [&](Addr probe) { return tlb.lookup(probe); }, flat_checksum);
+
+        std::printf("%8u %6zu %12.1f %12.1f %7.2fx\n", size, entries.size(),
+                    num_lookups / trie_time / 1e6,
+                    num_lookups / flat_time / 1e6, trie_time / flat_time);
+        agree = agree && trie_checksum == flat_checksum;
+    }
+
+    if (!agree) {
+        std::printf("error: the trie and FlatTlb found different entries\n");
+        return 1;
+    }
+    return 0;
+}